@@ -0,0 +1,69 @@
+#pragma once
+#ifndef __AABB__
+#define __AABB__
+
+#include <glm/vec2.hpp>
+#include <algorithm>
+
+/**
+ * \brief Axis aligned bounding box stored as its min (top left) and max (bottom right) corners
+ */
+struct AABB
+{
+	glm::vec2 min = glm::vec2(0.0f, 0.0f);
+	glm::vec2 max = glm::vec2(0.0f, 0.0f);
+
+	AABB() = default;
+	AABB(const glm::vec2 min_corner, const glm::vec2 max_corner) : min(min_corner), max(max_corner) {}
+
+	// builds the box of an object positioned by its centre or by its top left corner
+	static AABB FromPosition(const glm::vec2 position, const float width, const float height, const bool centered)
+	{
+		const auto top_left = centered ? position - glm::vec2(width * 0.5f, height * 0.5f) : position;
+		return { top_left, top_left + glm::vec2(width, height) };
+	}
+
+	static AABB Union(const AABB& a, const AABB& b)
+	{
+		return { glm::vec2(std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y)),
+			glm::vec2(std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y)) };
+	}
+
+	[[nodiscard]] bool Overlaps(const AABB& other) const
+	{
+		return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y;
+	}
+
+	[[nodiscard]] bool Contains(const AABB& other) const
+	{
+		return min.x <= other.min.x && min.y <= other.min.y && max.x >= other.max.x && max.y >= other.max.y;
+	}
+
+	[[nodiscard]] bool Contains(const glm::vec2 point) const
+	{
+		return point.x >= min.x && point.x <= max.x && point.y >= min.y && point.y <= max.y;
+	}
+
+	[[nodiscard]] AABB Expanded(const float amount) const
+	{
+		return { min - glm::vec2(amount, amount), max + glm::vec2(amount, amount) };
+	}
+
+	// the insertion cost metric of the AABB tree (perimeter works better than area for thin boxes in 2D)
+	[[nodiscard]] float GetPerimeter() const
+	{
+		return 2.0f * ((max.x - min.x) + (max.y - min.y));
+	}
+
+	[[nodiscard]] glm::vec2 GetCentre() const
+	{
+		return (min + max) * 0.5f;
+	}
+
+	[[nodiscard]] glm::vec2 GetSize() const
+	{
+		return max - min;
+	}
+};
+
+#endif /* defined (__AABB__) */
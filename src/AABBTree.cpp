@@ -0,0 +1,653 @@
+#include "AABBTree.h"
+#include <cmath>
+#include <iostream>
+#include <SDL.h>
+#include "DebugDraw.h"
+#include "Util.h"
+
+namespace
+{
+	// fat boxes are stretched this many times the last displacement so a steadily moving proxy is reinserted less often
+	constexpr float DISPLACEMENT_MULTIPLIER = 2.0f;
+
+	double ElapsedMilliseconds(const Uint64 start)
+	{
+		return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+	}
+
+	/**
+	 * \brief Slab test of the segment start + delta * t, t in [0, max_fraction], against a box
+	 * \return true if the segment enters the box, fraction receives the entry point
+	 */
+	bool SegmentAABB(const glm::vec2 start, const glm::vec2 delta, const AABB& box, const float max_fraction, float& fraction)
+	{
+		auto t_min = 0.0f;
+		auto t_max = max_fraction;
+
+		for (auto axis = 0; axis < 2; ++axis)
+		{
+			if (std::fabs(delta[axis]) < Util::EPSILON)
+			{
+				// parallel to the slab
+				if (start[axis] < box.min[axis] || start[axis] > box.max[axis])
+				{
+					return false;
+				}
+				continue;
+			}
+
+			const auto inverse = 1.0f / delta[axis];
+			auto t1 = (box.min[axis] - start[axis]) * inverse;
+			auto t2 = (box.max[axis] - start[axis]) * inverse;
+			if (t1 > t2)
+			{
+				std::swap(t1, t2);
+			}
+
+			t_min = std::max(t_min, t1);
+			t_max = std::min(t_max, t2);
+			if (t_min > t_max)
+			{
+				return false;
+			}
+		}
+
+		fraction = t_min;
+		return true;
+	}
+}
+
+AABBTree::AABBTree(const float margin) :
+	m_root(NULL_NODE), m_freeList(NULL_NODE), m_proxyCount(0), m_reinsertCount(0), m_margin(margin)
+{
+}
+
+AABBTree::~AABBTree()
+= default;
+
+int AABBTree::CreateProxy(const AABB& aabb, GameObject* user_data)
+{
+	const auto proxy_id = AllocateNode();
+
+	auto& node = m_nodes[proxy_id];
+	node.aabb = aabb.Expanded(m_margin);
+	node.tight = aabb;
+	node.user_data = user_data;
+	node.height = 0;
+
+	InsertLeaf(proxy_id);
+	++m_proxyCount;
+	return proxy_id;
+}
+
+void AABBTree::DestroyProxy(const int proxy_id)
+{
+	if (proxy_id < 0 || proxy_id >= static_cast<int>(m_nodes.size()) || !m_nodes[proxy_id].IsLeaf() || m_nodes[proxy_id].height < 0)
+	{
+		std::cout << "invalid proxy id: " << proxy_id << std::endl;
+		return;
+	}
+
+	RemoveLeaf(proxy_id);
+	FreeNode(proxy_id);
+	--m_proxyCount;
+}
+
+bool AABBTree::MoveProxy(const int proxy_id, const AABB& aabb, const glm::vec2 displacement)
+{
+	auto& node = m_nodes[proxy_id];
+	node.tight = aabb;
+
+	// still inside the fat box, unless the fat box has become much larger than needed (a fast mover that stopped)
+	if (node.aabb.Contains(aabb) && !node.aabb.Contains(aabb.Expanded(m_margin * 4.0f)))
+	{
+		return false;
+	}
+
+	RemoveLeaf(proxy_id);
+
+	// enlarge by the margin and stretch in the direction of travel
+	auto fat = aabb.Expanded(m_margin);
+	const auto stretch = displacement * DISPLACEMENT_MULTIPLIER;
+	(stretch.x < 0.0f ? fat.min.x : fat.max.x) += stretch.x;
+	(stretch.y < 0.0f ? fat.min.y : fat.max.y) += stretch.y;
+	m_nodes[proxy_id].aabb = fat;
+
+	InsertLeaf(proxy_id);
+	++m_reinsertCount;
+	return true;
+}
+
+void AABBTree::Clear()
+{
+	m_nodes.clear();
+	m_root = NULL_NODE;
+	m_freeList = NULL_NODE;
+	m_proxyCount = 0;
+	m_reinsertCount = 0;
+}
+
+void AABBTree::QueryRegion(const AABB& region, std::vector<int>& results) const
+{
+	if (m_root == NULL_NODE)
+	{
+		return;
+	}
+
+	m_stack.clear();
+	m_stack.push_back(m_root);
+	while (!m_stack.empty())
+	{
+		const auto& node = m_nodes[m_stack.back()];
+		const auto node_id = m_stack.back();
+		m_stack.pop_back();
+
+		if (!node.aabb.Overlaps(region))
+		{
+			continue;
+		}
+
+		if (node.IsLeaf())
+		{
+			if (node.tight.Overlaps(region))
+			{
+				results.push_back(node_id);
+			}
+		}
+		else
+		{
+			m_stack.push_back(node.child1);
+			m_stack.push_back(node.child2);
+		}
+	}
+}
+
+void AABBTree::QueryPoint(const glm::vec2 point, std::vector<int>& results) const
+{
+	QueryRegion(AABB(point, point), results);
+}
+
+void AABBTree::QuerySegment(const glm::vec2 start, const glm::vec2 end, std::vector<int>& results) const
+{
+	if (m_root == NULL_NODE)
+	{
+		return;
+	}
+
+	const auto delta = end - start;
+
+	m_stack.clear();
+	m_stack.push_back(m_root);
+	while (!m_stack.empty())
+	{
+		const auto node_id = m_stack.back();
+		m_stack.pop_back();
+		const auto& node = m_nodes[node_id];
+
+		// only the nodes the segment passes through are visited
+		float entry;
+		if (!SegmentAABB(start, delta, node.aabb, 1.0f, entry))
+		{
+			continue;
+		}
+
+		if (node.IsLeaf())
+		{
+			if (SegmentAABB(start, delta, node.tight, 1.0f, entry))
+			{
+				results.push_back(node_id);
+			}
+		}
+		else
+		{
+			m_stack.push_back(node.child1);
+			m_stack.push_back(node.child2);
+		}
+	}
+}
+
+int AABBTree::Raycast(const glm::vec2 start, const glm::vec2 end, float& fraction) const
+{
+	fraction = 1.0f;
+	auto closest = NULL_NODE;
+	if (m_root == NULL_NODE)
+	{
+		return closest;
+	}
+
+	const auto delta = end - start;
+
+	m_stack.clear();
+	m_stack.push_back(m_root);
+	while (!m_stack.empty())
+	{
+		const auto node_id = m_stack.back();
+		m_stack.pop_back();
+		const auto& node = m_nodes[node_id];
+
+		// anything entered beyond the closest hit so far can be skipped
+		float entry;
+		if (!SegmentAABB(start, delta, node.aabb, fraction, entry))
+		{
+			continue;
+		}
+
+		if (node.IsLeaf())
+		{
+			if (SegmentAABB(start, delta, node.tight, fraction, entry) && (closest == NULL_NODE || entry < fraction))
+			{
+				fraction = entry;
+				closest = node_id;
+			}
+		}
+		else
+		{
+			m_stack.push_back(node.child1);
+			m_stack.push_back(node.child2);
+		}
+	}
+
+	return closest;
+}
+
+/**
+ * \brief Collides the tree with itself. A pair (a, a) expands into the pairs inside each child plus the pair
+ * of children, a pair (a, b) of disjoint subtrees descends into the taller one while their fat boxes overlap.
+ * Every leaf pair is reached once, so no deduplication is needed.
+ */
+void AABBTree::ComputeOverlappingPairs(std::vector<std::pair<int, int>>& pairs) const
+{
+	if (m_root == NULL_NODE)
+	{
+		return;
+	}
+
+	m_pairStack.clear();
+	m_pairStack.emplace_back(m_root, m_root);
+	while (!m_pairStack.empty())
+	{
+		const auto [a, b] = m_pairStack.back();
+		m_pairStack.pop_back();
+
+		const auto& node_a = m_nodes[a];
+		const auto& node_b = m_nodes[b];
+
+		if (a == b)
+		{
+			if (!node_a.IsLeaf())
+			{
+				m_pairStack.emplace_back(node_a.child1, node_a.child1);
+				m_pairStack.emplace_back(node_a.child2, node_a.child2);
+				m_pairStack.emplace_back(node_a.child1, node_a.child2);
+			}
+			continue;
+		}
+
+		if (!node_a.aabb.Overlaps(node_b.aabb))
+		{
+			continue;
+		}
+
+		if (node_a.IsLeaf() && node_b.IsLeaf())
+		{
+			if (node_a.tight.Overlaps(node_b.tight))
+			{
+				pairs.emplace_back(std::min(a, b), std::max(a, b));
+			}
+		}
+		else if (node_b.IsLeaf() || (!node_a.IsLeaf() && node_a.height >= node_b.height))
+		{
+			m_pairStack.emplace_back(node_a.child1, b);
+			m_pairStack.emplace_back(node_a.child2, b);
+		}
+		else
+		{
+			m_pairStack.emplace_back(a, node_b.child1);
+			m_pairStack.emplace_back(a, node_b.child2);
+		}
+	}
+}
+
+GameObject* AABBTree::GetUserData(const int proxy_id) const
+{
+	return m_nodes[proxy_id].user_data;
+}
+
+const AABB& AABBTree::GetAABB(const int proxy_id) const
+{
+	return m_nodes[proxy_id].tight;
+}
+
+const AABB& AABBTree::GetFatAABB(const int proxy_id) const
+{
+	return m_nodes[proxy_id].aabb;
+}
+
+int AABBTree::GetProxyCount() const
+{
+	return m_proxyCount;
+}
+
+int AABBTree::GetHeight() const
+{
+	return m_root == NULL_NODE ? 0 : m_nodes[m_root].height;
+}
+
+int AABBTree::GetReinsertCount() const
+{
+	return m_reinsertCount;
+}
+
+void AABBTree::DrawDebug(const glm::vec4 leaf_colour, const glm::vec4 branch_colour) const
+{
+	for (const auto& node : m_nodes)
+	{
+		if (node.height < 0)
+		{
+			continue;
+		}
+
+		const auto size = node.aabb.GetSize();
+		DebugDraw::Instance().AddRect(node.aabb.min, static_cast<int>(size.x), static_cast<int>(size.y),
+			node.IsLeaf() ? leaf_colour : branch_colour);
+	}
+}
+
+void AABBTree::Benchmark(const int body_count)
+{
+	struct Body
+	{
+		AABB aabb;
+		glm::vec2 velocity;
+		int proxy_id;
+	};
+
+	constexpr auto frame_count = 60;
+	constexpr auto delta_time = 1.0f / 60.0f;
+
+	std::cout << "------------ AABB Tree Broadphase Benchmark ----------" << std::endl;
+
+	for (const auto count : { body_count / 10, body_count / 4, body_count / 2, body_count })
+	{
+		if (count <= 0)
+		{
+			continue;
+		}
+
+		// constant density - the world grows with the body count
+		const auto world_size = std::sqrt(static_cast<float>(count)) * 40.0f;
+
+		AABBTree tree;
+		std::vector<Body> bodies(count);
+		for (auto& body : bodies)
+		{
+			const auto position = Util::RandomRange(glm::vec2(0.0f, 0.0f), glm::vec2(world_size, world_size));
+			const auto size = Util::RandomRange(8.0f, 24.0f);
+			body.aabb = AABB(position, position + glm::vec2(size, size));
+			body.velocity = Util::RandomRange(glm::vec2(-60.0f, -60.0f), glm::vec2(60.0f, 60.0f));
+			body.proxy_id = tree.CreateProxy(body.aabb);
+		}
+
+		std::vector<std::pair<int, int>> pairs;
+		auto move_time = 0.0;
+		auto pair_time = 0.0;
+		size_t pair_total = 0;
+
+		for (auto frame = 0; frame < frame_count; ++frame)
+		{
+			auto start = SDL_GetPerformanceCounter();
+			for (auto& body : bodies)
+			{
+				auto displacement = body.velocity * delta_time;
+				if (body.aabb.min.x + displacement.x < 0.0f || body.aabb.max.x + displacement.x > world_size)
+				{
+					body.velocity.x = -body.velocity.x;
+					displacement.x = -displacement.x;
+				}
+				if (body.aabb.min.y + displacement.y < 0.0f || body.aabb.max.y + displacement.y > world_size)
+				{
+					body.velocity.y = -body.velocity.y;
+					displacement.y = -displacement.y;
+				}
+
+				body.aabb.min += displacement;
+				body.aabb.max += displacement;
+				tree.MoveProxy(body.proxy_id, body.aabb, displacement);
+			}
+			move_time += ElapsedMilliseconds(start);
+
+			start = SDL_GetPerformanceCounter();
+			pairs.clear();
+			tree.ComputeOverlappingPairs(pairs);
+			pair_time += ElapsedMilliseconds(start);
+			pair_total += pairs.size();
+		}
+
+		// brute force on the final frame for reference and as a correctness check
+		const auto start = SDL_GetPerformanceCounter();
+		size_t brute_force_pairs = 0;
+		for (auto i = 0; i < count; ++i)
+		{
+			for (auto j = i + 1; j < count; ++j)
+			{
+				if (bodies[i].aabb.Overlaps(bodies[j].aabb))
+				{
+					++brute_force_pairs;
+				}
+			}
+		}
+		const auto brute_force_time = ElapsedMilliseconds(start);
+
+		std::cout << count << " bodies: move " << move_time / frame_count << " ms, pairs " << pair_time / frame_count
+			<< " ms (" << pair_total / frame_count << " pairs, height " << tree.GetHeight() << ", "
+			<< tree.GetReinsertCount() / frame_count << " reinserts / frame) | brute force " << brute_force_time
+			<< " ms (" << brute_force_pairs << (brute_force_pairs == pairs.size() ? " pairs, match)" : " pairs, MISMATCH)") << std::endl;
+	}
+}
+
+int AABBTree::AllocateNode()
+{
+	if (m_freeList == NULL_NODE)
+	{
+		m_nodes.emplace_back();
+		return static_cast<int>(m_nodes.size()) - 1;
+	}
+
+	const auto node_id = m_freeList;
+	m_freeList = m_nodes[node_id].parent;
+	m_nodes[node_id] = Node();
+	return node_id;
+}
+
+void AABBTree::FreeNode(const int node_id)
+{
+	auto& node = m_nodes[node_id];
+	node.parent = m_freeList;
+	node.child1 = NULL_NODE;
+	node.child2 = NULL_NODE;
+	node.user_data = nullptr;
+	node.height = -1;
+	m_freeList = node_id;
+}
+
+void AABBTree::InsertLeaf(const int leaf)
+{
+	if (m_root == NULL_NODE)
+	{
+		m_root = leaf;
+		m_nodes[leaf].parent = NULL_NODE;
+		return;
+	}
+
+	// descend towards the sibling that grows the total perimeter the least
+	const auto leaf_aabb = m_nodes[leaf].aabb;
+	auto index = m_root;
+	while (!m_nodes[index].IsLeaf())
+	{
+		const auto& node = m_nodes[index];
+		const auto perimeter = node.aabb.GetPerimeter();
+		const auto combined_perimeter = AABB::Union(node.aabb, leaf_aabb).GetPerimeter();
+
+		// cost of making a new parent for this node and the leaf
+		const auto cost = 2.0f * combined_perimeter;
+		// cost pushed down to the children by enlarging this node
+		const auto inheritance_cost = 2.0f * (combined_perimeter - perimeter);
+
+		auto child_cost = [&](const int child_id)
+		{
+			const auto& child = m_nodes[child_id];
+			const auto enlarged = AABB::Union(leaf_aabb, child.aabb).GetPerimeter();
+			return (child.IsLeaf() ? enlarged : enlarged - child.aabb.GetPerimeter()) + inheritance_cost;
+		};
+
+		const auto cost1 = child_cost(node.child1);
+		const auto cost2 = child_cost(node.child2);
+		if (cost < cost1 && cost < cost2)
+		{
+			break;
+		}
+
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	const auto sibling = index;
+	const auto old_parent = m_nodes[sibling].parent;
+	const auto new_parent = AllocateNode();
+
+	// no references are held across AllocateNode, it may grow the node array
+	m_nodes[new_parent].parent = old_parent;
+	m_nodes[new_parent].aabb = AABB::Union(leaf_aabb, m_nodes[sibling].aabb);
+	m_nodes[new_parent].height = m_nodes[sibling].height + 1;
+	m_nodes[new_parent].child1 = sibling;
+	m_nodes[new_parent].child2 = leaf;
+	m_nodes[sibling].parent = new_parent;
+	m_nodes[leaf].parent = new_parent;
+
+	if (old_parent == NULL_NODE)
+	{
+		m_root = new_parent;
+	}
+	else if (m_nodes[old_parent].child1 == sibling)
+	{
+		m_nodes[old_parent].child1 = new_parent;
+	}
+	else
+	{
+		m_nodes[old_parent].child2 = new_parent;
+	}
+
+	Refit(m_nodes[leaf].parent);
+}
+
+void AABBTree::RemoveLeaf(const int leaf)
+{
+	if (leaf == m_root)
+	{
+		m_root = NULL_NODE;
+		return;
+	}
+
+	const auto parent = m_nodes[leaf].parent;
+	const auto grand_parent = m_nodes[parent].parent;
+	const auto sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+	// the sibling takes the place of the parent
+	m_nodes[sibling].parent = grand_parent;
+	FreeNode(parent);
+
+	if (grand_parent == NULL_NODE)
+	{
+		m_root = sibling;
+		return;
+	}
+
+	if (m_nodes[grand_parent].child1 == parent)
+	{
+		m_nodes[grand_parent].child1 = sibling;
+	}
+	else
+	{
+		m_nodes[grand_parent].child2 = sibling;
+	}
+
+	Refit(grand_parent);
+}
+
+/**
+ * \brief Rebalances and refits the boxes and heights from node_id up to the root
+ */
+void AABBTree::Refit(int node_id)
+{
+	while (node_id != NULL_NODE)
+	{
+		node_id = Balance(node_id);
+
+		auto& node = m_nodes[node_id];
+		const auto& child1 = m_nodes[node.child1];
+		const auto& child2 = m_nodes[node.child2];
+		node.height = 1 + std::max(child1.height, child2.height);
+		node.aabb = AABB::Union(child1.aabb, child2.aabb);
+
+		node_id = node.parent;
+	}
+}
+
+/**
+ * \brief If one child of node a is more than one level taller than the other, rotates it up to take a's place
+ * \return the node now at a's position
+ */
+int AABBTree::Balance(const int a)
+{
+	auto& node_a = m_nodes[a];
+	if (node_a.IsLeaf() || node_a.height < 2)
+	{
+		return a;
+	}
+
+	const auto b = node_a.child1;
+	const auto c = node_a.child2;
+	const auto balance = m_nodes[c].height - m_nodes[b].height;
+
+	if (balance >= -1 && balance <= 1)
+	{
+		return a;
+	}
+
+	// the taller child (up) is promoted, its shorter child (down) moves under a in up's old slot
+	const auto up = balance > 1 ? c : b;
+	const auto other = balance > 1 ? b : c;
+	auto& node_up = m_nodes[up];
+	const auto f = node_up.child1;
+	const auto g = node_up.child2;
+
+	node_up.child1 = a;
+	node_up.parent = node_a.parent;
+	node_a.parent = up;
+
+	if (node_up.parent == NULL_NODE)
+	{
+		m_root = up;
+	}
+	else if (m_nodes[node_up.parent].child1 == a)
+	{
+		m_nodes[node_up.parent].child1 = up;
+	}
+	else
+	{
+		m_nodes[node_up.parent].child2 = up;
+	}
+
+	const auto keep = m_nodes[f].height > m_nodes[g].height ? f : g;
+	const auto down = keep == f ? g : f;
+
+	node_up.child2 = keep;
+	(balance > 1 ? node_a.child2 : node_a.child1) = down;
+	m_nodes[down].parent = a;
+
+	node_a.aabb = AABB::Union(m_nodes[other].aabb, m_nodes[down].aabb);
+	node_a.height = 1 + std::max(m_nodes[other].height, m_nodes[down].height);
+	node_up.aabb = AABB::Union(node_a.aabb, m_nodes[keep].aabb);
+	node_up.height = 1 + std::max(node_a.height, m_nodes[keep].height);
+
+	return up;
+}
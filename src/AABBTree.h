@@ -0,0 +1,97 @@
+#pragma once
+#ifndef __AABB_TREE__
+#define __AABB_TREE__
+
+// Core Libraries
+#include <utility>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "AABB.h"
+
+class GameObject;
+
+/**
+ * \brief Dynamic bounding volume tree used as a collision broadphase.
+ * Every proxy is a leaf holding the object's exact box and a "fat" box enlarged by a margin
+ * (and stretched along the last displacement). Small moves inside the fat box cost nothing;
+ * a proxy is only removed and reinserted once it leaves it. Insertion picks the sibling with
+ * the lowest perimeter cost and rotations keep the tree balanced.
+ * Nodes live in one flat array and are addressed by index, freed nodes are recycled.
+ */
+class AABBTree
+{
+public:
+	static constexpr int NULL_NODE = -1;
+
+	explicit AABBTree(float margin = 4.0f);
+	~AABBTree();
+
+	// returns the proxy id that identifies the object in the tree
+	int CreateProxy(const AABB& aabb, GameObject* user_data = nullptr);
+	void DestroyProxy(int proxy_id);
+	// updates the box of a proxy, returns true if the proxy had to be reinserted
+	bool MoveProxy(int proxy_id, const AABB& aabb, glm::vec2 displacement = glm::vec2(0.0f, 0.0f));
+	void Clear();
+
+	// queries - results are proxy ids whose exact box overlaps / contains / is hit
+	void QueryRegion(const AABB& region, std::vector<int>& results) const;
+	void QueryPoint(glm::vec2 point, std::vector<int>& results) const;
+	// every proxy whose exact box the segment from start to end crosses, in no particular order
+	void QuerySegment(glm::vec2 start, glm::vec2 end, std::vector<int>& results) const;
+	// returns the first proxy hit by the segment or NULL_NODE, fraction is in [0, 1] along the segment
+	int Raycast(glm::vec2 start, glm::vec2 end, float& fraction) const;
+	// every pair of proxies whose exact boxes overlap, each pair once with the lower id first
+	void ComputeOverlappingPairs(std::vector<std::pair<int, int>>& pairs) const;
+
+	// getters
+	[[nodiscard]] GameObject* GetUserData(int proxy_id) const;
+	[[nodiscard]] const AABB& GetAABB(int proxy_id) const;
+	[[nodiscard]] const AABB& GetFatAABB(int proxy_id) const;
+	[[nodiscard]] int GetProxyCount() const;
+	[[nodiscard]] int GetHeight() const;
+	// number of proxies reinserted by MoveProxy since the tree was created
+	[[nodiscard]] int GetReinsertCount() const;
+
+	// outlines every node through DebugDraw, leaves in leaf_colour
+	void DrawDebug(glm::vec4 leaf_colour = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f), glm::vec4 branch_colour = glm::vec4(0.5f, 0.5f, 0.5f, 1.0f)) const;
+
+	// moves body_count random boxes for a number of frames and compares against the brute force pair test
+	static void Benchmark(int body_count = 10000);
+
+private:
+	struct Node
+	{
+		AABB aabb; // fat box
+		AABB tight; // exact box, leaves only
+		GameObject* user_data = nullptr;
+		int parent = NULL_NODE; // next free node while the node is on the free list
+		int child1 = NULL_NODE;
+		int child2 = NULL_NODE;
+		int height = -1; // 0 for leaves, -1 for free nodes
+
+		[[nodiscard]] bool IsLeaf() const { return child1 == NULL_NODE; }
+	};
+
+	int AllocateNode();
+	void FreeNode(int node_id);
+	void InsertLeaf(int leaf);
+	void RemoveLeaf(int leaf);
+	int Balance(int node_id);
+	void Refit(int node_id);
+
+	std::vector<Node> m_nodes;
+	int m_root;
+	int m_freeList;
+	int m_proxyCount;
+	int m_reinsertCount;
+	float m_margin;
+
+	// traversal scratch space, kept to avoid allocating during queries
+	mutable std::vector<int> m_stack;
+	mutable std::vector<std::pair<int, int>> m_pairStack;
+};
+
+#endif /* defined (__AABB_TREE__) */
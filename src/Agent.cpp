@@ -63,6 +63,7 @@ void Agent::SetHasLOS(const bool state)
 void Agent::SetCurrentHeading(const float heading)
 {
 	m_currentHeading = heading;
+	SetRotation(heading);
 	ChangeDirection();
 }
 
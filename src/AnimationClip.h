@@ -0,0 +1,49 @@
+#pragma once
+#ifndef __ANIMATION_CLIP__
+#define __ANIMATION_CLIP__
+#include <string>
+#include <vector>
+#include <SDL.h>
+#include "Animation.h"
+
+/**
+ * \brief Immutable playback data for an animation.
+ * Source rects and frame durations are resolved once at build time so playback
+ * never touches frame names or looks anything up.
+ */
+struct AnimationClip
+{
+	std::string name;
+	std::vector<SDL_Rect> source_rects;
+	std::vector<float> frame_durations; // seconds
+	float duration = 0.0f;
+	bool loop = true;
+
+	void AddFrame(const SDL_Rect& source_rect, const float frame_duration)
+	{
+		source_rects.push_back(source_rect);
+		frame_durations.push_back(frame_duration);
+		duration += frame_duration;
+	}
+
+	[[nodiscard]] int GetFrameCount() const
+	{
+		return static_cast<int>(source_rects.size());
+	}
+
+	// builds a clip that plays every frame of animation for the same amount of time
+	static AnimationClip FromAnimation(const Animation& animation, const float frames_per_second, const bool loop = true)
+	{
+		AnimationClip clip;
+		clip.name = animation.name;
+		clip.loop = loop;
+		const auto frame_duration = (frames_per_second > 0.0f) ? 1.0f / frames_per_second : 0.0f;
+		for (const auto& frame : animation.frames)
+		{
+			clip.AddFrame({ frame.x, frame.y, frame.w, frame.h }, frame_duration);
+		}
+		return clip;
+	}
+};
+
+#endif /* defined (__ANIMATION_CLIP__) */
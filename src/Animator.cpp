@@ -0,0 +1,100 @@
+#include "Animator.h"
+
+// returned when no clip is playing
+static const SDL_Rect s_emptyRect{};
+
+Animator::Animator() :
+	m_pClip(nullptr), m_time(0.0f), m_currentFrame(0), m_speed(1.0f), m_playing(false)
+{
+}
+
+Animator::~Animator()
+= default;
+
+void Animator::Play(const AnimationClip* clip, const bool restart)
+{
+	if (clip == m_pClip && !restart)
+	{
+		m_playing = (clip != nullptr);
+		return;
+	}
+
+	m_pClip = clip;
+	m_time = 0.0f;
+	m_currentFrame = 0;
+	m_playing = (clip != nullptr);
+}
+
+void Animator::Stop()
+{
+	m_playing = false;
+}
+
+void Animator::Advance(const float delta_time)
+{
+	if (!m_playing || m_pClip->GetFrameCount() < 2)
+	{
+		return;
+	}
+
+	m_time += delta_time * m_speed;
+
+	// step through as many frames as the elapsed time covers (handles long frames and hitches)
+	const auto frame_count = m_pClip->GetFrameCount();
+	auto frame_duration = m_pClip->frame_durations[m_currentFrame];
+	while (m_time >= frame_duration && frame_duration > 0.0f)
+	{
+		m_time -= frame_duration;
+
+		if (m_currentFrame + 1 < frame_count)
+		{
+			++m_currentFrame;
+		}
+		else if (m_pClip->loop)
+		{
+			m_currentFrame = 0;
+		}
+		else
+		{
+			m_time = 0.0f;
+			m_playing = false;
+			break;
+		}
+
+		frame_duration = m_pClip->frame_durations[m_currentFrame];
+	}
+}
+
+const AnimationClip* Animator::GetClip() const
+{
+	return m_pClip;
+}
+
+const SDL_Rect& Animator::GetSourceRect() const
+{
+	if (m_pClip == nullptr || m_pClip->source_rects.empty())
+	{
+		return s_emptyRect;
+	}
+	return m_pClip->source_rects[m_currentFrame];
+}
+
+int Animator::GetCurrentFrame() const
+{
+	return m_currentFrame;
+}
+
+float Animator::GetSpeed() const
+{
+	return m_speed;
+}
+
+bool Animator::IsPlaying() const
+{
+	return m_playing;
+}
+
+void Animator::SetSpeed(const float speed)
+{
+	m_speed = speed;
+}
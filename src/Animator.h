@@ -0,0 +1,39 @@
+#pragma once
+#ifndef __ANIMATOR__
+#define __ANIMATOR__
+#include "AnimationClip.h"
+
+/**
+ * \brief Playback state for one AnimationClip, advanced by delta time.
+ * Scenes advance all the animators of their children in one pass (see Scene::UpdateAnimators).
+ */
+class Animator
+{
+public:
+	Animator();
+	~Animator();
+
+	// starts playing clip - playing the current clip again does nothing unless restart is true
+	void Play(const AnimationClip* clip, bool restart = false);
+	void Stop();
+	void Advance(float delta_time);
+
+	// getters
+	[[nodiscard]] const AnimationClip* GetClip() const;
+	[[nodiscard]] const SDL_Rect& GetSourceRect() const;
+	[[nodiscard]] int GetCurrentFrame() const;
+	[[nodiscard]] float GetSpeed() const;
+	[[nodiscard]] bool IsPlaying() const;
+
+	// setters
+	void SetSpeed(float speed);
+
+private:
+	const AnimationClip* m_pClip;
+	float m_time;
+	int m_currentFrame;
+	float m_speed;
+	bool m_playing;
+};
+
+#endif /* defined (__ANIMATOR__) */
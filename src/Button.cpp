@@ -63,7 +63,11 @@ void Button::Clean()
  */
 void Button::SetAlpha(const Uint8 alpha)
 {
-	m_alpha = alpha;
+	if (m_alpha != alpha)
+	{
+		m_alpha = alpha;
+		InvalidateLayerCache();
+	}
 }
 
 /**
@@ -0,0 +1,20 @@
+#pragma once
+#ifndef __COLLISION_EVENT__
+#define __COLLISION_EVENT__
+
+#include "CollisionEventType.h"
+#include "CollisionShape.h"
+
+class GameObject;
+
+struct CollisionEvent
+{
+	CollisionEventType type = CollisionEventType::ENTER;
+	// object1 is the object that was tested (the circle, the line...), handlers are looked up by the type of object2
+	GameObject* object1 = nullptr;
+	GameObject* object2 = nullptr;
+	// shape object1 was tested as
+	CollisionShape shape = CollisionShape::NO_COLLIDER;
+};
+
+#endif /* defined (__COLLISION_EVENT__) */
@@ -0,0 +1,184 @@
+#include "CollisionEventQueue.h"
+#include <algorithm>
+#include "GameObject.h"
+
+void CollisionEventQueue::AddContact(GameObject* object1, GameObject* object2, const CollisionShape shape)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_contacts.push_back({ CollisionEventType::STAY, object1, object2, shape });
+}
+
+void CollisionEventQueue::AddContacts(const std::vector<CollisionEvent>& contacts)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_contacts.insert(m_contacts.end(), contacts.begin(), contacts.end());
+}
+
+void CollisionEventQueue::Update()
+{
+	m_events.clear();
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		// a pair reported more than once in a frame (by two checks or two threads) is one contact
+		std::sort(m_contacts.begin(), m_contacts.end(), ContactLess);
+		m_contacts.erase(std::unique(m_contacts.begin(), m_contacts.end(), [](const CollisionEvent& lhs, const CollisionEvent& rhs)
+		{
+			return !ContactLess(lhs, rhs) && !ContactLess(rhs, lhs);
+		}), m_contacts.end());
+
+		// both lists are sorted - walk them together
+		auto current = m_contacts.begin();
+		auto previous = m_previousContacts.begin();
+		while (current != m_contacts.end() || previous != m_previousContacts.end())
+		{
+			if (previous == m_previousContacts.end() || (current != m_contacts.end() && ContactLess(*current, *previous)))
+			{
+				m_events.push_back(*current++);
+				m_events.back().type = CollisionEventType::ENTER;
+			}
+			else if (current == m_contacts.end() || ContactLess(*previous, *current))
+			{
+				m_events.push_back(*previous++);
+				m_events.back().type = CollisionEventType::EXIT;
+			}
+			else
+			{
+				m_events.push_back(*current++);
+				m_events.back().type = CollisionEventType::STAY;
+				++previous;
+			}
+		}
+
+		m_previousContacts.swap(m_contacts);
+		m_contacts.clear();
+	}
+
+	// flags first so every handler sees the state of the whole frame - exits clear before enters and stays set,
+	// so an object that left one partner but still touches another stays colliding
+	for (const auto& event : m_events)
+	{
+		if (event.type == CollisionEventType::EXIT)
+		{
+			event.object2->GetRigidBody()->isColliding = false;
+		}
+	}
+	for (const auto& event : m_events)
+	{
+		if (event.type != CollisionEventType::EXIT)
+		{
+			event.object2->GetRigidBody()->isColliding = true;
+		}
+	}
+
+	// handlers may remove objects (which only blanks their events while dispatching) or even change the scene,
+	// so nothing is held across a handler call
+	m_dispatching = true;
+	for (size_t i = 0; i < m_events.size(); ++i)
+	{
+		if (m_events[i].object2 == nullptr)
+		{
+			continue;
+		}
+
+		const auto found = m_handlers.find(m_events[i].object2->GetType());
+		if (found == m_handlers.end())
+		{
+			continue;
+		}
+
+		// a copy - a handler may add or remove handlers
+		const auto handlers = found->second;
+		const auto event = m_events[i];
+		for (const auto& handler : handlers)
+		{
+			// an earlier handler may have removed one of the objects
+			if (m_events[i].object1 == nullptr || m_events[i].object2 == nullptr)
+			{
+				break;
+			}
+			handler(event);
+		}
+	}
+	m_dispatching = false;
+}
+
+void CollisionEventQueue::AddHandler(const GameObjectType type, const Handler& handler)
+{
+	m_handlers[type].push_back(handler);
+}
+
+void CollisionEventQueue::RemoveHandlers(const GameObjectType type)
+{
+	m_handlers.erase(type);
+}
+
+const std::vector<CollisionEvent>& CollisionEventQueue::GetEvents() const
+{
+	return m_events;
+}
+
+void CollisionEventQueue::RemoveObject(const GameObject* object)
+{
+	auto involves = [object](const CollisionEvent& contact)
+	{
+		return contact.object1 == object || contact.object2 == object;
+	};
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_contacts.erase(std::remove_if(m_contacts.begin(), m_contacts.end(), involves), m_contacts.end());
+	m_previousContacts.erase(std::remove_if(m_previousContacts.begin(), m_previousContacts.end(), involves), m_previousContacts.end());
+
+	if (m_dispatching)
+	{
+		for (auto& event : m_events)
+		{
+			if (involves(event))
+			{
+				event.object1 = nullptr;
+				event.object2 = nullptr;
+			}
+		}
+	}
+	else
+	{
+		m_events.erase(std::remove_if(m_events.begin(), m_events.end(), involves), m_events.end());
+	}
+}
+
+void CollisionEventQueue::Clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_contacts.clear();
+	m_previousContacts.clear();
+	m_events.clear();
+}
+
+void CollisionEventQueue::Reset()
+{
+	Clear();
+	m_handlers.clear();
+}
+
+bool CollisionEventQueue::ContactLess(const CollisionEvent& lhs, const CollisionEvent& rhs)
+{
+	// pointers are compared through std::less, which gives a total order
+	constexpr std::less<const GameObject*> less;
+	if (lhs.object1 != rhs.object1)
+	{
+		return less(lhs.object1, rhs.object1);
+	}
+	if (lhs.object2 != rhs.object2)
+	{
+		return less(lhs.object2, rhs.object2);
+	}
+	return lhs.shape < rhs.shape;
+}
+
+CollisionEventQueue::CollisionEventQueue() : m_dispatching(false)
+{
+}
+
+CollisionEventQueue::~CollisionEventQueue()
+= default;
@@ -0,0 +1,71 @@
+#pragma once
+#ifndef __COLLISION_EVENT_QUEUE__
+#define __COLLISION_EVENT_QUEUE__
+
+// Core Libraries
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "CollisionEvent.h"
+#include "GameObjectType.h"
+
+/* Singleton
+ * Separates collision detection from collision response.
+ * Detection reports the pairs it finds overlapping with AddContact - this is the only thing it does,
+ * so it can run anywhere (AddContact is thread safe). Once per frame Update compares the contacts
+ * with the previous frame's, queues ENTER, STAY and EXIT events, keeps RigidBody::isColliding in
+ * step and calls the handlers registered for the type of each event's object2.
+ */
+class CollisionEventQueue
+{
+public:
+	static CollisionEventQueue& Instance()
+	{
+		static CollisionEventQueue instance;
+		return instance;
+	}
+
+	typedef std::function<void(const CollisionEvent&)> Handler;
+
+	// detection
+	void AddContact(GameObject* object1, GameObject* object2, CollisionShape shape);
+	void AddContacts(const std::vector<CollisionEvent>& contacts);
+
+	// main thread, once per frame after detection - builds this frame's events and dispatches them
+	void Update();
+
+	// response
+	void AddHandler(GameObjectType type, const Handler& handler);
+	void RemoveHandlers(GameObjectType type);
+
+	// events built by the last Update
+	[[nodiscard]] const std::vector<CollisionEvent>& GetEvents() const;
+
+	// drops the contacts of an object that is about to be deleted, without EXIT events
+	void RemoveObject(const GameObject* object);
+	// drops every contact and event
+	void Clear();
+	// drops every contact, event and handler
+	void Reset();
+
+private:
+	CollisionEventQueue();
+	~CollisionEventQueue();
+	CollisionEventQueue(const CollisionEventQueue&) = delete;
+	CollisionEventQueue& operator=(const CollisionEventQueue&) = delete;
+
+	static bool ContactLess(const CollisionEvent& lhs, const CollisionEvent& rhs);
+
+	std::mutex m_mutex;
+	// contacts reported this frame
+	std::vector<CollisionEvent> m_contacts;
+	// contacts of the last frame, sorted
+	std::vector<CollisionEvent> m_previousContacts;
+	std::vector<CollisionEvent> m_events;
+	std::unordered_map<GameObjectType, std::vector<Handler>> m_handlers;
+	bool m_dispatching;
+};
+
+#endif /* defined (__COLLISION_EVENT_QUEUE__) */
@@ -0,0 +1,13 @@
+#pragma once
+#ifndef __COLLISION_EVENT_TYPE__
+#define __COLLISION_EVENT_TYPE__
+
+enum class CollisionEventType
+{
+	ENTER,
+	STAY,
+	EXIT,
+	NUM_OF_EVENT_TYPES
+};
+
+#endif /* defined (__COLLISION_EVENT_TYPE__) */
@@ -0,0 +1,116 @@
+#include "CollisionFilter.h"
+#include <atomic>
+
+namespace
+{
+	// [type1 + 1][type2 + 1], NONE is row and column 0 - symmetric, both halves are kept up to date
+	// atomic because collision checks may run on a worker thread while the main thread ends the frame
+	std::atomic<int> s_testCounts[CollisionFilter::TYPE_COUNT][CollisionFilter::TYPE_COUNT];
+	std::atomic<int> s_lastTestCounts[CollisionFilter::TYPE_COUNT][CollisionFilter::TYPE_COUNT];
+	std::atomic<int> s_rejectedCount = 0;
+	std::atomic<int> s_lastRejectedCount = 0;
+
+	int Index(const GameObjectType type)
+	{
+		return static_cast<int>(type) + 1;
+	}
+
+	std::uint32_t Bit(const GameObjectType type)
+	{
+		return 1u << static_cast<int>(type);
+	}
+}
+
+std::uint32_t CollisionFilter::GetCategory(const GameObjectType type)
+{
+	if (type == GameObjectType::NONE || type == GameObjectType::NUM_OF_TYPES)
+	{
+		return DEFAULT_CATEGORY;
+	}
+	return Bit(type);
+}
+
+std::uint32_t CollisionFilter::GetDefaultMask(const GameObjectType type)
+{
+	const auto buttons = Bit(GameObjectType::START_BUTTON) | Bit(GameObjectType::RESTART_BUTTON) |
+		Bit(GameObjectType::BACK_BUTTON) | Bit(GameObjectType::NEXT_BUTTON);
+
+	switch (type)
+	{
+	case GameObjectType::START_BUTTON:
+	case GameObjectType::RESTART_BUTTON:
+	case GameObjectType::BACK_BUTTON:
+	case GameObjectType::NEXT_BUTTON:
+		// UI is picked with the mouse, never by collision
+		return 0;
+	case GameObjectType::PATH_NODE:
+		// path nodes only look for line of sight past obstacles to the target
+		return Bit(GameObjectType::OBSTACLE) | Bit(GameObjectType::TARGET);
+	case GameObjectType::OBSTACLE:
+		// obstacles never move, pairs of them never change
+		return ALL & ~buttons & ~Bit(GameObjectType::OBSTACLE);
+	default:
+		return ALL & ~buttons;
+	}
+}
+
+bool CollisionFilter::ShouldTest(GameObject* object1, GameObject* object2)
+{
+	if (!ShouldCollide(*object1->GetRigidBody(), *object2->GetRigidBody()))
+	{
+		s_rejectedCount.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	const auto index1 = Index(object1->GetType());
+	const auto index2 = Index(object2->GetType());
+	s_testCounts[index1][index2].fetch_add(1, std::memory_order_relaxed);
+	if (index1 != index2)
+	{
+		s_testCounts[index2][index1].fetch_add(1, std::memory_order_relaxed);
+	}
+	return true;
+}
+
+void CollisionFilter::EndFrame()
+{
+	for (auto row = 0; row < TYPE_COUNT; ++row)
+	{
+		for (auto column = 0; column < TYPE_COUNT; ++column)
+		{
+			s_lastTestCounts[row][column].store(s_testCounts[row][column].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+	}
+	s_lastRejectedCount.store(s_rejectedCount.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+int CollisionFilter::GetTestCount(const GameObjectType type1, const GameObjectType type2)
+{
+	return s_lastTestCounts[Index(type1)][Index(type2)].load(std::memory_order_relaxed);
+}
+
+int CollisionFilter::GetRejectedCount()
+{
+	return s_lastRejectedCount.load(std::memory_order_relaxed);
+}
+
+const char* CollisionFilter::GetTypeName(const GameObjectType type)
+{
+	switch (type)
+	{
+	case GameObjectType::NONE: return "NONE";
+	case GameObjectType::AGENT: return "AGENT";
+	case GameObjectType::PATH_NODE: return "PATH_NODE";
+	case GameObjectType::SPACE_SHIP: return "SPACE_SHIP";
+	case GameObjectType::OBSTACLE: return "OBSTACLE";
+	case GameObjectType::SHIP: return "SHIP";
+	case GameObjectType::TARGET: return "TARGET";
+	case GameObjectType::PLAYER: return "PLAYER";
+	case GameObjectType::PLANE: return "PLANE";
+	case GameObjectType::START_BUTTON: return "START_BUTTON";
+	case GameObjectType::RESTART_BUTTON: return "RESTART_BUTTON";
+	case GameObjectType::BACK_BUTTON: return "BACK_BUTTON";
+	case GameObjectType::NEXT_BUTTON: return "NEXT_BUTTON";
+	default: return "UNKNOWN";
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+#ifndef __COLLISION_FILTER__
+#define __COLLISION_FILTER__
+
+// Core Libraries
+#include <cstdint>
+
+#include "GameObject.h"
+
+/**
+ * \brief Category and mask bits that decide which pairs of objects are worth a geometric test.
+ * Every object's RigidBody carries the category it belongs to and the mask of categories it collides with;
+ * a pair is only tested when each object's category is in the other's mask. SetType assigns the defaults
+ * for the type, which objects can then narrow or widen.
+ * Pairs that pass are counted by type so the debug matrix can show what is actually tested each frame.
+ */
+class CollisionFilter
+{
+public:
+	static constexpr int TYPE_COUNT = static_cast<int>(GameObjectType::NUM_OF_TYPES) + 1; // NONE included
+
+	static constexpr std::uint32_t ALL = 0xFFFFFFFFu;
+	// untyped objects (NONE) share the last bit and collide with everything
+	static constexpr std::uint32_t DEFAULT_CATEGORY = 0x80000000u;
+
+	[[nodiscard]] static std::uint32_t GetCategory(GameObjectType type);
+	[[nodiscard]] static std::uint32_t GetDefaultMask(GameObjectType type);
+
+	// the only test every collision path does before geometry
+	[[nodiscard]] static bool ShouldCollide(const RigidBody& body1, const RigidBody& body2)
+	{
+		return (body1.categoryBits & body2.maskBits) != 0 && (body2.categoryBits & body1.maskBits) != 0;
+	}
+
+	// filters the pair and counts it in the matrix when it passes
+	static bool ShouldTest(GameObject* object1, GameObject* object2);
+
+	// once per frame - the counts of the frame that just ended become the ones the getters return
+	static void EndFrame();
+
+	// getters - counts of the last complete frame
+	[[nodiscard]] static int GetTestCount(GameObjectType type1, GameObjectType type2);
+	[[nodiscard]] static int GetRejectedCount();
+	[[nodiscard]] static const char* GetTypeName(GameObjectType type);
+
+private:
+	CollisionFilter();
+};
+
+#endif /* defined (__COLLISION_FILTER__) */
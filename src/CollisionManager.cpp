@@ -1,5 +1,7 @@
 #include "CollisionManager.h"
 #include "Util.h"
+#include "CollisionEventQueue.h"
+#include "CollisionFilter.h"
 #include <algorithm>
 
 
@@ -16,77 +18,15 @@ bool CollisionManager::SquaredRadiusCheck(GameObject* object1, GameObject* objec
 {
 	const glm::vec2 p1 = object1->GetTransform()->position;
 	const glm::vec2 p2 = object2->GetTransform()->position;
+	const int half_heights = static_cast<int>((object1->GetHeight() + object2->GetHeight()) * 0.5);
 
-	if (const int half_heights = static_cast<int>((object1->GetHeight() + object2->GetHeight()) * 0.5); 
-		SquaredDistance(p1, p2) < (half_heights * half_heights)) 
-	{
-		if (!object2->GetRigidBody()->isColliding) 
-		{
-			object2->GetRigidBody()->isColliding = true;
-
-			switch (object2->GetType()) {
-			case GameObjectType::TARGET:
-				std::cout << "Collision with Target!" << std::endl;
-				SoundManager::Instance().PlaySound("yay", 0);
-
-				break;
-			default:
-
-				break;
-			}
-
-			return true;
-		}
-		return false;
-	}
-	object2->GetRigidBody()->isColliding = false;
-	return false;
-
+	return SquaredDistance(p1, p2) < (half_heights * half_heights);
 }
 
 bool CollisionManager::AABBCheck(GameObject* object1, GameObject* object2)
 {
-	// prepare relevant variables
-	const auto p1 = object1->GetTransform()->position;
-	const auto p2 = object2->GetTransform()->position;
-	const auto p1_width = static_cast<float>(object1->GetWidth());
-	const auto p1_height = static_cast<float>(object1->GetHeight());
-	const auto p2_width = static_cast<float>(object2->GetWidth());
-	const auto p2_height = static_cast<float>(object2->GetHeight());
-
-	if (
-		p1.x < p2.x + p2_width &&
-		p1.x + p1_width > p2.x &&
-		p1.y < p2.y + p2_height &&
-		p1.y + p1_height > p2.y
-		)
-	{
-		if (!object2->GetRigidBody()->isColliding) 
-		{
-
-			object2->GetRigidBody()->isColliding = true;
-
-			switch (object2->GetType()) {
-			case GameObjectType::TARGET:
-				std::cout << "Collision with Target!" << std::endl;
-				SoundManager::Instance().PlaySound("yay", 0);
-				break;
-			case GameObjectType::OBSTACLE:
-				std::cout << "Collision with Obstacle!" << std::endl;
-				SoundManager::Instance().PlaySound("yay", 0);
-				break;
-			default:
-
-				break;
-			}
-
-			return true;
-		}
-		return false;
-	}
-	object2->GetRigidBody()->isColliding = false;
-	return false;
-
+	// the same boxes the broadphase tree holds, so a pair it never reports can never collide here
+	return ComputeAABB(object1).Overlaps(ComputeAABB(object2));
 }
 
 bool CollisionManager::LineLineCheck(const glm::vec2 line1_start, const glm::vec2 line1_end, const glm::vec2 line2_start, const glm::vec2 line2_end)
@@ -227,22 +167,7 @@ bool CollisionManager::LineAABBCheck(Ship* object1, GameObject* object2)
 	const auto half_box_height = box_height * 0.5f;
 	const auto box_start = object2->GetTransform()->position - glm::vec2(half_box_width, half_box_height);
 
-	if (LineRectCheck(line_start, line_end, box_start, box_width, box_height))
-	{
-		switch (object2->GetType())
-		{
-		case GameObjectType::TARGET:
-			std::cout << "Collision with Obstacle!" << std::endl;
-			SoundManager::Instance().PlaySound("yay", 0);
-
-			break;
-		default:
-
-			break;
-		}
-		return true;
-	}
-	return false;
+	return LineRectCheck(line_start, line_end, box_start, box_width, box_height);
 }
 
 int CollisionManager::CircleAABBSquaredDistance(const glm::vec2 circle_centre, int circle_radius, const glm::vec2 box_start, const int box_width, const int box_height)
@@ -268,75 +193,9 @@ bool CollisionManager::CircleAABBCheck(GameObject* object1, GameObject* object2)
 	const auto circle_radius = static_cast<int>(std::max(half_box_width, half_box_height));
 
 	// aabb
+	const auto box_start = object2->GetTransform()->position - glm::vec2(half_box_width, half_box_height);
 
-	if (const auto box_start = object2->GetTransform()->position - glm::vec2(half_box_width, half_box_height); 
-		CircleAABBSquaredDistance(circle_centre, circle_radius, box_start, object2->GetWidth(), object2->GetHeight()) <= (circle_radius * circle_radius))
-	{
-		if (!object2->GetRigidBody()->isColliding) 
-		{
-			object2->GetRigidBody()->isColliding = true;
-
-			const auto attack_vector = object1->GetTransform()->position - object2->GetTransform()->position;
-			constexpr auto normal = glm::vec2(0.0f, -1.0f);
-
-			const auto dot = Util::Dot(attack_vector, normal);
-			const auto angle = acos(dot / Util::Magnitude(attack_vector)) * Util::Rad2Deg;
-
-			switch (object2->GetType())
-			{
-			case GameObjectType::TARGET:
-				std::cout << "Collision with Planet!" << std::endl;
-				SoundManager::Instance().PlaySound("yay", 0);
-				break;
-			case GameObjectType::SHIP:
-			{
-				SoundManager::Instance().PlaySound("thunder", 0);
-				const auto velocity_x = object1->GetRigidBody()->velocity.x;
-				const auto velocity_y = object1->GetRigidBody()->velocity.y;
-
-				if ((attack_vector.x > 0 && attack_vector.y < 0) || (attack_vector.x < 0 && attack_vector.y < 0))
-					// top right or top left
-				{
-					if (angle <= 45)
-					{
-						object1->GetRigidBody()->velocity = glm::vec2(velocity_x, -velocity_y);
-					}
-					else
-					{
-						object1->GetRigidBody()->velocity = glm::vec2(-velocity_x, velocity_y);
-					}
-				}
-
-				if ((attack_vector.x > 0 && attack_vector.y > 0) || (attack_vector.x < 0 && attack_vector.y > 0))
-					// bottom right or bottom left
-				{
-					if (angle <= 135)
-					{
-						object1->GetRigidBody()->velocity = glm::vec2(-velocity_x, velocity_y);
-					}
-					else
-					{
-						object1->GetRigidBody()->velocity = glm::vec2(velocity_x, -velocity_y);
-					}
-				}
-			}
-			case GameObjectType::AGENT:
-			{
-				SoundManager::Instance().PlaySound("yay", 0);
-			}
-			break;
-			default:
-
-				break;
-			}
-
-			return true;
-		}
-		return false;
-	}
-	object2->GetRigidBody()->isColliding = false;
-	return false;
-
+	return CircleAABBSquaredDistance(circle_centre, circle_radius, box_start, object2->GetWidth(), object2->GetHeight()) <= (circle_radius * circle_radius);
 }
 
 bool CollisionManager::PointRectCheck(const glm::vec2 point, const glm::vec2 rect_start, const float rect_width, const float rect_height)
@@ -363,6 +222,12 @@ bool CollisionManager::LOSCheck(Agent* agent, const glm::vec2 end_point, const s
 
 	for (const auto object : objects)
 	{
+		// objects the agent cannot collide with are skipped before any geometry
+		if (!CollisionFilter::ShouldTest(agent, object))
+		{
+			continue;
+		}
+
 		const auto width = static_cast<float>(object->GetWidth());
 		const auto height = static_cast<float>(object->GetHeight());
 		auto object_offset = glm::vec2(width * 0.5f, height * 0.5f);
@@ -412,75 +277,358 @@ bool CollisionManager::LOSCheck(Agent* agent, const glm::vec2 end_point, const s
 	return false;
 }
 
-void CollisionManager::RotateAABB(GameObject* object1, const float angle)
+/**
+ * \brief Same answer as LOSCheck, but the obstacles come from a tree (built from their centred boxes) instead of a list,
+ * so the cost grows with the obstacles near the line rather than with every obstacle in the scene.
+ * The target does not need to be in the tree.
+ */
+bool CollisionManager::LOSCheck(const AABBTree& obstacles, Agent* agent, const glm::vec2 end_point, DisplayObject* target)
 {
-	// create an array of vec2s using right winding order (TL, TR, BR, BL)
-	glm::vec2 points[4];
+	const auto start_point = agent->GetTransform()->position;
 
-	const glm::vec2 position = object1->GetTransform()->position;
+	// the same filter as the list version - a target the agent cannot collide with is never seen
+	if (!CollisionFilter::ShouldTest(agent, target))
+	{
+		return false;
+	}
 
-	const auto width = object1->GetRigidBody()->bounds.x;
-	const float half_width = width * 0.5f;
-	const auto height = object1->GetRigidBody()->bounds.y;
-	const float half_height = height * 0.5f;
+	const auto width = static_cast<float>(target->GetWidth());
+	const auto height = static_cast<float>(target->GetHeight());
+	const auto rect_start = target->GetTransform()->position - glm::vec2(width * 0.5f, height * 0.5f);
 
-	// check if object1 is centered
-	if (object1->isCentered())
+	// the cheap target test first, most agents cannot see it
+	const auto sees_target = (agent->GetType() == GameObjectType::PATH_NODE) ?
+		LineRectEdgeCheck(start_point, rect_start, width, height) :
+		LineRectCheck(start_point, end_point, rect_start, width, height);
+	if (!sees_target)
 	{
-		// compute points
-		points[0] = glm::vec2(position.x - half_width, position.y - half_height);
-		points[1] = glm::vec2(position.x + half_width, position.y - half_height);
-		points[2] = glm::vec2(position.x + half_width, position.y + half_height);
-		points[3] = glm::vec2(position.x - half_width, position.y + half_height);
+		return false;
 	}
-	else
+
+	thread_local std::vector<int> hits;
+	hits.clear();
+	obstacles.QuerySegment(start_point, end_point, hits);
+
+	for (const auto proxy_id : hits)
 	{
-		// compute points
-		points[0] = glm::vec2(position.x, position.y);
-		points[1] = glm::vec2(position.x + width, position.y);
-		points[2] = glm::vec2(position.x + width, position.y + height);
-		points[3] = glm::vec2(position.x, position.y + height);
+		const auto object = obstacles.GetUserData(proxy_id);
+		if (object == nullptr || object == target || object->GetType() != GameObjectType::OBSTACLE)
+		{
+			continue;
+		}
+
+		// obstacles the agent cannot collide with do not block it, as in the list version
+		if (CollisionFilter::ShouldTest(agent, object))
+		{
+			return false;
+		}
 	}
 
-	// rotate each point by the desired angle
-	for (int i = 0; i < 4; ++i)
+	return true;
+}
+
+void CollisionManager::LOSCheck(const AABBTree& obstacles, const std::vector<LOSRequest>& requests, std::vector<bool>& results)
+{
+	results.assign(requests.size(), false);
+	for (size_t i = 0; i < requests.size(); ++i)
 	{
-		points[i] = Util::RotatePoint(points[i], angle, position);
+		results[i] = LOSCheck(obstacles, requests[i].agent, requests[i].end_point, requests[i].target);
 	}
+}
 
-	// initialize extents
-	auto top_left = glm::vec2(INFINITY, INFINITY);
-	auto bot_right = glm::vec2(-INFINITY, -INFINITY);
+void CollisionManager::LOSBenchmark(const int agent_count, const int obstacle_count)
+{
+	class BenchmarkAgent final : public Agent
+	{
+	public:
+		void Draw() override {}
+		void Update() override {}
+		void Clean() override {}
+	};
 
-	// compute extents (top_left and bot_right)
-	for (const auto point : points)
+	class BenchmarkObject final : public DisplayObject
 	{
-		if (top_left.x > point.x)
+	public:
+		void Draw() override {}
+		void Update() override {}
+		void Clean() override {}
+	};
+
+	const auto world_size = glm::vec2(static_cast<float>(Config::SCREEN_WIDTH), static_cast<float>(Config::SCREEN_HEIGHT));
+
+	std::vector<BenchmarkObject> objects(obstacle_count + 1);
+	AABBTree tree;
+	for (auto i = 0; i < obstacle_count; ++i)
+	{
+		auto& obstacle = objects[i];
+		obstacle.SetType(GameObjectType::OBSTACLE);
+		obstacle.SetWidth(static_cast<int>(Util::RandomRange(16.0f, 48.0f)));
+		obstacle.SetHeight(static_cast<int>(Util::RandomRange(16.0f, 48.0f)));
+		obstacle.GetTransform()->position = Util::RandomRange(glm::vec2(0.0f, 0.0f), world_size);
+		tree.CreateProxy(AABB::FromPosition(obstacle.GetTransform()->position, static_cast<float>(obstacle.GetWidth()),
+			static_cast<float>(obstacle.GetHeight()), true), &obstacle);
+	}
+
+	// LOSCheck expects the target last in the list
+	auto& target = objects.back();
+	target.SetType(GameObjectType::TARGET);
+	target.SetWidth(40);
+	target.SetHeight(40);
+	target.GetTransform()->position = world_size * 0.5f;
+
+	std::vector<DisplayObject*> object_list;
+	for (auto& object : objects)
+	{
+		object_list.push_back(&object);
+	}
+
+	std::vector<BenchmarkAgent> agents(agent_count);
+	std::vector<LOSRequest> requests;
+	for (auto& agent : agents)
+	{
+		agent.SetType(GameObjectType::AGENT);
+		agent.GetTransform()->position = Util::RandomRange(glm::vec2(0.0f, 0.0f), world_size);
+		requests.push_back({ &agent, target.GetTransform()->position, &target });
+	}
+
+	auto start = SDL_GetPerformanceCounter();
+	auto list_visible = 0;
+	for (const auto& request : requests)
+	{
+		list_visible += LOSCheck(request.agent, request.end_point, object_list, request.target);
+	}
+	const auto list_time = static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+
+	std::vector<bool> results;
+	start = SDL_GetPerformanceCounter();
+	LOSCheck(tree, requests, results);
+	const auto tree_time = static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+	const auto tree_visible = static_cast<int>(std::count(results.begin(), results.end(), true));
+
+	std::cout << "------------ LOS Benchmark ----------" << std::endl;
+	std::cout << agent_count << " agents, " << obstacle_count << " obstacles" << std::endl;
+	std::cout << "object list: " << list_time << " ms (" << list_visible << " with LOS)" << std::endl;
+	std::cout << "tree batch:  " << tree_time << " ms (" << tree_visible << " with LOS)" << std::endl;
+}
+
+/**
+ * \brief Oriented box check for rotated objects. The enclosing boxes of the cached OBBs reject most pairs
+ * before the separating axis test runs; neither object's width or height is touched.
+ */
+bool CollisionManager::OBBCheck(GameObject* object1, GameObject* object2)
+{
+	const auto& obb1 = object1->GetOBB();
+	const auto& obb2 = object2->GetOBB();
+
+	if (!obb1.bounds.Overlaps(obb2.bounds))
+	{
+		return false;
+	}
+
+	return obb1.Overlaps(obb2);
+}
+
+/**
+ * \brief Time of impact of a box moving by displacement against a static box. The target is grown by the
+ * half size of the moving box (Minkowski sum) so the sweep becomes a ray from the moving box's centre.
+ * \param time_of_impact fraction of the displacement travelled before touching, 0 if already overlapping
+ * \param normal face of the target that was hit, zero if already overlapping
+ * \return true if the boxes overlap at any point of the move
+ */
+bool CollisionManager::SweptAABB(const AABB& moving, const glm::vec2 displacement, const AABB& target, float& time_of_impact, glm::vec2& normal)
+{
+	normal = glm::vec2(0.0f, 0.0f);
+
+	// already overlapping at the start of the move
+	if (moving.min.x < target.max.x && moving.max.x > target.min.x && moving.min.y < target.max.y && moving.max.y > target.min.y)
+	{
+		time_of_impact = 0.0f;
+		return true;
+	}
+
+	const auto half_size = moving.GetSize() * 0.5f;
+	const auto start = moving.GetCentre();
+	const auto expanded_min = target.min - half_size;
+	const auto expanded_max = target.max + half_size;
+
+	auto entry = -INFINITY;
+	auto exit = 1.0f;
+	for (auto axis = 0; axis < 2; ++axis)
+	{
+		if (std::fabs(displacement[axis]) < Util::EPSILON)
 		{
-			top_left.x = point.x;
+			// no motion on this axis - it has to overlap already
+			if (start[axis] <= expanded_min[axis] || start[axis] >= expanded_max[axis])
+			{
+				return false;
+			}
+			continue;
 		}
 
-		if (top_left.y > point.y)
+		const auto inverse = 1.0f / displacement[axis];
+		auto near_time = (expanded_min[axis] - start[axis]) * inverse;
+		auto far_time = (expanded_max[axis] - start[axis]) * inverse;
+		if (near_time > far_time)
 		{
-			top_left.y = point.y;
+			std::swap(near_time, far_time);
 		}
 
-		if (bot_right.x < point.x)
+		if (near_time > entry)
+		{
+			entry = near_time;
+			normal = glm::vec2(0.0f, 0.0f);
+			normal[axis] = displacement[axis] > 0.0f ? -1.0f : 1.0f;
+		}
+		exit = std::min(exit, far_time);
+	}
+
+	// grazing contact (entry == exit) slides along the face and is not a hit
+	if (entry < 0.0f || entry > 1.0f || entry >= exit)
+	{
+		normal = glm::vec2(0.0f, 0.0f);
+		return false;
+	}
+
+	time_of_impact = entry;
+	return true;
+}
+
+/**
+ * \brief Swept AABBCheck for bodies that opted in with RigidBody::isContinuous.
+ * Tests the move both bodies will make over the next delta_time seconds (call it before they are integrated),
+ * so a fast projectile hits thin objects at any step size. Falls back to a static overlap of the same boxes when neither body is continuous.
+ */
+bool CollisionManager::SweptAABBCheck(GameObject* object1, GameObject* object2, const float delta_time, float& time_of_impact)
+{
+	time_of_impact = 0.0f;
+	if (!object1->GetRigidBody()->isContinuous && !object2->GetRigidBody()->isContinuous)
+	{
+		return ComputeAABB(object1).Overlaps(ComputeAABB(object2));
+	}
+
+	// move object1 relative to object2 so only one box has to be swept
+	const auto displacement = (object1->GetRigidBody()->velocity - object2->GetRigidBody()->velocity) * delta_time;
+
+	glm::vec2 normal;
+	return SweptAABB(ComputeAABB(object1), displacement, ComputeAABB(object2), time_of_impact, normal);
+}
+
+AABB CollisionManager::ComputeAABB(GameObject* object)
+{
+	// encloses the rotated box, the same as FromPosition when the object is not rotated
+	return object->GetOBB().bounds;
+}
+
+/**
+ * \brief Runs a narrow phase check (AABBCheck, SquaredRadiusCheck, CircleAABBCheck...) on the pairs
+ * whose boxes overlap in the tree instead of on every pair of objects. Colliding pairs are reported
+ * to the CollisionEventQueue as contacts of the given shape.
+ * \return the number of pairs the narrow phase reported as colliding
+ */
+int CollisionManager::CheckCandidatePairs(const AABBTree& tree, bool (*narrow_phase)(GameObject*, GameObject*), const CollisionShape shape)
+{
+	static std::vector<std::pair<int, int>> pairs;
+	pairs.clear();
+	tree.ComputeOverlappingPairs(pairs);
+
+	auto collision_count = 0;
+	for (const auto& [proxy1, proxy2] : pairs)
+	{
+		const auto object1 = tree.GetUserData(proxy1);
+		const auto object2 = tree.GetUserData(proxy2);
+		if (object1 != nullptr && object2 != nullptr && CollisionFilter::ShouldTest(object1, object2) && narrow_phase(object1, object2))
 		{
-			bot_right.x = point.x;
+			CollisionEventQueue::Instance().AddContact(object1, object2, shape);
+			++collision_count;
 		}
+	}
+
+	return collision_count;
+}
+
+void CollisionManager::AddDefaultResponses()
+{
+	auto& queue = CollisionEventQueue::Instance();
+	queue.AddHandler(GameObjectType::TARGET, OnTargetCollision);
+	queue.AddHandler(GameObjectType::OBSTACLE, OnObstacleCollision);
+	queue.AddHandler(GameObjectType::SHIP, OnShipCollision);
+	queue.AddHandler(GameObjectType::AGENT, OnAgentCollision);
+}
+
+void CollisionManager::OnTargetCollision(const CollisionEvent& event)
+{
+	if (event.type == CollisionEventType::ENTER)
+	{
+		std::cout << "Collision with Target!" << std::endl;
+		SoundManager::Instance().PlaySound("yay", 0);
+	}
+}
 
-		if (bot_right.y < point.y)
+void CollisionManager::OnObstacleCollision(const CollisionEvent& event)
+{
+	if (event.type == CollisionEventType::ENTER)
+	{
+		std::cout << "Collision with Obstacle!" << std::endl;
+		SoundManager::Instance().PlaySound("yay", 0);
+	}
+}
+
+/**
+ * \brief A circle hitting a ship bounces off the side it came from
+ */
+void CollisionManager::OnShipCollision(const CollisionEvent& event)
+{
+	if (event.type != CollisionEventType::ENTER || event.shape != CollisionShape::CIRCLE)
+	{
+		return;
+	}
+
+	SoundManager::Instance().PlaySound("thunder", 0);
+
+	const auto object1 = event.object1;
+	const auto attack_vector = object1->GetTransform()->position - event.object2->GetTransform()->position;
+	constexpr auto normal = glm::vec2(0.0f, -1.0f);
+
+	const auto dot = Util::Dot(attack_vector, normal);
+	const auto angle = acos(dot / Util::Magnitude(attack_vector)) * Util::Rad2Deg;
+
+	const auto velocity_x = object1->GetRigidBody()->velocity.x;
+	const auto velocity_y = object1->GetRigidBody()->velocity.y;
+
+	if ((attack_vector.x > 0 && attack_vector.y < 0) || (attack_vector.x < 0 && attack_vector.y < 0))
+		// top right or top left
+	{
+		if (angle <= 45)
 		{
-			bot_right.y = point.y;
+			object1->GetRigidBody()->velocity = glm::vec2(velocity_x, -velocity_y);
+		}
+		else
+		{
+			object1->GetRigidBody()->velocity = glm::vec2(-velocity_x, velocity_y);
 		}
 	}
 
-	// compute new width and height values for object1
-	object1->SetWidth(static_cast<int>(bot_right.x - top_left.x));
-	object1->SetHeight(static_cast<int>(bot_right.y - top_left.y));
+	if ((attack_vector.x > 0 && attack_vector.y > 0) || (attack_vector.x < 0 && attack_vector.y > 0))
+		// bottom right or bottom left
+	{
+		if (angle <= 135)
+		{
+			object1->GetRigidBody()->velocity = glm::vec2(-velocity_x, velocity_y);
+		}
+		else
+		{
+			object1->GetRigidBody()->velocity = glm::vec2(velocity_x, -velocity_y);
+		}
+	}
 }
 
+void CollisionManager::OnAgentCollision(const CollisionEvent& event)
+{
+	if (event.type == CollisionEventType::ENTER)
+	{
+		SoundManager::Instance().PlaySound("yay", 0);
+	}
+}
 
 CollisionManager::CollisionManager()
 = default;
@@ -9,7 +9,12 @@
 #include "Ship.h"
 #include <glm/gtx/norm.hpp>
 #include "SoundManager.h"
+#include "AABBTree.h"
+#include "CollisionEvent.h"
 
+/* Collision detection functions are pure - they only report whether two objects overlap.
+ * Contacts go to the CollisionEventQueue, which calls the responses below once per frame.
+ */
 class CollisionManager
 {
 public:
@@ -33,7 +38,37 @@ public:
 
 	static bool LOSCheck(Agent* agent, glm::vec2 end_point, const std::vector<DisplayObject*>& objects, DisplayObject* target);
 
-	static void RotateAABB(GameObject* object1, float angle);
+	// line of sight through an AABBTree holding the obstacles - only the tree nodes along the line are visited
+	struct LOSRequest
+	{
+		Agent* agent;
+		glm::vec2 end_point;
+		DisplayObject* target;
+	};
+	static bool LOSCheck(const AABBTree& obstacles, Agent* agent, glm::vec2 end_point, DisplayObject* target);
+	// results[i] is the line of sight of requests[i]
+	static void LOSCheck(const AABBTree& obstacles, const std::vector<LOSRequest>& requests, std::vector<bool>& results);
+	// times LOSCheck over an object list against the tree version for a few hundred agents
+	static void LOSBenchmark(int agent_count = 500, int obstacle_count = 200);
+
+	// separating axis test on the cached oriented boxes, after a cheap AABB reject
+	static bool OBBCheck(GameObject* object1, GameObject* object2);
+
+	// continuous collision
+	static bool SweptAABB(const AABB& moving, glm::vec2 displacement, const AABB& target, float& time_of_impact, glm::vec2& normal);
+	static bool SweptAABBCheck(GameObject* object1, GameObject* object2, float delta_time, float& time_of_impact);
+
+	// broadphase
+	static AABB ComputeAABB(GameObject* object);
+	static int CheckCandidatePairs(const AABBTree& tree, bool (*narrow_phase)(GameObject*, GameObject*),
+		CollisionShape shape = CollisionShape::RECTANGLE);
+
+	// collision responses, dispatched by the type of object2
+	static void AddDefaultResponses();
+	static void OnTargetCollision(const CollisionEvent& event);
+	static void OnObstacleCollision(const CollisionEvent& event);
+	static void OnShipCollision(const CollisionEvent& event);
+	static void OnAgentCollision(const CollisionEvent& event);
 
 private:
 	CollisionManager();
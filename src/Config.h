@@ -18,6 +18,9 @@ public:
 	static constexpr int SCORE = 0;
 	static constexpr int LIVES = 5;
 
+	// display list layer used for menus, buttons and labels
+	static constexpr uint32_t UI_LAYER = 1;
+
 	// Define Custom Deleters for shared_ptr types
 	static void SDL_DelRes(SDL_Window* r) { SDL_DestroyWindow(r); }
 	static void SDL_DelRes(SDL_Renderer* r) { SDL_DestroyRenderer(r); }
@@ -0,0 +1,190 @@
+#include "DebugDraw.h"
+#include <cmath>
+#include "Renderer.h"
+#include "Util.h"
+
+DebugDraw::DebugDraw()
+= default;
+
+DebugDraw::~DebugDraw()
+= default;
+
+#ifdef DEBUG_DRAW_ENABLED
+
+DebugDraw::ColourBatch& DebugDraw::GetBatch(const glm::vec4 colour)
+{
+	const auto sdl_colour = Util::ToSDLColour(colour);
+	const Uint32 key = (static_cast<Uint32>(sdl_colour.r) << 24) | (static_cast<Uint32>(sdl_colour.g) << 16) |
+		(static_cast<Uint32>(sdl_colour.b) << 8) | static_cast<Uint32>(sdl_colour.a);
+
+	auto& batch = m_batches[key];
+	batch.colour = sdl_colour;
+	return batch;
+}
+
+void DebugDraw::AddStrip(const SDL_FPoint* points, const int count, const glm::vec4 colour)
+{
+	const auto sdl_colour = Util::ToSDLColour(colour);
+	for (auto i = 1; i < count; ++i)
+	{
+		// centred on the pixel centres, as SDL's own lines are
+		const SDL_FPoint start = { points[i - 1].x + 0.5f, points[i - 1].y + 0.5f };
+		const SDL_FPoint end = { points[i].x + 0.5f, points[i].y + 0.5f };
+
+		// half a pixel either side of the segment, along the axis for a zero length one so it still covers its pixel
+		auto dx = end.x - start.x;
+		auto dy = end.y - start.y;
+		const auto length = std::sqrt(dx * dx + dy * dy);
+		dx = (length > 0.0f) ? dx / length * 0.5f : 0.5f;
+		dy = (length > 0.0f) ? dy / length * 0.5f : 0.0f;
+
+		// the ends are pushed out by half a pixel too, so joined segments leave no gap at the corners
+		const auto base = static_cast<int>(m_lineVertices.size());
+		m_lineVertices.push_back({ { start.x - dx + dy, start.y - dy - dx }, sdl_colour, { 0.0f, 0.0f } });
+		m_lineVertices.push_back({ { end.x + dx + dy, end.y + dy - dx }, sdl_colour, { 0.0f, 0.0f } });
+		m_lineVertices.push_back({ { end.x + dx - dy, end.y + dy + dx }, sdl_colour, { 0.0f, 0.0f } });
+		m_lineVertices.push_back({ { start.x - dx - dy, start.y - dy + dx }, sdl_colour, { 0.0f, 0.0f } });
+
+		const int quad_indices[6] = { 0, 1, 2, 0, 2, 3 };
+		for (const auto index : quad_indices)
+		{
+			m_lineIndices.push_back(base + index);
+		}
+	}
+}
+
+void DebugDraw::AddPoint(const glm::vec2 point, const glm::vec4 colour)
+{
+	GetBatch(colour).points.push_back({ point.x, point.y });
+}
+
+void DebugDraw::AddLine(const glm::vec2 start, const glm::vec2 end, const glm::vec4 colour)
+{
+	const SDL_FPoint points[2] = { { start.x, start.y }, { end.x, end.y } };
+	AddStrip(points, 2, colour);
+}
+
+void DebugDraw::AddRect(const glm::vec2 position, const int width, const int height, const glm::vec4 colour)
+{
+	const auto w = static_cast<float>(width);
+	const auto h = static_cast<float>(height);
+
+	// closed outline as a single strip (TL, TR, BR, BL, TL)
+	const SDL_FPoint points[5] = {
+		{ position.x, position.y },
+		{ position.x + w, position.y },
+		{ position.x + w, position.y + h },
+		{ position.x, position.y + h },
+		{ position.x, position.y } };
+	AddStrip(points, 5, colour);
+}
+
+void DebugDraw::AddFilledRect(const glm::vec2 position, const int width, const int height, const glm::vec4 fill_colour)
+{
+	const auto colour = Util::ToSDLColour(fill_colour);
+	const auto w = static_cast<float>(width);
+	const auto h = static_cast<float>(height);
+	const auto base = static_cast<int>(m_vertices.size());
+
+	m_vertices.push_back({ { position.x, position.y }, colour, { 0.0f, 0.0f } });
+	m_vertices.push_back({ { position.x + w, position.y }, colour, { 0.0f, 0.0f } });
+	m_vertices.push_back({ { position.x + w, position.y + h }, colour, { 0.0f, 0.0f } });
+	m_vertices.push_back({ { position.x, position.y + h }, colour, { 0.0f, 0.0f } });
+
+	const int quad_indices[6] = { 0, 1, 2, 0, 2, 3 };
+	for (const auto index : quad_indices)
+	{
+		m_indices.push_back(base + index);
+	}
+}
+
+void DebugDraw::AddCircle(const glm::vec2 centre, const float radius, const glm::vec4 colour, const ShapeType type)
+{
+	Util::ComputeCirclePoints(GetBatch(colour).points, centre, radius, type);
+}
+
+void DebugDraw::AddCapsule(const glm::vec2 position, const int width, const int height, const glm::vec4 colour)
+{
+	const float half_width = floor(static_cast<float>(width) * 0.5f);
+	const float half_height = floor(static_cast<float>(height) * 0.5f);
+	if (width > height)
+	{
+		// Horizontal Capsule
+		AddCircle(glm::vec2(position.x - half_width + half_height, position.y), half_height, colour, ShapeType::SEMI_CIRCLE_LEFT);
+		AddCircle(glm::vec2(position.x + half_width - half_height, position.y), half_height, colour, ShapeType::SEMI_CIRCLE_RIGHT);
+		AddLine(glm::vec2(position.x - half_width + half_height, position.y - half_height), glm::vec2(position.x + half_width - half_height, position.y - half_height), colour);
+		AddLine(glm::vec2(position.x - half_width + half_height, position.y + half_height), glm::vec2(position.x + half_width - half_height, position.y + half_height), colour);
+	}
+	else if (width < height)
+	{
+		// Vertical Capsule
+		const float radius = half_width * 0.5f;
+		AddCircle(glm::vec2(position.x, position.y - half_height + radius), radius, colour, ShapeType::SEMI_CIRCLE_TOP);
+		AddCircle(glm::vec2(position.x, position.y + half_height - radius), radius, colour, ShapeType::SEMI_CIRCLE_BOTTOM);
+		AddLine(glm::vec2(position.x - radius, position.y - half_height + radius), glm::vec2(position.x - half_width * 0.5f, position.y + half_height * 0.5f), colour);
+		AddLine(glm::vec2(position.x + radius, position.y - half_height + radius), glm::vec2(position.x + half_width * 0.5f, position.y + half_height * 0.5f), colour);
+	}
+	else
+	{
+		// Circle
+		AddCircle(position, half_width, colour, ShapeType::SYMMETRICAL);
+	}
+}
+
+void DebugDraw::Flush(SDL_Renderer* renderer)
+{
+	m_lastDrawCallCount = 0;
+
+	// filled shapes first so outlines and points stay visible on top of them
+	if (!m_indices.empty())
+	{
+		Renderer::Instance().DrawGeometry(nullptr, m_vertices.data(), static_cast<int>(m_vertices.size()),
+			m_indices.data(), static_cast<int>(m_indices.size()), renderer);
+		++m_lastDrawCallCount;
+	}
+
+	// every line of every colour, connected or not
+	if (!m_lineIndices.empty())
+	{
+		Renderer::Instance().DrawGeometry(nullptr, m_lineVertices.data(), static_cast<int>(m_lineVertices.size()),
+			m_lineIndices.data(), static_cast<int>(m_lineIndices.size()), renderer);
+		++m_lastDrawCallCount;
+	}
+
+	for (auto& [key, batch] : m_batches)
+	{
+		if (batch.points.empty())
+		{
+			continue;
+		}
+
+		Renderer::Instance().SetDrawColour(batch.colour.r, batch.colour.g, batch.colour.b, batch.colour.a, renderer);
+		Renderer::Instance().DrawPoints(batch.points.data(), static_cast<int>(batch.points.size()), renderer);
+		++m_lastDrawCallCount;
+	}
+
+	Renderer::Instance().SetDrawColour(255, 255, 255, 255, renderer);
+
+	Clear();
+}
+
+void DebugDraw::Clear()
+{
+	// keep the batches and their capacity around, the same colours tend to be used every frame
+	for (auto& [key, batch] : m_batches)
+	{
+		batch.points.clear();
+	}
+
+	m_vertices.clear();
+	m_indices.clear();
+	m_lineVertices.clear();
+	m_lineIndices.clear();
+}
+
+int DebugDraw::GetLastDrawCallCount() const
+{
+	return m_lastDrawCallCount;
+}
+
+#endif /* defined (DEBUG_DRAW_ENABLED) */
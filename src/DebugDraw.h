@@ -0,0 +1,93 @@
+#pragma once
+#ifndef __DEBUG_DRAW__
+#define __DEBUG_DRAW__
+
+// Core Libraries
+#include <unordered_map>
+#include <vector>
+
+#include "GLM/vec2.hpp"
+#include "GLM/vec4.hpp"
+#include <SDL.h>
+
+#include "ShapeType.h"
+
+// Debug drawing is compiled in for Debug builds only.
+// Define DEBUG_DRAW_DISABLED to strip it from Debug builds as well.
+#if defined(_DEBUG) && !defined(DEBUG_DRAW_DISABLED)
+#define DEBUG_DRAW_ENABLED
+#endif
+
+/* Singleton
+ * Accumulates debug primitives during the frame and submits them with a handful of batched
+ * SDL calls when Flush is called (once per frame): filled shapes and every line segment go out
+ * as one SDL_RenderGeometry call each, points as one call per colour.
+ * In release builds every function is an empty inline so call sites compile away - anything
+ * the game needs to show in release must not be drawn through here.
+ */
+class DebugDraw
+{
+public:
+	static DebugDraw& Instance()
+	{
+		static DebugDraw instance;
+		return instance;
+	}
+
+#ifdef DEBUG_DRAW_ENABLED
+	void AddPoint(glm::vec2 point, glm::vec4 colour = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+	void AddLine(glm::vec2 start, glm::vec2 end, glm::vec4 colour = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+	void AddRect(glm::vec2 position, int width, int height, glm::vec4 colour = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+	void AddFilledRect(glm::vec2 position, int width, int height, glm::vec4 fill_colour = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+	void AddCircle(glm::vec2 centre, float radius, glm::vec4 colour = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f), ShapeType type = ShapeType::SYMMETRICAL);
+	void AddCapsule(glm::vec2 position, int width, int height, glm::vec4 colour = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+
+	// submits everything accumulated this frame and empties the buffer
+	void Flush(SDL_Renderer* renderer);
+	void Clear();
+
+	// number of SDL draw calls issued by the last Flush
+	[[nodiscard]] int GetLastDrawCallCount() const;
+#else
+	void AddPoint(glm::vec2, glm::vec4 = {}) {}
+	void AddLine(glm::vec2, glm::vec2, glm::vec4 = {}) {}
+	void AddRect(glm::vec2, int, int, glm::vec4 = {}) {}
+	void AddFilledRect(glm::vec2, int, int, glm::vec4 = {}) {}
+	void AddCircle(glm::vec2, float, glm::vec4 = {}, ShapeType = ShapeType::SYMMETRICAL) {}
+	void AddCapsule(glm::vec2, int, int, glm::vec4 = {}) {}
+
+	void Flush(SDL_Renderer*) {}
+	void Clear() {}
+
+	[[nodiscard]] int GetLastDrawCallCount() const { return 0; }
+#endif
+
+private:
+	DebugDraw();
+	~DebugDraw();
+
+#ifdef DEBUG_DRAW_ENABLED
+	struct ColourBatch
+	{
+		SDL_Color colour{};
+		std::vector<SDL_FPoint> points;
+	};
+
+	ColourBatch& GetBatch(glm::vec4 colour);
+	// every segment of the strip becomes a one pixel wide quad
+	void AddStrip(const SDL_FPoint* points, int count, glm::vec4 colour);
+
+	// point batches keyed by packed RGBA
+	std::unordered_map<Uint32, ColourBatch> m_batches;
+
+	// filled shapes and lines carry their colour per vertex so each goes out in a single SDL_RenderGeometry call
+	std::vector<SDL_Vertex> m_vertices;
+	std::vector<int> m_indices;
+	std::vector<SDL_Vertex> m_lineVertices;
+	std::vector<int> m_lineIndices;
+
+	int m_lastDrawCallCount = 0;
+#endif
+};
+
+#endif /* defined (__DEBUG_DRAW__) */
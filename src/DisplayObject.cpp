@@ -27,6 +27,21 @@ uint32_t DisplayObject::GetLayerOrderIndex() const
 
 void DisplayObject::SetLayerIndex(const uint32_t new_index, const uint32_t new_order)
 {
+	InvalidateLayerCache();
 	m_layerIndex = new_index;
 	m_layerOrderIndex = new_order;
+	InvalidateLayerCache();
+}
+
+void DisplayObject::InvalidateLayerCache() const
+{
+	if (m_pParentScene != nullptr)
+	{
+		m_pParentScene->InvalidateLayer(m_layerIndex);
+	}
+}
+
+Animator* DisplayObject::GetAnimator()
+{
+	return nullptr;
 }
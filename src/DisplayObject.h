@@ -5,6 +5,8 @@
 #include "GameObject.h"
 #include "Scene.h"
 
+class Animator;
+
 class DisplayObject : public GameObject
 {
 public:
@@ -34,7 +36,18 @@ public:
 	 * @param new_order The order within the layer, default is zero
 	 */
 	void SetLayerIndex(uint32_t new_index, const uint32_t new_order = 0);
-	
+
+	/*
+	 * Notifies the parent scene that this object looks different (alpha, text, colour...)
+	 * so a static layer holding it gets re-composited
+	 */
+	void InvalidateLayerCache() const;
+
+	/*
+	 * Returns the animator component of this object, or nullptr if it is not animated
+	 */
+	virtual Animator* GetAnimator();
+
 
 private:
 	friend class Scene;
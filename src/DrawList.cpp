@@ -0,0 +1,157 @@
+#include "DrawList.h"
+
+DrawList::DrawList() :
+	m_submitTime(0)
+{
+}
+
+DrawList::~DrawList()
+= default;
+
+void DrawList::SetDrawColour(const SDL_Color colour)
+{
+	Command command{ CommandType::DRAW_COLOUR };
+	command.colour = colour;
+	m_commands.push_back(command);
+}
+
+void DrawList::Clear()
+{
+	m_commands.push_back({ CommandType::CLEAR });
+}
+
+void DrawList::Copy(SDL_Texture* texture, const SDL_Rect* src_rect, const SDL_Rect* dest_rect, const double angle,
+	const SDL_RendererFlip flip, const Uint8 alpha)
+{
+	Command command{ CommandType::COPY };
+	command.texture = texture;
+	command.colour.a = alpha;
+	command.angle = angle;
+	command.flip = flip;
+
+	if (src_rect != nullptr)
+	{
+		command.src_rect = *src_rect;
+		command.has_src_rect = true;
+	}
+	if (dest_rect != nullptr)
+	{
+		command.dest_rect = *dest_rect;
+		command.has_dest_rect = true;
+	}
+
+	m_commands.push_back(command);
+}
+
+void DrawList::DrawGeometry(SDL_Texture* texture, const SDL_Vertex* vertices, const int vertex_count, const int* indices, const int index_count)
+{
+	Command command{ CommandType::GEOMETRY };
+	command.texture = texture;
+	command.first = static_cast<int>(m_vertices.size());
+	command.count = vertex_count;
+	command.first_index = static_cast<int>(m_indices.size());
+	command.index_count = (indices != nullptr) ? index_count : 0;
+
+	m_vertices.insert(m_vertices.end(), vertices, vertices + vertex_count);
+	if (indices != nullptr)
+	{
+		m_indices.insert(m_indices.end(), indices, indices + index_count);
+	}
+
+	m_commands.push_back(command);
+}
+
+void DrawList::DrawLines(const SDL_FPoint* points, const int count)
+{
+	Command command{ CommandType::LINES };
+	command.first = static_cast<int>(m_points.size());
+	command.count = count;
+	m_points.insert(m_points.end(), points, points + count);
+	m_commands.push_back(command);
+}
+
+void DrawList::DrawPoints(const SDL_FPoint* points, const int count)
+{
+	Command command{ CommandType::POINTS };
+	command.first = static_cast<int>(m_points.size());
+	command.count = count;
+	m_points.insert(m_points.end(), points, points + count);
+	m_commands.push_back(command);
+}
+
+void DrawList::DrawRect(const SDL_FRect& rect)
+{
+	Command command{ CommandType::RECT };
+	command.rect = rect;
+	m_commands.push_back(command);
+}
+
+void DrawList::FillRect(const SDL_FRect& rect)
+{
+	Command command{ CommandType::FILL_RECT };
+	command.rect = rect;
+	m_commands.push_back(command);
+}
+
+void DrawList::Playback(SDL_Renderer* renderer) const
+{
+	for (const auto& command : m_commands)
+	{
+		switch (command.type)
+		{
+		case CommandType::DRAW_COLOUR:
+			SDL_SetRenderDrawColor(renderer, command.colour.r, command.colour.g, command.colour.b, command.colour.a);
+			break;
+		case CommandType::CLEAR:
+			SDL_RenderClear(renderer);
+			break;
+		case CommandType::COPY:
+			SDL_SetTextureAlphaMod(command.texture, command.colour.a);
+			SDL_RenderCopyEx(renderer, command.texture,
+				command.has_src_rect ? &command.src_rect : nullptr,
+				command.has_dest_rect ? &command.dest_rect : nullptr,
+				command.angle, nullptr, command.flip);
+			break;
+		case CommandType::GEOMETRY:
+			SDL_RenderGeometry(renderer, command.texture, m_vertices.data() + command.first, command.count,
+				(command.index_count > 0) ? m_indices.data() + command.first_index : nullptr, command.index_count);
+			break;
+		case CommandType::LINES:
+			SDL_RenderDrawLinesF(renderer, m_points.data() + command.first, command.count);
+			break;
+		case CommandType::POINTS:
+			SDL_RenderDrawPointsF(renderer, m_points.data() + command.first, command.count);
+			break;
+		case CommandType::RECT:
+			SDL_RenderDrawRectF(renderer, &command.rect);
+			break;
+		case CommandType::FILL_RECT:
+			SDL_RenderFillRectF(renderer, &command.rect);
+			break;
+		}
+	}
+}
+
+void DrawList::Reset()
+{
+	m_commands.clear();
+	m_vertices.clear();
+	m_indices.clear();
+	m_points.clear();
+	m_submitTime = 0;
+}
+
+int DrawList::GetCommandCount() const
+{
+	return static_cast<int>(m_commands.size());
+}
+
+Uint64 DrawList::GetSubmitTime() const
+{
+	return m_submitTime;
+}
+
+void DrawList::SetSubmitTime(const Uint64 performance_counter)
+{
+	m_submitTime = performance_counter;
+}
@@ -0,0 +1,82 @@
+#pragma once
+#ifndef __DRAW_LIST__
+#define __DRAW_LIST__
+
+#include <vector>
+#include <SDL.h>
+
+/**
+ * \brief A frame's worth of recorded draw calls for the main renderer.
+ * The main thread records a DrawList while the scene draws; once submitted it is
+ * immutable until the render thread has played it back (see RenderThread).
+ * Vertex, index and point data are copied into the list, textures are referenced.
+ */
+class DrawList
+{
+public:
+	DrawList();
+	~DrawList();
+
+	// recording
+	void SetDrawColour(SDL_Color colour);
+	void Clear();
+	void Copy(SDL_Texture* texture, const SDL_Rect* src_rect, const SDL_Rect* dest_rect, double angle, SDL_RendererFlip flip, Uint8 alpha);
+	void DrawGeometry(SDL_Texture* texture, const SDL_Vertex* vertices, int vertex_count, const int* indices, int index_count);
+	void DrawLines(const SDL_FPoint* points, int count);
+	void DrawPoints(const SDL_FPoint* points, int count);
+	void DrawRect(const SDL_FRect& rect);
+	void FillRect(const SDL_FRect& rect);
+
+	// issues every recorded call on renderer, in order
+	void Playback(SDL_Renderer* renderer) const;
+	// empties the list but keeps its capacity for the next frame
+	void Reset();
+
+	// getters
+	[[nodiscard]] int GetCommandCount() const;
+	[[nodiscard]] Uint64 GetSubmitTime() const;
+
+	// setters
+	void SetSubmitTime(Uint64 performance_counter);
+
+private:
+	enum class CommandType
+	{
+		DRAW_COLOUR,
+		CLEAR,
+		COPY,
+		GEOMETRY,
+		LINES,
+		POINTS,
+		RECT,
+		FILL_RECT
+	};
+
+	struct Command
+	{
+		CommandType type;
+		SDL_Texture* texture = nullptr;
+		SDL_Color colour{};
+		SDL_Rect src_rect{};
+		SDL_Rect dest_rect{};
+		SDL_FRect rect{};
+		bool has_src_rect = false;
+		bool has_dest_rect = false;
+		double angle = 0.0;
+		SDL_RendererFlip flip = SDL_FLIP_NONE;
+		// ranges into the shared data arrays
+		int first = 0;
+		int count = 0;
+		int first_index = 0;
+		int index_count = 0;
+	};
+
+	std::vector<Command> m_commands;
+	std::vector<SDL_Vertex> m_vertices;
+	std::vector<int> m_indices;
+	std::vector<SDL_FPoint> m_points;
+
+	Uint64 m_submitTime;
+};
+
+#endif /* defined (__DRAW_LIST__) */
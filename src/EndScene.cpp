@@ -51,7 +51,7 @@ void EndScene::Start()
 	const SDL_Color blue = { 0, 0, 255, 255 };
 	m_label = new Label("END SCENE", "Dock51", 80, blue, glm::vec2(400.0f, 40.0f));
 	m_label->SetParent(this);
-	AddChild(m_label);
+	AddChild(m_label, Config::UI_LAYER);
 
 	// Restart Button
 	m_pRestartButton = new Button("../Assets/textures/restartButton.png", "restartButton", GameObjectType::RESTART_BUTTON);
@@ -72,7 +72,10 @@ void EndScene::Start()
 		m_pRestartButton->SetAlpha(255);
 	});
 
-	AddChild(m_pRestartButton);
+	AddChild(m_pRestartButton, Config::UI_LAYER);
+
+	// menus only change on hover, composite them once and reuse the result
+	SetLayerStatic(Config::UI_LAYER);
 
 	ImGuiWindowFrame::Instance().SetDefaultGuiFunction();
 }
@@ -48,6 +48,10 @@ void EventManager::Update()
                 {
                     OnMouseButtonDown(event);
                 }
+                else
+                {
+                    AddIMGUIMouseButtonEvent(event);
+                }
                 break;
 
             case SDL_MOUSEBUTTONUP:
@@ -55,10 +59,18 @@ void EventManager::Update()
                 {
                     OnMouseButtonUp(event);
                 }
+                else
+                {
+                    AddIMGUIMouseButtonEvent(event);
+                }
                 break;
 
             case SDL_MOUSEWHEEL:
                 m_mouseWheel = event.wheel.y;
+                if (IsIMGUIReceivingInput())
+                {
+                    m_io.AddMouseWheelEvent(static_cast<float>(event.wheel.x), static_cast<float>(event.wheel.y));
+                }
                 break;
 
             case SDL_TEXTINPUT:
@@ -133,6 +145,9 @@ void EventManager::Update()
 
                     m_mainWindowHasFocus = (ImGuiWindowFrame::Instance().GetWindowId() == event.window.windowID) ? false : true;
 
+                    // losing focus releases every button ImGui thinks is held
+                    m_io.AddFocusEvent(!m_mainWindowHasFocus);
+
                     break;
 
 	            case SDL_WINDOWEVENT_ENTER:
@@ -151,16 +166,14 @@ void EventManager::Update()
         SDL_Point mouse_pos = { static_cast<int>(m_mousePosition.x), static_cast<int>(m_mousePosition.y) };
         m_mouseCurrent = SDL_GetMouseState(&mouse_pos.x, &mouse_pos.y);
 
-        m_io.DeltaTime = 1.0f / 60.0f;
+        // the ImGui frame runs at its own rate (and sets its own DeltaTime), so mouse input is queued as events
+        // rather than written as state - a click or wheel tick between two ImGui frames still reaches it
         int mouse_x;
         int mouse_y;
-        const int buttons = static_cast<int>(SDL_GetMouseState(&mouse_x, &mouse_y));
-        if(!m_mainWindowHasFocus)
+        SDL_GetMouseState(&mouse_x, &mouse_y);
+        if (IsIMGUIReceivingInput())
         {
-            m_io.MousePos = ImVec2(static_cast<float>(mouse_x), static_cast<float>(mouse_y));
-            m_io.MouseDown[0] = buttons & SDL_BUTTON(SDL_BUTTON_LEFT);
-            m_io.MouseDown[1] = buttons & SDL_BUTTON(SDL_BUTTON_RIGHT);
-            m_io.MouseWheel = static_cast<float>(m_mouseWheel);
+            m_io.AddMousePosEvent(static_cast<float>(mouse_x), static_cast<float>(mouse_y));
 
             m_io.DisplaySize.x = Config::SCREEN_WIDTH;
             m_io.DisplaySize.y = Config::SCREEN_HEIGHT;
@@ -262,6 +275,32 @@ void EventManager::OnMouseButtonUp(const SDL_Event& event)
     }
 }
 
+bool EventManager::IsIMGUIReceivingInput() const
+{
+    // events queue up until the next ImGui frame, which never comes while the window is hidden
+    return !m_mainWindowHasFocus && ImGuiWindowFrame::Instance().IsVisible();
+}
+
+void EventManager::AddIMGUIMouseButtonEvent(const SDL_Event& event)
+{
+    if (!IsIMGUIReceivingInput())
+    {
+        return;
+    }
+
+    switch (event.button.button)
+    {
+    case SDL_BUTTON_LEFT:
+        m_io.AddMouseButtonEvent(ImGuiMouseButton_Left, event.type == SDL_MOUSEBUTTONDOWN);
+        break;
+    case SDL_BUTTON_RIGHT:
+        m_io.AddMouseButtonEvent(ImGuiMouseButton_Right, event.type == SDL_MOUSEBUTTONDOWN);
+        break;
+    default:
+        break;
+    }
+}
+
 void EventManager::OnMouseWheel(const SDL_Event& event)
 {
     m_mouseWheel = event.wheel.y;
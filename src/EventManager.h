@@ -74,6 +74,8 @@ private:
 
 	// IMGUI IO
 	void IMGUIKeymap() const;
+	[[nodiscard]] bool IsIMGUIReceivingInput() const;
+	void AddIMGUIMouseButtonEvent(const SDL_Event& event);
 
 	/*------- PRIVATE MEMBER VARIABLES -------*/
 
@@ -0,0 +1,493 @@
+#include "FlowField.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <SDL.h>
+#include "PathFinder.h"
+
+namespace
+{
+	// same order as the PathFinder: E, S, W, N, SE, SW, NW, NE
+	constexpr int OFFSET_X[8] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	constexpr int OFFSET_Y[8] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+	constexpr std::uint32_t STEP_COST[8] = { 10, 10, 10, 10, 14, 14, 14, 14 };
+
+	constexpr float DIAGONAL = 0.70710678f;
+	const glm::vec2 DIRECTION_VECTORS[FlowField::NO_DIRECTION + 1] = {
+		glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, 1.0f), glm::vec2(-1.0f, 0.0f), glm::vec2(0.0f, -1.0f),
+		glm::vec2(DIAGONAL, DIAGONAL), glm::vec2(-DIAGONAL, DIAGONAL), glm::vec2(-DIAGONAL, -DIAGONAL), glm::vec2(DIAGONAL, -DIAGONAL),
+		glm::vec2(0.0f, 0.0f) };
+
+	// a change to more tiles than this is cheaper to rebuild than to repair
+	constexpr int MAX_REPAIR_FRACTION = 8;
+	constexpr int COMPARE_BLOCK_SIZE = 256;
+
+	double ElapsedMilliseconds(const Uint64 start)
+	{
+		return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+	}
+
+	// random agent positions in pixels on walkable tiles
+	std::vector<glm::vec2> RandomPositions(const TileGrid& grid, const int count, std::mt19937& generator)
+	{
+		std::uniform_real_distribution<float> x(0.0f, static_cast<float>(grid.GetCols() * Config::TILE_SIZE));
+		std::uniform_real_distribution<float> y(0.0f, static_cast<float>(grid.GetRows() * Config::TILE_SIZE));
+		std::vector<glm::vec2> positions;
+		while (static_cast<int>(positions.size()) < count)
+		{
+			const glm::vec2 position(x(generator), y(generator));
+			const auto tile = TileGrid::WorldToTile(position);
+			if (grid.IsWalkable(tile.x, tile.y))
+			{
+				positions.push_back(position);
+			}
+		}
+		return positions;
+	}
+
+	int Opposite(const int direction)
+	{
+		return direction < 4 ? (direction + 2) % 4 : 4 + (direction - 4 + 2) % 4;
+	}
+}
+
+FlowField::FlowField() : m_pGrid(nullptr), m_gridVersion(0), m_cols(0), m_rows(0), m_target(-1, -1), m_lastUpdateTileCount(0)
+{
+}
+
+FlowField::~FlowField()
+= default;
+
+void FlowField::Build(const TileGrid& grid, const glm::ivec2 target)
+{
+	m_pGrid = &grid;
+	m_gridVersion = grid.GetVersion();
+	m_cols = grid.GetCols();
+	m_rows = grid.GetRows();
+	m_target = target;
+
+	const auto tile_count = grid.GetTileCount();
+	m_costs.assign(grid.GetCosts(), grid.GetCosts() + tile_count);
+	m_integration.assign(tile_count, UNREACHABLE);
+	m_directions.assign(tile_count, NO_DIRECTION);
+	m_dirtyFlags.assign(tile_count, 0);
+	m_open.clear();
+	m_lastUpdateTileCount = 0;
+
+	if (grid.IsWalkable(target.x, target.y))
+	{
+		Push(0, grid.GetIndex(target.x, target.y));
+		m_integration[grid.GetIndex(target.x, target.y)] = 0;
+		Propagate();
+	}
+}
+
+/**
+ * \brief Repairs the field after tile changes in three passes.
+ * 1. Tiles that got blocked or dearer invalidate every tile whose route went through them (or cut past a newly
+ *    blocked corner); the route is found by following the direction field backwards.
+ * 2. Invalidated tiles take the best value their valid neighbours offer.
+ * 3. Those tiles, plus the changed tiles and their neighbours (for tiles that got cheaper or opened a corner),
+ *    are relaxed outwards as in the build until nothing improves.
+ */
+bool FlowField::Update(const TileGrid& grid, const glm::ivec2 target)
+{
+	if (m_pGrid != &grid || m_cols != grid.GetCols() || m_rows != grid.GetRows() || m_target != target)
+	{
+		Build(grid, target);
+		return true;
+	}
+
+	if (m_gridVersion == grid.GetVersion())
+	{
+		return false;
+	}
+	m_gridVersion = grid.GetVersion();
+
+	// a target that is or was blocked leaves nothing worth repairing
+	const auto target_index = grid.GetIndex(target.x, target.y);
+	if (!grid.IsWalkable(target.x, target.y) || m_costs[target_index] == TileGrid::BLOCKED)
+	{
+		Build(grid, target);
+		return true;
+	}
+
+	const auto tile_count = grid.GetTileCount();
+	const auto costs = grid.GetCosts();
+
+	// the changes since the field was computed - whole blocks are compared first, most of them are equal
+	m_changed.clear();
+	for (auto block = 0; block < tile_count; block += COMPARE_BLOCK_SIZE)
+	{
+		const auto block_size = std::min(COMPARE_BLOCK_SIZE, tile_count - block);
+		if (std::memcmp(costs + block, m_costs.data() + block, block_size) == 0)
+		{
+			continue;
+		}
+
+		for (auto i = block; i < block + block_size; ++i)
+		{
+			if (costs[i] != m_costs[i])
+			{
+				m_changed.push_back(i);
+			}
+		}
+
+		if (static_cast<int>(m_changed.size()) > tile_count / MAX_REPAIR_FRACTION)
+		{
+			Build(grid, target);
+			return true;
+		}
+	}
+
+	m_improved.clear();
+	m_dirty.clear();
+	m_open.clear();
+	m_lastUpdateTileCount = 0;
+
+	// 1. invalidate
+	for (const auto index : m_changed)
+	{
+		const auto old_cost = m_costs[index];
+		const auto new_cost = costs[index];
+		m_costs[index] = new_cost;
+
+		const auto x = index % m_cols;
+		const auto y = index / m_cols;
+
+		if (new_cost == TileGrid::BLOCKED)
+		{
+			MarkDirty(index);
+
+			// diagonal moves past the new wall are no longer allowed
+			for (auto direction = 0; direction < 8; ++direction)
+			{
+				const auto nx = x + OFFSET_X[direction];
+				const auto ny = y + OFFSET_Y[direction];
+				if (!grid.IsInside(nx, ny))
+				{
+					continue;
+				}
+				const auto neighbour = grid.GetIndex(nx, ny);
+				const auto step = m_directions[neighbour];
+				if (step >= 4 && step != NO_DIRECTION &&
+					((nx + OFFSET_X[step] == x && ny == y) || (nx == x && ny + OFFSET_Y[step] == y)))
+				{
+					MarkDirty(neighbour);
+				}
+			}
+		}
+		else if (old_cost != TileGrid::BLOCKED && new_cost > old_cost)
+		{
+			// the tile keeps its own value, the tiles that step onto it do not
+			for (auto direction = 0; direction < 8; ++direction)
+			{
+				const auto nx = x + OFFSET_X[direction];
+				const auto ny = y + OFFSET_Y[direction];
+				if (grid.IsInside(nx, ny) && m_directions[grid.GetIndex(nx, ny)] == Opposite(direction))
+				{
+					MarkDirty(grid.GetIndex(nx, ny));
+				}
+			}
+		}
+		else
+		{
+			m_improved.push_back(index);
+		}
+	}
+
+	// everything downstream of an invalid tile is invalid too
+	for (size_t i = 0; i < m_dirty.size(); ++i)
+	{
+		const auto x = m_dirty[i] % m_cols;
+		const auto y = m_dirty[i] / m_cols;
+		for (auto direction = 0; direction < 8; ++direction)
+		{
+			const auto nx = x + OFFSET_X[direction];
+			const auto ny = y + OFFSET_Y[direction];
+			if (grid.IsInside(nx, ny) && m_directions[grid.GetIndex(nx, ny)] == Opposite(direction))
+			{
+				MarkDirty(grid.GetIndex(nx, ny));
+			}
+		}
+	}
+
+	for (const auto index : m_dirty)
+	{
+		m_integration[index] = UNREACHABLE;
+		m_directions[index] = NO_DIRECTION;
+	}
+
+	// 2. seed the invalid tiles from their valid neighbours
+	for (const auto index : m_dirty)
+	{
+		Seed(index);
+	}
+
+	// 3. tiles that opened up or got cheaper pull their neighbours down
+	for (const auto index : m_improved)
+	{
+		if (m_integration[index] == UNREACHABLE)
+		{
+			Seed(index);
+		}
+		const auto x = index % m_cols;
+		const auto y = index / m_cols;
+		for (auto direction = 0; direction < 8; ++direction)
+		{
+			const auto nx = x + OFFSET_X[direction];
+			const auto ny = y + OFFSET_Y[direction];
+			if (grid.IsInside(nx, ny) && m_integration[grid.GetIndex(nx, ny)] != UNREACHABLE)
+			{
+				Push(m_integration[grid.GetIndex(nx, ny)], grid.GetIndex(nx, ny));
+			}
+		}
+		if (m_integration[index] != UNREACHABLE)
+		{
+			Push(m_integration[index], index);
+		}
+	}
+
+	for (const auto index : m_dirty)
+	{
+		m_dirtyFlags[index] = 0;
+	}
+
+	Propagate();
+	return true;
+}
+
+glm::vec2 FlowField::GetDirection(const glm::vec2 position) const
+{
+	const auto tile = TileGrid::WorldToTile(position);
+	if (tile.x < 0 || tile.y < 0 || tile.x >= m_cols || tile.y >= m_rows)
+	{
+		return DIRECTION_VECTORS[NO_DIRECTION];
+	}
+	return DIRECTION_VECTORS[m_directions[tile.y * m_cols + tile.x]];
+}
+
+void FlowField::GetDirections(const glm::vec2* positions, glm::vec2* directions, const int count) const
+{
+	constexpr auto inverse_tile_size = 1.0f / static_cast<float>(Config::TILE_SIZE);
+	const auto width = static_cast<float>(m_cols);
+	const auto height = static_cast<float>(m_rows);
+
+	for (auto i = 0; i < count; ++i)
+	{
+		const auto x = positions[i].x * inverse_tile_size;
+		const auto y = positions[i].y * inverse_tile_size;
+		const auto inside = x >= 0.0f && y >= 0.0f && x < width && y < height;
+		const auto index = inside ? static_cast<int>(y) * m_cols + static_cast<int>(x) : 0;
+		directions[i] = DIRECTION_VECTORS[inside ? m_directions[index] : NO_DIRECTION];
+	}
+}
+
+glm::ivec2 FlowField::GetTarget() const
+{
+	return m_target;
+}
+
+std::uint32_t FlowField::GetIntegration(const int col, const int row) const
+{
+	return m_integration[row * m_cols + col];
+}
+
+std::uint8_t FlowField::GetDirectionIndex(const int col, const int row) const
+{
+	return m_directions[row * m_cols + col];
+}
+
+const TileGrid* FlowField::GetGrid() const
+{
+	return m_pGrid;
+}
+
+bool FlowField::IsBuiltFrom(const TileGrid& grid) const
+{
+	return m_pGrid == &grid && m_gridVersion == grid.GetVersion();
+}
+
+int FlowField::GetLastUpdateTileCount() const
+{
+	return m_lastUpdateTileCount;
+}
+
+bool FlowField::CanMove(const int x, const int y, const int direction) const
+{
+	const auto nx = x + OFFSET_X[direction];
+	const auto ny = y + OFFSET_Y[direction];
+	if (nx < 0 || ny < 0 || nx >= m_cols || ny >= m_rows || m_costs[ny * m_cols + nx] == TileGrid::BLOCKED)
+	{
+		return false;
+	}
+	// no corner cutting
+	return direction < 4 || (m_costs[y * m_cols + nx] != TileGrid::BLOCKED && m_costs[ny * m_cols + x] != TileGrid::BLOCKED);
+}
+
+void FlowField::MarkDirty(const int index)
+{
+	if (m_dirtyFlags[index] == 0)
+	{
+		m_dirtyFlags[index] = 1;
+		m_dirty.push_back(index);
+	}
+}
+
+void FlowField::Seed(const int index)
+{
+	if (m_costs[index] == TileGrid::BLOCKED)
+	{
+		return;
+	}
+
+	const auto x = index % m_cols;
+	const auto y = index / m_cols;
+	for (auto direction = 0; direction < 8; ++direction)
+	{
+		if (!CanMove(x, y, direction))
+		{
+			continue;
+		}
+
+		const auto neighbour = (y + OFFSET_Y[direction]) * m_cols + x + OFFSET_X[direction];
+		if (m_dirtyFlags[neighbour] != 0 || m_integration[neighbour] == UNREACHABLE)
+		{
+			continue;
+		}
+
+		const auto cost = m_integration[neighbour] + STEP_COST[direction] * m_costs[neighbour];
+		if (cost < m_integration[index])
+		{
+			m_integration[index] = cost;
+			m_directions[index] = static_cast<std::uint8_t>(direction);
+		}
+	}
+
+	if (m_integration[index] != UNREACHABLE)
+	{
+		Push(m_integration[index], index);
+	}
+}
+
+void FlowField::Push(const std::uint32_t cost, const int index)
+{
+	m_open.emplace_back(cost, index);
+	std::push_heap(m_open.begin(), m_open.end(), std::greater<>());
+}
+
+/**
+ * \brief Dijkstra outwards from the open list - every tile that can step onto a settled tile is offered
+ * that tile's cost plus the step. Stale entries (the tile improved after being pushed) are skipped.
+ */
+void FlowField::Propagate()
+{
+	while (!m_open.empty())
+	{
+		std::pop_heap(m_open.begin(), m_open.end(), std::greater<>());
+		const auto [cost, index] = m_open.back();
+		m_open.pop_back();
+		if (cost != m_integration[index])
+		{
+			continue;
+		}
+		++m_lastUpdateTileCount;
+
+		const auto x = index % m_cols;
+		const auto y = index / m_cols;
+		const auto tile_cost = m_costs[index];
+		for (auto direction = 0; direction < 8; ++direction)
+		{
+			// the neighbour steps onto this tile in the opposite direction
+			if (!CanMove(x, y, direction))
+			{
+				continue;
+			}
+
+			const auto neighbour = (y + OFFSET_Y[direction]) * m_cols + x + OFFSET_X[direction];
+			const auto neighbour_cost = cost + STEP_COST[direction] * tile_cost;
+			if (neighbour_cost < m_integration[neighbour])
+			{
+				m_integration[neighbour] = neighbour_cost;
+				m_directions[neighbour] = static_cast<std::uint8_t>(Opposite(direction));
+				Push(neighbour_cost, neighbour);
+			}
+		}
+	}
+}
+
+void FlowField::Benchmark(const int agent_count)
+{
+	std::mt19937 generator(42);
+	std::vector<glm::vec2> directions(agent_count);
+
+	std::cout << "------------ Flow Field Benchmark ----------" << std::endl;
+
+	// every agent chasing one target on the shipped map: a search each against one shared field
+	TileGrid map;
+	if (!map.LoadCSV("../Assets/data/map.csv"))
+	{
+		map.FillRandom(0.2f, 1);
+	}
+
+	glm::ivec2 target;
+	do
+	{
+		target = glm::ivec2(static_cast<int>(generator() % map.GetCols()), static_cast<int>(generator() % map.GetRows()));
+	} while (!map.IsWalkable(target.x, target.y));
+
+	const auto positions = RandomPositions(map, agent_count, generator);
+
+	PathSearchContext context;
+	std::vector<glm::ivec2> path;
+	auto start = SDL_GetPerformanceCounter();
+	for (const auto position : positions)
+	{
+		PathFinder::FindPath(map, TileGrid::WorldToTile(position), target, path, context, OCTILE, true);
+	}
+	const auto search_time = ElapsedMilliseconds(start);
+
+	FlowField field;
+	start = SDL_GetPerformanceCounter();
+	field.Build(map, target);
+	field.GetDirections(positions.data(), directions.data(), agent_count);
+	const auto field_time = ElapsedMilliseconds(start);
+
+	std::cout << map.GetCols() << "x" << map.GetRows() << ", " << agent_count << " agents: one search each "
+		<< search_time << " ms, one field and a sample each " << field_time << " ms" << std::endl;
+
+	// a large grid - build, repair after a few walls move, and sampling
+	constexpr auto size = 1024;
+	TileGrid large(size, size);
+	large.FillRandom(0.2f, 3);
+	target = glm::ivec2(size / 2, size / 2);
+	large.SetCost(target.x, target.y, Config::TILE_COST);
+
+	start = SDL_GetPerformanceCounter();
+	field.Build(large, target);
+	const auto build_time = ElapsedMilliseconds(start);
+
+	constexpr auto change_count = 16;
+	auto repair_time = 0.0;
+	auto repair_tiles = 0;
+	for (auto i = 0; i < change_count; ++i)
+	{
+		large.SetCost(static_cast<int>(generator() % size), static_cast<int>(generator() % size), (generator() % 2) * Config::TILE_COST);
+		large.SetCost(target.x, target.y, Config::TILE_COST);
+		start = SDL_GetPerformanceCounter();
+		field.Update(large, target);
+		repair_time += ElapsedMilliseconds(start);
+		repair_tiles += field.GetLastUpdateTileCount();
+	}
+
+	const auto large_positions = RandomPositions(large, agent_count, generator);
+	start = SDL_GetPerformanceCounter();
+	field.GetDirections(large_positions.data(), directions.data(), agent_count);
+	const auto sample_time = ElapsedMilliseconds(start);
+
+	std::cout << size << "x" << size << ": build " << build_time << " ms, repair after a tile change "
+		<< repair_time / change_count << " ms (" << repair_tiles / change_count << " tiles), "
+		<< agent_count << " samples " << sample_time << " ms" << std::endl;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#ifndef __FLOW_FIELD__
+#define __FLOW_FIELD__
+
+// Core Libraries
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "TileGrid.h"
+
+/**
+ * \brief Cheapest way to one target tile from every tile of a TileGrid.
+ * The integration field holds the cost to the target (10 per straight step, 14 per diagonal, times the tile
+ * entered); the direction field holds the step each tile takes towards it, so any number of agents can read
+ * their heading in O(1). Moves are the same 8-way, no corner cutting moves as the PathFinder.
+ * Update keeps the field in step with the grid: changed tiles and the tiles whose route went through them
+ * are recomputed, the rest of the field is kept. A new target tile needs a full build.
+ */
+class FlowField
+{
+public:
+	static constexpr std::uint32_t UNREACHABLE = 0xFFFFFFFFu;
+	static constexpr std::uint8_t NO_DIRECTION = 8;
+
+	FlowField();
+	~FlowField();
+
+	void Build(const TileGrid& grid, glm::ivec2 target);
+	// rebuilds or repairs the field if the grid or target changed, returns true if anything was recomputed
+	bool Update(const TileGrid& grid, glm::ivec2 target);
+
+	// unit direction towards the target for a position in pixels, zero on the target or where it cannot be reached
+	[[nodiscard]] glm::vec2 GetDirection(glm::vec2 position) const;
+	void GetDirections(const glm::vec2* positions, glm::vec2* directions, int count) const;
+
+	// getters
+	[[nodiscard]] glm::ivec2 GetTarget() const;
+	[[nodiscard]] std::uint32_t GetIntegration(int col, int row) const;
+	[[nodiscard]] std::uint8_t GetDirectionIndex(int col, int row) const;
+	[[nodiscard]] const TileGrid* GetGrid() const;
+	[[nodiscard]] bool IsBuiltFrom(const TileGrid& grid) const;
+	// tiles recomputed by the last Build or Update
+	[[nodiscard]] int GetLastUpdateTileCount() const;
+
+	// one field against a search per agent on map.csv, then build, repair and sampling times on a large grid
+	static void Benchmark(int agent_count = 10000);
+
+private:
+	[[nodiscard]] bool CanMove(int x, int y, int direction) const;
+	void MarkDirty(int index);
+	void Seed(int index);
+	void Push(std::uint32_t cost, int index);
+	void Propagate();
+
+	const TileGrid* m_pGrid;
+	std::uint32_t m_gridVersion;
+	int m_cols;
+	int m_rows;
+	glm::ivec2 m_target;
+
+	// costs the field was computed with, compared with the grid to find changed tiles
+	std::vector<std::uint8_t> m_costs;
+	std::vector<std::uint32_t> m_integration;
+	std::vector<std::uint8_t> m_directions;
+
+	// scratch space kept between updates
+	std::vector<std::pair<std::uint32_t, int>> m_open;
+	std::vector<int> m_changed;
+	std::vector<int> m_improved;
+	std::vector<int> m_dirty;
+	std::vector<std::uint8_t> m_dirtyFlags;
+	int m_lastUpdateTileCount;
+};
+
+#endif /* defined (__FLOW_FIELD__) */
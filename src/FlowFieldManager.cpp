@@ -0,0 +1,71 @@
+#include "FlowFieldManager.h"
+#include <algorithm>
+
+const FlowField& FlowFieldManager::GetFlowField(const TileGrid& grid, const glm::ivec2 target)
+{
+	++m_requestCount;
+
+	for (const auto& entry : m_fields)
+	{
+		if (entry->field.GetGrid() == &grid && entry->field.GetTarget() == target)
+		{
+			entry->field.Update(grid, target);
+			entry->last_used = m_requestCount;
+			return entry->field;
+		}
+	}
+
+	if (static_cast<int>(m_fields.size()) < m_maxFieldCount)
+	{
+		m_fields.push_back(std::make_unique<Entry>());
+	}
+	else
+	{
+		// the least recently requested field goes to the new target
+		std::iter_swap(std::min_element(m_fields.begin(), m_fields.end(), [](const auto& lhs, const auto& rhs)
+		{
+			return lhs->last_used < rhs->last_used;
+		}), m_fields.end() - 1);
+	}
+
+	auto& entry = *m_fields.back();
+	entry.field.Build(grid, target);
+	entry.last_used = m_requestCount;
+	return entry.field;
+}
+
+void FlowFieldManager::Clear()
+{
+	m_fields.clear();
+}
+
+int FlowFieldManager::GetFieldCount() const
+{
+	return static_cast<int>(m_fields.size());
+}
+
+int FlowFieldManager::GetMaxFieldCount() const
+{
+	return m_maxFieldCount;
+}
+
+void FlowFieldManager::SetMaxFieldCount(const int max_field_count)
+{
+	m_maxFieldCount = std::max(max_field_count, 1);
+	if (static_cast<int>(m_fields.size()) > m_maxFieldCount)
+	{
+		// keep the most recently requested fields
+		std::sort(m_fields.begin(), m_fields.end(), [](const auto& lhs, const auto& rhs)
+		{
+			return lhs->last_used > rhs->last_used;
+		});
+		m_fields.resize(m_maxFieldCount);
+	}
+}
+
+FlowFieldManager::FlowFieldManager() : m_requestCount(0), m_maxFieldCount(8)
+{
+}
+
+FlowFieldManager::~FlowFieldManager()
+= default;
@@ -0,0 +1,55 @@
+#pragma once
+#ifndef __FLOW_FIELD_MANAGER__
+#define __FLOW_FIELD_MANAGER__
+
+// Core Libraries
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "FlowField.h"
+
+/* Singleton
+ * Shares flow fields between every agent heading for the same target tile.
+ * The first request for a target builds its field, later requests get the same one, repaired if the grid
+ * changed since. Up to a maximum number of fields are kept; a new target reuses the least recently
+ * requested field (and its memory).
+ */
+class FlowFieldManager
+{
+public:
+	static FlowFieldManager& Instance()
+	{
+		static FlowFieldManager instance;
+		return instance;
+	}
+
+	// valid until the next request for a different target evicts it or Clear is called
+	const FlowField& GetFlowField(const TileGrid& grid, glm::ivec2 target);
+	void Clear();
+
+	// getters
+	[[nodiscard]] int GetFieldCount() const;
+	[[nodiscard]] int GetMaxFieldCount() const;
+
+	// setters
+	void SetMaxFieldCount(int max_field_count);
+
+private:
+	FlowFieldManager();
+	~FlowFieldManager();
+	FlowFieldManager(const FlowFieldManager&) = delete;
+	FlowFieldManager& operator=(const FlowFieldManager&) = delete;
+
+	struct Entry
+	{
+		FlowField field;
+		std::uint64_t last_used = 0;
+	};
+
+	std::vector<std::unique_ptr<Entry>> m_fields;
+	std::uint64_t m_requestCount;
+	int m_maxFieldCount;
+};
+
+#endif /* defined (__FLOW_FIELD_MANAGER__) */
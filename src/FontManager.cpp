@@ -1,5 +1,6 @@
 #include "FontManager.h"
 #include "Renderer.h"
+#include "RenderThread.h"
 #include "TextureManager.h"
 
 inline bool FontManager::CheckIfFontExists(const std::string& id)
@@ -27,6 +28,12 @@ bool FontManager::Load(const std::string& file_name, const std::string& id, cons
 
 bool FontManager::TextToTexture(const std::string& text, const std::string& font_id, const std::string& texture_id, const SDL_Color colour)
 {
+	// an existing id keeps its texture, so there is nothing to create (and nothing to destroy behind the render thread's back)
+	if (TextureManager::Instance().GetTexture(texture_id) != nullptr)
+	{
+		return true;
+	}
+
 	//Render text surface
 
 	const auto textSurface(Config::MakeResource(TTF_RenderText_Solid(m_fontMap[font_id].get(), text.c_str(), colour)));
@@ -38,15 +45,17 @@ bool FontManager::TextToTexture(const std::string& text, const std::string& font
 	}
 	else
 	{
+		std::unique_lock<std::mutex> lock(RenderThread::Instance().GetDeviceMutex());
 		const auto pTexture(Config::MakeResource(SDL_CreateTextureFromSurface(/* TheGame::Instance()->getRenderer()*/ Renderer::Instance().GetRenderer(), textSurface.get())));
+		lock.unlock();
 
 		//Create texture from surface pixels
-		TextureManager::Instance().AddTexture(texture_id, pTexture);
-		if (TextureManager::Instance().GetTexture(texture_id) == nullptr)
+		if (pTexture == nullptr)
 		{
 			printf("Unable to create texture from rendered text! SDL Error: %s\n", SDL_GetError());
 			return false;
 		}
+		TextureManager::Instance().AddTexture(texture_id, pTexture);
 	}
 
 	return true;
@@ -57,8 +66,27 @@ TTF_Font* FontManager::GetFont(const std::string& id)
 	return m_fontMap[id].get();
 }
 
+GlyphAtlas* FontManager::GetGlyphAtlas(const std::string& font_id)
+{
+	if (const auto atlas = m_glyphAtlasMap.find(font_id); atlas != m_glyphAtlasMap.end())
+	{
+		return atlas->second.get();
+	}
+
+	if (!CheckIfFontExists(font_id))
+	{
+		return nullptr;
+	}
+
+	auto& atlas = m_glyphAtlasMap[font_id];
+	atlas = std::make_unique<GlyphAtlas>(m_fontMap[font_id].get());
+	return atlas.get();
+}
+
 void FontManager::Clean()
 {
+	// atlases hold raw pointers to their fonts
+	m_glyphAtlasMap.clear();
 	m_fontMap.clear();
 }
 
@@ -13,6 +13,7 @@
 #include <SDL_ttf.h>
 #include <string>
 #include "Config.h"
+#include "GlyphAtlas.h"
 
 class FontManager
 {
@@ -26,6 +27,8 @@ public:
 	bool Load(const std::string& file_name, const std::string& id, int size, int style = TTF_STYLE_NORMAL);
 	bool TextToTexture(const std::string& text, const std::string& font_id, const std::string& texture_id, SDL_Color colour = { 0, 0, 0, 255 });
 	TTF_Font* GetFont(const std::string& id);
+	// glyph atlas for a loaded font, built on first use - nullptr if the font isn't loaded
+	GlyphAtlas* GetGlyphAtlas(const std::string& font_id);
 	void Clean();
 
 	void DisplayFontMap();
@@ -37,6 +40,7 @@ private:
 	bool CheckIfFontExists(const std::string& id);
 
 	std::unordered_map<std::string, std::shared_ptr<TTF_Font>> m_fontMap;
+	std::unordered_map<std::string, std::unique_ptr<GlyphAtlas>> m_glyphAtlasMap;
 
 	static FontManager* s_pInstance;
 };
@@ -1,11 +1,10 @@
 #pragma once
 #ifndef __FRAME__
 #define __FRAME__
-#include <string>
 
+// source rect of one frame in a sprite sheet - frame names live in the SpriteSheet (see SpriteSheet::GetFrameId)
 struct Frame
 {
-	std::string name = "";
 	int x = 0;
 	int y = 0;
 	int w = 0;
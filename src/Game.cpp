@@ -5,6 +5,15 @@
 #include "glm/gtx/string_cast.hpp"
 #include "Renderer.h"
 #include "EventManager.h"
+#include "DebugDraw.h"
+#include "TextureCache.h"
+#include "RenderThread.h"
+#include "CollisionManager.h"
+#include "CollisionEventQueue.h"
+#include "PhysicsWorld.h"
+#include "CollisionFilter.h"
+#include "FlowFieldManager.h"
+#include "PathRequestQueue.h"
 
 
 // Game functions - DO NOT REMOVE ***********************************************
@@ -138,6 +147,10 @@ void Game::ChangeSceneState(const SceneState new_state)
 		// scene clean up
 		if (m_currentSceneState != SceneState::NO_SCENE)
 		{
+			// queued frames still reference the textures about to be destroyed
+			RenderThread::Instance().WaitIdle();
+			// pending searches read grids the scene is about to free, and their callbacks capture its objects
+			PathRequestQueue::Instance().Clear();
 			m_pCurrentScene->Clean();
 			std::cout << "cleaning previous scene" << std::endl;
 			FontManager::Instance().Clean();
@@ -146,6 +159,7 @@ void Game::ChangeSceneState(const SceneState new_state)
 			std::cout << "cleaning TextureManager" << std::endl;
 			ImGuiWindowFrame::Instance().ClearWindow();
 			std::cout << "clearing ImGui Window" << std::endl;
+			DebugDraw::Instance().Clear();
 		}
 
 		m_pCurrentScene = nullptr;
@@ -154,6 +168,17 @@ void Game::ChangeSceneState(const SceneState new_state)
 
 		EventManager::Instance().Reset();
 
+		// handlers registered by the previous scene go with it, the new scene can add its own to the defaults
+		CollisionEventQueue::Instance().Reset();
+		CollisionManager::AddDefaultResponses();
+
+		// bodies register themselves on construction, anything the old scene left behind is stale
+		PhysicsWorld::Instance().Clear();
+		// flow fields point at the old scene's grids
+		FlowFieldManager::Instance().Clear();
+
+		TextureCache::Instance().ResetStats();
+
 		switch (m_currentSceneState)
 		{
 		case SceneState::START:
@@ -174,6 +199,9 @@ void Game::ChangeSceneState(const SceneState new_state)
 			break;
 		
 		}
+
+		// cold loads decode and write the cache, warm loads read it back
+		TextureCache::Instance().PrintStats();
 	}
 
 }
@@ -190,24 +218,61 @@ void Game::Quit()
 
 void Game::Render() const
 {
-	SDL_RenderClear(Renderer::Instance().GetRenderer()); // clear the renderer to the draw colour
+	if (RenderThread::Instance().IsRunning())
+	{
+		// record the frame, the render thread plays it back and presents while the next frame updates
+		Renderer::Instance().SetDrawList(&RenderThread::Instance().BeginFrame());
+
+		Renderer::Instance().Clear();
+		m_pCurrentScene->Draw();
+		DebugDraw::Instance().Flush(Renderer::Instance().GetRenderer());
+
+		Renderer::Instance().SetDrawList(nullptr);
+		RenderThread::Instance().EndFrame();
+	}
+	else
+	{
+		SDL_RenderClear(Renderer::Instance().GetRenderer()); // clear the renderer to the draw colour
+
+		m_pCurrentScene->Draw();
 
-	m_pCurrentScene->Draw();
+		// submit the debug overlay accumulated during this frame
+		DebugDraw::Instance().Flush(Renderer::Instance().GetRenderer());
 
-	SDL_RenderPresent(Renderer::Instance().GetRenderer()); // draw to the screen
+		SDL_RenderPresent(Renderer::Instance().GetRenderer()); // draw to the screen
+	}
 
+	// nothing drawn this frame still needs its textures, evict down to the memory budget
+	TextureManager::Instance().EndFrame();
+
+	// throttled and skipped while hidden, never waits for vsync
 	ImGuiWindowFrame::Instance().Render();
 }
 
 void Game::Update() const
 {
 	m_pCurrentScene->Update();
+
+	// search within the frame budget and call back with the paths that are done
+	PathRequestQueue::Instance().Update();
+
+	// fixed-step integration of every registered rigid body
+	PhysicsWorld::Instance().Step(GetDeltaTime());
+
+	// respond to the contacts the scene reported during its update
+	CollisionEventQueue::Instance().Update();
+
+	// publish this frame's tested pairs for the collision matrix
+	CollisionFilter::EndFrame();
 }
 
 void Game::Clean() const
 {
 	std::cout << "cleaning game" << std::endl;
 
+	RenderThread::Instance().Stop();
+	PathRequestQueue::Instance().Stop();
+
 	// Clean Up for IMGUI
 	//ImGui::DestroyContext();
 	ImGuiWindowFrame::Instance().Clean();
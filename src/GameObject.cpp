@@ -1,7 +1,8 @@
 #include "GameObject.h"
+#include "CollisionFilter.h"
 
 GameObject::GameObject() :
-	m_width(0), m_height(0), m_type(GameObjectType::NONE), m_enabled(true), m_visible(true)
+	m_width(0), m_height(0), m_type(GameObjectType::NONE), m_enabled(true), m_visible(true), m_isCentered(true), m_rotation(0.0f)
 {
 }
 
@@ -46,6 +47,8 @@ void GameObject::SetHeight(const int new_height)
 void GameObject::SetType(const GameObjectType new_type)
 {
 	m_type = new_type;
+	m_rigidBody.categoryBits = CollisionFilter::GetCategory(new_type);
+	m_rigidBody.maskBits = CollisionFilter::GetDefaultMask(new_type);
 }
 
 void GameObject::SetEnabled(const bool state)
@@ -77,3 +80,19 @@ bool GameObject::isCentered() const
 {
 	return m_isCentered;
 }
+
+float GameObject::GetRotation() const
+{
+	return m_rotation;
+}
+
+void GameObject::SetRotation(const float angle)
+{
+	m_rotation = angle;
+}
+
+const OBB& GameObject::GetOBB()
+{
+	m_obb.Update(m_transform.position, static_cast<float>(m_width), static_cast<float>(m_height), m_rotation, m_isCentered);
+	return m_obb;
+}
@@ -4,6 +4,7 @@
 
 #include "Transform.h"
 #include "RigidBody.h"
+#include "OBB.h"
 #include <string>
 
 // enums
@@ -47,6 +48,13 @@ public:
 	void setIsCentered(bool state);
 	[[nodiscard]] bool isCentered() const;
 
+	// rotation about the position in degrees, used by the oriented bounds
+	[[nodiscard]] float GetRotation() const;
+	void SetRotation(float angle);
+
+	// oriented box of width x height, rebuilt only when the position, rotation or size has changed
+	const OBB& GetOBB();
+
 private:
 	// transform component
 	Transform m_transform;
@@ -62,6 +70,9 @@ private:
 	bool m_enabled;
 	bool m_visible;
 	bool m_isCentered;
+
+	float m_rotation;
+	OBB m_obb;
 };
 
 #endif /* defined (__GAME_OBJECT__) */
\ No newline at end of file
@@ -0,0 +1,259 @@
+#include "GlyphAtlas.h"
+#include <algorithm>
+#include <iostream>
+#include "Config.h"
+#include "Renderer.h"
+#include "RenderThread.h"
+
+namespace
+{
+	constexpr int INITIAL_ATLAS_SIZE = 256;
+	constexpr int GLYPH_PADDING = 1; // keeps neighbouring glyphs from bleeding into each other when filtered
+}
+
+GlyphAtlas::GlyphAtlas(TTF_Font* font) :
+	m_pFont(font), m_lineHeight(TTF_FontHeight(font)), m_generation(0), m_shelfX(0), m_shelfY(0), m_shelfHeight(0)
+{
+	// the atlas starts wide enough for any glyph of this font and grows downwards
+	auto width = INITIAL_ATLAS_SIZE;
+	while (width < m_lineHeight * 4)
+	{
+		width *= 2;
+	}
+
+	m_pSurface = Config::MakeResource(SDL_CreateRGBSurfaceWithFormat(0, width, width, 32, SDL_PIXELFORMAT_ARGB8888));
+	if (m_pSurface != nullptr)
+	{
+		SDL_FillRect(m_pSurface.get(), nullptr, 0);
+	}
+	Grow();
+}
+
+GlyphAtlas::~GlyphAtlas()
+= default;
+
+glm::vec2 GlyphAtlas::BuildQuads(const std::string& text, const SDL_Color colour, std::vector<SDL_Vertex>& vertices, std::vector<int>& indices)
+{
+	// rasterize any new glyphs first - a resize part way through would leave earlier quads with stale texture coordinates
+	for (const auto character : text)
+	{
+		GetGlyph(static_cast<unsigned char>(character));
+	}
+
+	if (m_pSurface == nullptr)
+	{
+		return glm::vec2();
+	}
+
+	const auto inverse_width = 1.0f / static_cast<float>(m_pSurface->w);
+	const auto inverse_height = 1.0f / static_cast<float>(m_pSurface->h);
+
+	auto pen_x = 0;
+	auto width = 0;
+	auto previous = 0;
+
+	for (const auto c : text)
+	{
+		const auto character = static_cast<unsigned char>(c);
+		const auto& glyph = GetGlyph(character);
+
+		if (previous != 0)
+		{
+			pen_x += TTF_GetFontKerningSizeGlyphs(m_pFont, static_cast<Uint16>(previous), character);
+		}
+		previous = character;
+
+		if (glyph.rect.w > 0 && glyph.rect.h > 0)
+		{
+			const auto left = static_cast<float>(pen_x + glyph.offset_x);
+			const auto right = left + static_cast<float>(glyph.rect.w);
+			const auto bottom = static_cast<float>(glyph.rect.h);
+
+			const auto u0 = static_cast<float>(glyph.rect.x) * inverse_width;
+			const auto v0 = static_cast<float>(glyph.rect.y) * inverse_height;
+			const auto u1 = static_cast<float>(glyph.rect.x + glyph.rect.w) * inverse_width;
+			const auto v1 = static_cast<float>(glyph.rect.y + glyph.rect.h) * inverse_height;
+
+			const auto base = static_cast<int>(vertices.size());
+			vertices.push_back({ { left, 0.0f }, colour, { u0, v0 } });
+			vertices.push_back({ { right, 0.0f }, colour, { u1, v0 } });
+			vertices.push_back({ { right, bottom }, colour, { u1, v1 } });
+			vertices.push_back({ { left, bottom }, colour, { u0, v1 } });
+
+			const int quad_indices[6] = { 0, 1, 2, 0, 2, 3 };
+			for (const auto index : quad_indices)
+			{
+				indices.push_back(base + index);
+			}
+
+			width = std::max(width, pen_x + glyph.offset_x + glyph.rect.w);
+		}
+
+		pen_x += glyph.advance;
+		width = std::max(width, pen_x);
+	}
+
+	return { static_cast<float>(width), static_cast<float>(m_lineHeight) };
+}
+
+glm::vec2 GlyphAtlas::MeasureText(const std::string& text)
+{
+	auto pen_x = 0;
+	auto width = 0;
+	auto previous = 0;
+
+	for (const auto c : text)
+	{
+		const auto character = static_cast<unsigned char>(c);
+		const auto& glyph = GetGlyph(character);
+
+		if (previous != 0)
+		{
+			pen_x += TTF_GetFontKerningSizeGlyphs(m_pFont, static_cast<Uint16>(previous), character);
+		}
+		previous = character;
+
+		width = std::max(width, pen_x + glyph.offset_x + glyph.rect.w);
+		pen_x += glyph.advance;
+		width = std::max(width, pen_x);
+	}
+
+	return { static_cast<float>(width), static_cast<float>(m_lineHeight) };
+}
+
+SDL_Texture* GlyphAtlas::GetTexture() const
+{
+	return m_pTexture.get();
+}
+
+int GlyphAtlas::GetLineHeight() const
+{
+	return m_lineHeight;
+}
+
+int GlyphAtlas::GetGeneration() const
+{
+	return m_generation;
+}
+
+const GlyphAtlas::Glyph& GlyphAtlas::GetGlyph(const unsigned char character)
+{
+	auto& glyph = m_glyphs[character];
+	if (glyph.loaded || m_pSurface == nullptr)
+	{
+		return glyph;
+	}
+	glyph.loaded = true;
+
+	int min_x, max_x, min_y, max_y, advance;
+	if (TTF_GlyphMetrics(m_pFont, character, &min_x, &max_x, &min_y, &max_y, &advance) != 0)
+	{
+		return glyph;
+	}
+	glyph.advance = advance;
+	glyph.offset_x = std::min(0, min_x);
+
+	// whitespace has an advance but nothing to draw
+	const auto glyph_surface(Config::MakeResource(TTF_RenderGlyph_Blended(m_pFont, character, { 255, 255, 255, 255 })));
+	if (glyph_surface == nullptr || glyph_surface->w == 0 || glyph_surface->h == 0 || max_x <= min_x)
+	{
+		return glyph;
+	}
+
+	SDL_Rect rect;
+	if (!Pack(glyph_surface->w, glyph_surface->h, rect))
+	{
+		std::cout << "glyph atlas is full" << std::endl;
+		return glyph;
+	}
+
+	// copy the glyph as is, including its alpha
+	SDL_SetSurfaceBlendMode(glyph_surface.get(), SDL_BLENDMODE_NONE);
+	SDL_BlitSurface(glyph_surface.get(), nullptr, m_pSurface.get(), &rect);
+
+	// only the new glyph is uploaded unless the texture was rebuilt by Pack
+	const auto pixels = static_cast<Uint8*>(m_pSurface->pixels) + rect.y * m_pSurface->pitch + rect.x * 4;
+	{
+		std::lock_guard<std::mutex> lock(RenderThread::Instance().GetDeviceMutex());
+		SDL_UpdateTexture(m_pTexture.get(), &rect, pixels, m_pSurface->pitch);
+	}
+
+	glyph.rect = rect;
+	return glyph;
+}
+
+bool GlyphAtlas::Pack(const int width, const int height, SDL_Rect& rect)
+{
+	if (width + GLYPH_PADDING > m_pSurface->w)
+	{
+		return false;
+	}
+
+	// start a new shelf when this one is full
+	if (m_shelfX + width + GLYPH_PADDING > m_pSurface->w)
+	{
+		m_shelfY += m_shelfHeight + GLYPH_PADDING;
+		m_shelfX = 0;
+		m_shelfHeight = 0;
+	}
+
+	while (m_shelfY + height + GLYPH_PADDING > m_pSurface->h)
+	{
+		const auto previous_height = m_pSurface->h;
+		Grow();
+		if (m_pSurface->h == previous_height)
+		{
+			return false;
+		}
+	}
+
+	rect = { m_shelfX, m_shelfY, width, height };
+	m_shelfX += width + GLYPH_PADDING;
+	m_shelfHeight = std::max(m_shelfHeight, height);
+	return true;
+}
+
+/**
+ * \brief Doubles the height of the atlas (or creates the texture the first time it is called)
+ */
+void GlyphAtlas::Grow()
+{
+	if (m_pSurface == nullptr)
+	{
+		return;
+	}
+
+	if (m_pTexture != nullptr)
+	{
+		auto surface(Config::MakeResource(SDL_CreateRGBSurfaceWithFormat(0, m_pSurface->w, m_pSurface->h * 2, 32, SDL_PIXELFORMAT_ARGB8888)));
+		if (surface == nullptr)
+		{
+			return;
+		}
+
+		SDL_FillRect(surface.get(), nullptr, 0);
+		SDL_SetSurfaceBlendMode(m_pSurface.get(), SDL_BLENDMODE_NONE);
+		SDL_BlitSurface(m_pSurface.get(), nullptr, surface.get(), nullptr);
+		m_pSurface = std::move(surface);
+	}
+
+	std::shared_ptr<SDL_Texture> texture;
+	{
+		std::lock_guard<std::mutex> lock(RenderThread::Instance().GetDeviceMutex());
+		texture = Config::MakeResource(SDL_CreateTexture(Renderer::Instance().GetRenderer(), SDL_PIXELFORMAT_ARGB8888,
+			SDL_TEXTUREACCESS_STATIC, m_pSurface->w, m_pSurface->h));
+		if (texture == nullptr)
+		{
+			std::cout << "unable to create glyph atlas texture: " << SDL_GetError() << std::endl;
+			return;
+		}
+
+		SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+		SDL_UpdateTexture(texture.get(), nullptr, m_pSurface->pixels, m_pSurface->pitch);
+	}
+
+	// queued frames may still draw from the old texture
+	RenderThread::Instance().WaitIdle();
+	m_pTexture = std::move(texture);
+	++m_generation;
+}
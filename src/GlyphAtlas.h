@@ -0,0 +1,72 @@
+#pragma once
+#ifndef __GLYPH_ATLAS__
+#define __GLYPH_ATLAS__
+
+// Core Libraries
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "glm/vec2.hpp"
+
+// SDL Libraries
+#include <SDL.h>
+#include <SDL_ttf.h>
+
+/**
+ * \brief Glyphs of one font at one size packed into a single texture.
+ * Glyphs are rasterized in white the first time they are used, so text in any colour
+ * is drawn from the same texture by setting the vertex colour of its quads.
+ * Text is treated as Latin-1, like TTF_RenderText.
+ */
+class GlyphAtlas
+{
+public:
+	explicit GlyphAtlas(TTF_Font* font);
+	~GlyphAtlas();
+
+	GlyphAtlas(const GlyphAtlas&) = delete;
+	GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+	// appends one quad per visible character to vertices/indices, positioned relative to the top left of the text
+	// returns the size of the text
+	glm::vec2 BuildQuads(const std::string& text, SDL_Color colour, std::vector<SDL_Vertex>& vertices, std::vector<int>& indices);
+	glm::vec2 MeasureText(const std::string& text);
+
+	// getters
+	[[nodiscard]] SDL_Texture* GetTexture() const;
+	[[nodiscard]] int GetLineHeight() const;
+	// changes whenever the texture is resized, quads built with an older generation have stale texture coordinates
+	[[nodiscard]] int GetGeneration() const;
+
+private:
+	struct Glyph
+	{
+		SDL_Rect rect{};  // area of the atlas texture
+		int offset_x = 0; // from the pen position to the left edge of rect
+		int advance = 0;
+		bool loaded = false;
+	};
+
+	const Glyph& GetGlyph(unsigned char character);
+	bool Pack(int width, int height, SDL_Rect& rect);
+	void Grow();
+
+	TTF_Font* m_pFont;
+	int m_lineHeight;
+	int m_generation;
+
+	// CPU copy of the atlas, kept so the texture can be rebuilt when it grows
+	std::shared_ptr<SDL_Surface> m_pSurface;
+	std::shared_ptr<SDL_Texture> m_pTexture;
+
+	// shelf packer state
+	int m_shelfX;
+	int m_shelfY;
+	int m_shelfHeight;
+
+	std::array<Glyph, 256> m_glyphs;
+};
+
+#endif /* defined (__GLYPH_ATLAS__) */
@@ -5,6 +5,7 @@ enum Heuristic
 {
 	MANHATTAN,
 	EUCLIDEAN,
+	OCTILE,
 	NUM_OF_HEURISTICS
 };
 #endif /* defined (__HEURISTIC__) */
\ No newline at end of file
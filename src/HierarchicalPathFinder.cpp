@@ -0,0 +1,806 @@
+#include "HierarchicalPathFinder.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <SDL.h>
+#include "PathFinder.h"
+
+namespace
+{
+	// same order as the PathFinder: E, S, W, N, SE, SW, NW, NE
+	constexpr int OFFSET_X[8] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	constexpr int OFFSET_Y[8] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+	constexpr float STEP[8] = { 1.0f, 1.0f, 1.0f, 1.0f, 1.41421356f, 1.41421356f, 1.41421356f, 1.41421356f };
+
+	// open border stretches shorter than this get one entrance in the middle, longer ones one at each end
+	constexpr int LONG_ENTRANCE = 6;
+
+	constexpr int COMPARE_BLOCK_SIZE = 256;
+
+	double ElapsedMilliseconds(const Uint64 start)
+	{
+		return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+	}
+}
+
+HierarchicalPathFinder::HierarchicalPathFinder(const int cluster_size) :
+	m_pGrid(nullptr), m_gridVersion(0), m_cols(0), m_rows(0), m_clusterSize(std::max(cluster_size, 2)),
+	m_clusterCols(0), m_clusterRows(0), m_generation(0)
+{
+}
+
+HierarchicalPathFinder::~HierarchicalPathFinder()
+= default;
+
+void HierarchicalPathFinder::Build(const TileGrid& grid)
+{
+	m_pGrid = &grid;
+	m_gridVersion = grid.GetVersion();
+	m_localSearch.cluster = -1;
+	m_cols = grid.GetCols();
+	m_rows = grid.GetRows();
+	m_costs.assign(grid.GetCosts(), grid.GetCosts() + grid.GetTileCount());
+	m_clusterCols = (m_cols + m_clusterSize - 1) / m_clusterSize;
+	m_clusterRows = (m_rows + m_clusterSize - 1) / m_clusterSize;
+
+	m_clusterNodes.assign(static_cast<size_t>(m_clusterCols) * m_clusterRows, std::vector<int>());
+	m_nodes.clear();
+	m_freeNodes.clear();
+
+	const auto cluster_count = static_cast<int>(m_clusterNodes.size());
+	for (auto cluster = 0; cluster < cluster_count; ++cluster)
+	{
+		BuildBorder(cluster, EAST);
+		BuildBorder(cluster, SOUTH);
+	}
+
+	// clusters only write the edges of their own nodes, so they can be linked in parallel
+	std::atomic<int> next_cluster(0);
+	auto link = [this, &next_cluster, cluster_count](LocalSearch& search)
+	{
+		for (auto cluster = next_cluster++; cluster < cluster_count; cluster = next_cluster++)
+		{
+			BuildIntraEdges(cluster, search);
+		}
+	};
+
+	const auto worker_count = static_cast<int>(std::clamp(std::thread::hardware_concurrency(), 1u, 16u)) - 1;
+	std::vector<LocalSearch> searches(worker_count);
+	std::vector<std::thread> workers;
+	for (auto i = 0; i < worker_count; ++i)
+	{
+		workers.emplace_back(link, std::ref(searches[i]));
+	}
+	link(m_localSearch);
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+/**
+ * \brief A changed tile invalidates the links inside its cluster, and the entrances of a border it lies on.
+ * Borders are rebuilt first, then the links of every cluster that lost or gained entrances.
+ */
+int HierarchicalPathFinder::Update()
+{
+	if (m_pGrid == nullptr || m_gridVersion == m_pGrid->GetVersion())
+	{
+		return 0;
+	}
+
+	if (m_pGrid->GetCols() != m_cols || m_pGrid->GetRows() != m_rows)
+	{
+		Build(*m_pGrid);
+		return static_cast<int>(m_clusterNodes.size());
+	}
+	m_gridVersion = m_pGrid->GetVersion();
+	m_localSearch.cluster = -1;
+
+	const auto cluster_count = static_cast<int>(m_clusterNodes.size());
+	std::vector<std::uint8_t> dirty_clusters(cluster_count, 0);
+	// [cluster * 2 + side] for the EAST and SOUTH borders each cluster owns
+	std::vector<std::uint8_t> dirty_borders(static_cast<size_t>(cluster_count) * 2, 0);
+
+	const auto costs = m_pGrid->GetCosts();
+	const auto tile_count = m_pGrid->GetTileCount();
+	for (auto block = 0; block < tile_count; block += COMPARE_BLOCK_SIZE)
+	{
+		const auto block_size = std::min(COMPARE_BLOCK_SIZE, tile_count - block);
+		if (std::memcmp(costs + block, m_costs.data() + block, block_size) == 0)
+		{
+			continue;
+		}
+
+		for (auto tile = block; tile < block + block_size; ++tile)
+		{
+			if (costs[tile] == m_costs[tile])
+			{
+				continue;
+			}
+			m_costs[tile] = costs[tile];
+
+			const auto x = tile % m_cols;
+			const auto y = tile / m_cols;
+			const auto cluster = GetCluster(x, y);
+			const auto min = GetClusterMin(cluster);
+			const auto max = GetClusterMax(cluster);
+			dirty_clusters[cluster] = 1;
+
+			if (x == max.x - 1 && max.x < m_cols)
+			{
+				dirty_borders[cluster * 2] = 1;
+			}
+			if (x == min.x && min.x > 0)
+			{
+				dirty_borders[(cluster - 1) * 2] = 1;
+			}
+			if (y == max.y - 1 && max.y < m_rows)
+			{
+				dirty_borders[cluster * 2 + 1] = 1;
+			}
+			if (y == min.y && min.y > 0)
+			{
+				dirty_borders[(cluster - m_clusterCols) * 2 + 1] = 1;
+			}
+		}
+	}
+
+	for (auto cluster = 0; cluster < cluster_count; ++cluster)
+	{
+		if (dirty_borders[cluster * 2] != 0)
+		{
+			BuildBorder(cluster, EAST);
+			dirty_clusters[cluster] = dirty_clusters[cluster + 1] = 1;
+		}
+		if (dirty_borders[cluster * 2 + 1] != 0)
+		{
+			BuildBorder(cluster, SOUTH);
+			dirty_clusters[cluster] = dirty_clusters[cluster + m_clusterCols] = 1;
+		}
+	}
+
+	auto rebuilt_count = 0;
+	for (auto cluster = 0; cluster < cluster_count; ++cluster)
+	{
+		if (dirty_clusters[cluster] != 0)
+		{
+			BuildIntraEdges(cluster, m_localSearch);
+			++rebuilt_count;
+		}
+	}
+	return rebuilt_count;
+}
+
+bool HierarchicalPathFinder::FindAbstractPath(const glm::ivec2 start, const glm::ivec2 goal, HierarchicalPath& path)
+{
+	path = HierarchicalPath();
+	if (m_pGrid == nullptr || start.x < 0 || start.y < 0 || start.x >= m_cols || start.y >= m_rows ||
+		goal.x < 0 || goal.y < 0 || goal.x >= m_cols || goal.y >= m_rows)
+	{
+		return false;
+	}
+
+	const auto start_tile = start.y * m_cols + start.x;
+	const auto goal_tile = goal.y * m_cols + goal.x;
+	if (m_costs[start_tile] == TileGrid::BLOCKED || m_costs[goal_tile] == TileGrid::BLOCKED)
+	{
+		return false;
+	}
+
+	const auto start_cluster = GetCluster(start.x, start.y);
+	const auto goal_cluster = GetCluster(goal.x, goal.y);
+
+	// connect the start and the goal to the entrances of their clusters
+	auto& start_edges = m_startEdges;
+	start_edges.clear();
+	SearchCluster(start_cluster, start_tile, false, nullptr, 0, m_localSearch);
+	for (const auto node : m_clusterNodes[start_cluster])
+	{
+		if (const auto cost = GetLocalCost(start_cluster, m_nodes[node].tile, m_localSearch); cost != INFINITY)
+		{
+			start_edges.push_back({ node, cost });
+		}
+	}
+
+	// in one cluster the way that stays inside is only a candidate - walls can make leaving and coming back
+	// much shorter, so it becomes a direct edge to the goal and competes with the routes through the entrances
+	const auto direct_cost = (start_cluster == goal_cluster) ? GetLocalCost(start_cluster, goal_tile, m_localSearch) : INFINITY;
+
+	m_goalCosts.resize(m_nodes.size(), INFINITY);
+	SearchCluster(goal_cluster, goal_tile, true, nullptr, 0, m_localSearch);
+	for (const auto node : m_clusterNodes[goal_cluster])
+	{
+		m_goalCosts[node] = GetLocalCost(goal_cluster, m_nodes[node].tile, m_localSearch);
+	}
+
+	// A* over the entrances, the start and goal are the two ids after the last node
+	const auto start_id = static_cast<int>(m_nodes.size());
+	const auto goal_id = start_id + 1;
+	if (m_records.size() < m_nodes.size() + 2)
+	{
+		m_records.resize(m_nodes.size() + 2);
+	}
+	if (++m_generation == 0)
+	{
+		std::fill(m_records.begin(), m_records.end(), AbstractRecord());
+		m_generation = 1;
+	}
+
+	auto tile_of = [&](const int id)
+	{
+		return id == start_id ? start : id == goal_id ? goal : glm::ivec2(m_nodes[id].tile % m_cols, m_nodes[id].tile / m_cols);
+	};
+
+	m_open.clear();
+	m_records[start_id] = { m_generation, false, -1, 0.0f };
+	m_open.emplace_back(PathFinder::Estimate(start, goal, OCTILE), start_id);
+
+	auto found = false;
+	while (!m_open.empty())
+	{
+		std::pop_heap(m_open.begin(), m_open.end(), std::greater<>());
+		const auto id = m_open.back().second;
+		m_open.pop_back();
+
+		auto& record = m_records[id];
+		if (record.closed)
+		{
+			continue;
+		}
+		if (id == goal_id)
+		{
+			found = true;
+			break;
+		}
+		record.closed = true;
+
+		auto relax = [&](const int to, const float cost)
+		{
+			const auto g = record.g + cost;
+			auto& next = m_records[to];
+			if (next.generation == m_generation && (next.closed || next.g <= g))
+			{
+				return;
+			}
+			next = { m_generation, false, id, g };
+			m_open.emplace_back(g + PathFinder::Estimate(tile_of(to), goal, OCTILE), to);
+			std::push_heap(m_open.begin(), m_open.end(), std::greater<>());
+		};
+
+		if (id == start_id)
+		{
+			for (const auto& edge : start_edges)
+			{
+				relax(edge.to, edge.cost);
+			}
+			if (direct_cost != INFINITY)
+			{
+				relax(goal_id, direct_cost);
+			}
+			continue;
+		}
+
+		for (const auto& edge : m_nodes[id].edges)
+		{
+			relax(edge.to, edge.cost);
+		}
+		if (m_nodes[id].cluster == goal_cluster && m_goalCosts[id] != INFINITY)
+		{
+			relax(goal_id, m_goalCosts[id]);
+		}
+	}
+
+	for (const auto node : m_clusterNodes[goal_cluster])
+	{
+		m_goalCosts[node] = INFINITY;
+	}
+
+	if (!found)
+	{
+		return false;
+	}
+
+	for (auto id = goal_id; id != -1; id = m_records[id].parent)
+	{
+		path.waypoints.push_back(tile_of(id));
+	}
+	std::reverse(path.waypoints.begin(), path.waypoints.end());
+	path.cost = m_records[goal_id].g;
+	return true;
+}
+
+bool HierarchicalPathFinder::RefineNext(HierarchicalPath& path, std::vector<glm::ivec2>& tiles)
+{
+	tiles.clear();
+	while (!path.IsComplete())
+	{
+		const auto from = path.waypoints[path.next];
+		const auto to = path.waypoints[path.next + 1];
+		++path.next;
+		if (from == to)
+		{
+			continue;
+		}
+
+		const auto to_tile = to.y * m_cols + to.x;
+		if (m_costs[to_tile] == TileGrid::BLOCKED)
+		{
+			return false;
+		}
+
+		// crossing a border is a single straight step, the leg goes on into the next cluster
+		const auto cluster = GetCluster(from.x, from.y);
+		if (cluster != GetCluster(to.x, to.y))
+		{
+			tiles.push_back(to);
+			continue;
+		}
+
+		SearchCluster(cluster, from.y * m_cols + from.x, false, &to_tile, 1, m_localSearch);
+		if (GetLocalCost(cluster, to_tile, m_localSearch) == INFINITY)
+		{
+			return false;
+		}
+
+		const auto first = tiles.size();
+		const auto min = GetClusterMin(cluster);
+		for (auto local = GetLocalIndex(cluster, to_tile); local != -1; local = m_localSearch.parent[local])
+		{
+			tiles.emplace_back(min.x + local % (m_clusterSize + 2) - 1, min.y + local / (m_clusterSize + 2) - 1);
+		}
+		// the parent chain ends on the leg's first tile, which the caller already stands on
+		tiles.pop_back();
+		std::reverse(tiles.begin() + static_cast<std::ptrdiff_t>(first), tiles.end());
+		return true;
+	}
+
+	return !tiles.empty();
+}
+
+bool HierarchicalPathFinder::FindPath(const glm::ivec2 start, const glm::ivec2 goal, std::vector<glm::ivec2>& tiles)
+{
+	tiles.clear();
+	HierarchicalPath path;
+	if (!FindAbstractPath(start, goal, path))
+	{
+		return false;
+	}
+
+	tiles.push_back(start);
+	std::vector<glm::ivec2> leg;
+	while (RefineNext(path, leg))
+	{
+		tiles.insert(tiles.end(), leg.begin(), leg.end());
+	}
+	return path.IsComplete();
+}
+
+int HierarchicalPathFinder::GetClusterSize() const
+{
+	return m_clusterSize;
+}
+
+int HierarchicalPathFinder::GetNodeCount() const
+{
+	return static_cast<int>(m_nodes.size() - m_freeNodes.size());
+}
+
+int HierarchicalPathFinder::GetEdgeCount() const
+{
+	auto count = 0;
+	for (const auto& node : m_nodes)
+	{
+		count += static_cast<int>(node.edges.size());
+	}
+	return count;
+}
+
+int HierarchicalPathFinder::GetCluster(const int x, const int y) const
+{
+	return (y / m_clusterSize) * m_clusterCols + x / m_clusterSize;
+}
+
+glm::ivec2 HierarchicalPathFinder::GetClusterMin(const int cluster) const
+{
+	return { (cluster % m_clusterCols) * m_clusterSize, (cluster / m_clusterCols) * m_clusterSize };
+}
+
+glm::ivec2 HierarchicalPathFinder::GetClusterMax(const int cluster) const
+{
+	const auto min = GetClusterMin(cluster);
+	return { std::min(min.x + m_clusterSize, m_cols), std::min(min.y + m_clusterSize, m_rows) };
+}
+
+int HierarchicalPathFinder::GetLocalIndex(const int cluster, const int tile) const
+{
+	const auto min = GetClusterMin(cluster);
+	return (tile / m_cols - min.y + 1) * (m_clusterSize + 2) + tile % m_cols - min.x + 1;
+}
+
+int HierarchicalPathFinder::AddNode(const int tile, const int cluster, const Side side)
+{
+	int node;
+	if (!m_freeNodes.empty())
+	{
+		node = m_freeNodes.back();
+		m_freeNodes.pop_back();
+	}
+	else
+	{
+		node = static_cast<int>(m_nodes.size());
+		m_nodes.emplace_back();
+	}
+
+	m_nodes[node].tile = tile;
+	m_nodes[node].cluster = cluster;
+	m_nodes[node].side = side;
+	m_nodes[node].free = false;
+	m_nodes[node].edges.clear();
+	m_clusterNodes[cluster].push_back(node);
+	return node;
+}
+
+void HierarchicalPathFinder::RemoveNode(const int node)
+{
+	auto& removed = m_nodes[node];
+	auto points_at_node = [node](const Edge& edge) { return edge.to == node; };
+
+	// the partner across the border, and the other entrances of the cluster
+	for (const auto& edge : removed.edges)
+	{
+		auto& edges = m_nodes[edge.to].edges;
+		edges.erase(std::remove_if(edges.begin(), edges.end(), points_at_node), edges.end());
+	}
+	auto& cluster_nodes = m_clusterNodes[removed.cluster];
+	for (const auto other : cluster_nodes)
+	{
+		auto& edges = m_nodes[other].edges;
+		edges.erase(std::remove_if(edges.begin(), edges.end(), points_at_node), edges.end());
+	}
+	cluster_nodes.erase(std::remove(cluster_nodes.begin(), cluster_nodes.end(), node), cluster_nodes.end());
+
+	removed.edges.clear();
+	removed.free = true;
+	removed.cluster = -1;
+	m_freeNodes.push_back(node);
+}
+
+void HierarchicalPathFinder::BuildBorder(const int cluster, const Side side)
+{
+	const auto min = GetClusterMin(cluster);
+	const auto max = GetClusterMax(cluster);
+	const auto east = side == EAST;
+	if ((east && max.x >= m_cols) || (!east && max.y >= m_rows))
+	{
+		return;
+	}
+
+	const auto neighbour = east ? cluster + 1 : cluster + m_clusterCols;
+	const auto opposite = east ? WEST : NORTH;
+
+	// drop the old entrances on both sides of the border
+	auto& old_nodes = m_oldNodes;
+	old_nodes.clear();
+	for (const auto node : m_clusterNodes[cluster])
+	{
+		if (m_nodes[node].side == side)
+		{
+			old_nodes.push_back(node);
+		}
+	}
+	for (const auto node : m_clusterNodes[neighbour])
+	{
+		if (m_nodes[node].side == opposite)
+		{
+			old_nodes.push_back(node);
+		}
+	}
+	for (const auto node : old_nodes)
+	{
+		RemoveNode(node);
+	}
+
+	// tile pairs across the border, walked along it
+	const auto length = east ? max.y - min.y : max.x - min.x;
+	auto tile_at = [&](const int i)
+	{
+		return east ? (min.y + i) * m_cols + max.x - 1 : (max.y - 1) * m_cols + min.x + i;
+	};
+	const auto across = east ? 1 : m_cols;
+
+	auto add_entrance = [&](const int i)
+	{
+		const auto inside = tile_at(i);
+		const auto outside = inside + across;
+		const auto inside_node = AddNode(inside, cluster, side);
+		const auto outside_node = AddNode(outside, neighbour, opposite);
+		m_nodes[inside_node].edges.push_back({ outside_node, static_cast<float>(m_costs[outside]) });
+		m_nodes[outside_node].edges.push_back({ inside_node, static_cast<float>(m_costs[inside]) });
+	};
+
+	auto run_start = -1;
+	for (auto i = 0; i <= length; ++i)
+	{
+		const auto open = i < length && m_costs[tile_at(i)] != TileGrid::BLOCKED && m_costs[tile_at(i) + across] != TileGrid::BLOCKED;
+		if (open && run_start == -1)
+		{
+			run_start = i;
+		}
+		else if (!open && run_start != -1)
+		{
+			const auto run_length = i - run_start;
+			if (run_length < LONG_ENTRANCE)
+			{
+				add_entrance(run_start + run_length / 2);
+			}
+			else
+			{
+				add_entrance(run_start);
+				add_entrance(i - 1);
+			}
+			run_start = -1;
+		}
+	}
+}
+
+/**
+ * \brief Links are only kept when no other entrance of the cluster lies on a best path between the two ends,
+ * the abstract search finds the same costs through that entrance with far fewer edges to relax.
+ */
+void HierarchicalPathFinder::BuildIntraEdges(const int cluster, LocalSearch& search)
+{
+	const auto& nodes = m_clusterNodes[cluster];
+	const auto count = nodes.size();
+	std::vector<int> stop_tiles;
+	for (const auto node : nodes)
+	{
+		auto& edges = m_nodes[node].edges;
+		edges.erase(std::remove_if(edges.begin(), edges.end(), [this, cluster](const Edge& edge)
+		{
+			return m_nodes[edge.to].cluster == cluster;
+		}), edges.end());
+		stop_tiles.push_back(m_nodes[node].tile);
+	}
+
+	// one search per entrance, done once every other entrance of the cluster is reached
+	std::vector<float> costs(count * count);
+	for (size_t from = 0; from < count; ++from)
+	{
+		SearchCluster(cluster, m_nodes[nodes[from]].tile, false, stop_tiles.data(), static_cast<int>(count), search);
+		for (size_t to = 0; to < count; ++to)
+		{
+			costs[from * count + to] = GetLocalCost(cluster, stop_tiles[to], search);
+		}
+	}
+
+	for (size_t from = 0; from < count; ++from)
+	{
+		for (size_t to = 0; to < count; ++to)
+		{
+			const auto cost = costs[from * count + to];
+			if (from == to || cost == INFINITY)
+			{
+				continue;
+			}
+
+			// entrances on the same tile cost nothing to pass through and never replace a link
+			auto redundant = false;
+			for (size_t via = 0; via < count && !redundant; ++via)
+			{
+				const auto first = costs[from * count + via];
+				const auto second = costs[via * count + to];
+				redundant = first > 0.0f && second > 0.0f && first + second <= cost * (1.0f + 1e-6f);
+			}
+			if (!redundant)
+			{
+				m_nodes[nodes[from]].edges.push_back({ nodes[to], cost });
+			}
+		}
+	}
+}
+
+/**
+ * \brief Moving onto a tile costs the step length times that tile's cost, as in the PathFinder.
+ * Going backwards the cost of a step is paid for the tile it leaves (which is the one the forward move enters).
+ */
+void HierarchicalPathFinder::SearchCluster(const int cluster, const int source_tile, const bool backward, const int* stop_tiles, const int stop_count, LocalSearch& search) const
+{
+	const auto width = m_clusterSize + 2;
+	const auto local_count = static_cast<size_t>(width) * width;
+	if (search.cost.size() < local_count)
+	{
+		search.tiles.resize(local_count);
+		search.cost.resize(local_count);
+		search.parent.resize(local_count);
+		search.generation.assign(local_count, 0);
+		search.stop.assign(local_count, 0);
+		search.cluster = -1;
+	}
+	if (++search.current == 0)
+	{
+		std::fill(search.generation.begin(), search.generation.end(), 0);
+		std::fill(search.stop.begin(), search.stop.end(), 0);
+		search.current = 1;
+	}
+
+	if (search.cluster != cluster)
+	{
+		const auto min = GetClusterMin(cluster);
+		const auto max = GetClusterMax(cluster);
+		std::fill(search.tiles.begin(), search.tiles.end(), TileGrid::BLOCKED);
+		for (auto y = min.y; y < max.y; ++y)
+		{
+			std::memcpy(&search.tiles[(y - min.y + 1) * width + 1], &m_costs[y * m_cols + min.x], max.x - min.x);
+		}
+		search.cluster = cluster;
+	}
+
+	int neighbour[8];
+	for (auto direction = 0; direction < 8; ++direction)
+	{
+		neighbour[direction] = OFFSET_Y[direction] * width + OFFSET_X[direction];
+	}
+
+	// the same tile can be the entrance of two borders
+	auto remaining = 0;
+	for (auto i = 0; i < stop_count; ++i)
+	{
+		const auto local = GetLocalIndex(cluster, stop_tiles[i]);
+		if (search.stop[local] != search.current)
+		{
+			search.stop[local] = search.current;
+			++remaining;
+		}
+	}
+
+	const auto source = GetLocalIndex(cluster, source_tile);
+	search.open.clear();
+	search.cost[source] = 0.0f;
+	search.parent[source] = -1;
+	search.generation[source] = search.current;
+	search.open.emplace_back(0.0f, source);
+
+	const auto tiles = search.tiles.data();
+	while (!search.open.empty())
+	{
+		std::pop_heap(search.open.begin(), search.open.end(), std::greater<>());
+		const auto [cost, local] = search.open.back();
+		search.open.pop_back();
+		if (cost > search.cost[local])
+		{
+			continue;
+		}
+		if (search.stop[local] == search.current && --remaining == 0)
+		{
+			return;
+		}
+
+		for (auto direction = 0; direction < 8; ++direction)
+		{
+			const auto next = local + neighbour[direction];
+			if (tiles[next] == TileGrid::BLOCKED ||
+				(direction >= 4 && (tiles[local + OFFSET_X[direction]] == TileGrid::BLOCKED || tiles[local + OFFSET_Y[direction] * width] == TileGrid::BLOCKED)))
+			{
+				continue;
+			}
+
+			const auto next_cost = cost + STEP[direction] * static_cast<float>(tiles[backward ? local : next]);
+			if (search.generation[next] == search.current && search.cost[next] <= next_cost)
+			{
+				continue;
+			}
+
+			search.generation[next] = search.current;
+			search.cost[next] = next_cost;
+			search.parent[next] = local;
+			search.open.emplace_back(next_cost, next);
+			std::push_heap(search.open.begin(), search.open.end(), std::greater<>());
+		}
+	}
+}
+
+float HierarchicalPathFinder::GetLocalCost(const int cluster, const int tile, const LocalSearch& search) const
+{
+	const auto local = GetLocalIndex(cluster, tile);
+	return search.generation[local] == search.current ? search.cost[local] : INFINITY;
+}
+
+void HierarchicalPathFinder::Benchmark(const int size)
+{
+	std::mt19937 generator(42);
+
+	std::cout << "------------ Hierarchical Path Finder Benchmark ----------" << std::endl;
+
+	TileGrid grid(size, size);
+	grid.FillRandom(0.2f, 7);
+
+	auto random_tile = [&]()
+	{
+		std::uniform_int_distribution<int> x(0, grid.GetCols() - 1);
+		std::uniform_int_distribution<int> y(0, grid.GetRows() - 1);
+		glm::ivec2 tile;
+		do
+		{
+			tile = glm::ivec2(x(generator), y(generator));
+		} while (!grid.IsWalkable(tile.x, tile.y));
+		return tile;
+	};
+
+	auto path_cost = [&](const std::vector<glm::ivec2>& path)
+	{
+		auto cost = 0.0;
+		for (size_t i = 1; i < path.size(); ++i)
+		{
+			const auto diagonal = path[i].x != path[i - 1].x && path[i].y != path[i - 1].y;
+			cost += (diagonal ? 1.41421356 : 1.0) * grid.GetCost(path[i].x, path[i].y);
+		}
+		return cost;
+	};
+
+	auto start = SDL_GetPerformanceCounter();
+	HierarchicalPathFinder finder;
+	finder.Build(grid);
+	std::cout << size << "x" << size << ", clusters of " << finder.GetClusterSize() << ": built in " << ElapsedMilliseconds(start)
+		<< " ms, " << finder.GetNodeCount() << " entrances, " << finder.GetEdgeCount() << " edges" << std::endl;
+
+	// long queries - the abstract path and its first leg is what an agent waits for before moving
+	constexpr auto query_count = 20;
+	std::vector<std::pair<glm::ivec2, glm::ivec2>> queries;
+	for (auto i = 0; i < query_count; ++i)
+	{
+		queries.emplace_back(random_tile(), random_tile());
+	}
+
+	HierarchicalPath abstract_path;
+	std::vector<glm::ivec2> path;
+	auto found = 0;
+	start = SDL_GetPerformanceCounter();
+	for (const auto& [from, to] : queries)
+	{
+		found += finder.FindAbstractPath(from, to, abstract_path);
+		finder.RefineNext(abstract_path, path);
+	}
+	std::cout << "  HPA* first leg: " << ElapsedMilliseconds(start) / query_count << " ms per query (" << found << "/" << query_count << " found)" << std::endl;
+
+	auto hierarchical_cost = 0.0;
+	start = SDL_GetPerformanceCounter();
+	for (const auto& [from, to] : queries)
+	{
+		finder.FindPath(from, to, path);
+		hierarchical_cost += path_cost(path);
+	}
+	std::cout << "  HPA* full path: " << ElapsedMilliseconds(start) / query_count << " ms per query" << std::endl;
+
+	PathSearchContext context;
+	context.Reserve(grid.GetTileCount());
+	auto optimal_cost = 0.0;
+	start = SDL_GetPerformanceCounter();
+	for (const auto& [from, to] : queries)
+	{
+		PathFinder::FindPath(grid, from, to, path, context, OCTILE, true);
+		optimal_cost += path_cost(path);
+	}
+	std::cout << "  A*            : " << ElapsedMilliseconds(start) / query_count << " ms per query, HPA* paths are "
+		<< (hierarchical_cost / optimal_cost - 1.0) * 100.0 << "% longer" << std::endl;
+
+	// local changes - a few tiles blocked or opened each round
+	constexpr auto update_count = 100;
+	auto rebuilt = 0;
+	start = SDL_GetPerformanceCounter();
+	for (auto i = 0; i < update_count; ++i)
+	{
+		std::uniform_int_distribution<int> x(0, grid.GetCols() - 1);
+		std::uniform_int_distribution<int> y(0, grid.GetRows() - 1);
+		const auto tile = glm::ivec2(x(generator), y(generator));
+		grid.SetCost(tile.x, tile.y, grid.IsWalkable(tile.x, tile.y) ? TileGrid::BLOCKED : 1);
+		rebuilt += finder.Update();
+	}
+	std::cout << "  single tile change: " << ElapsedMilliseconds(start) / update_count << " ms per update, "
+		<< static_cast<double>(rebuilt) / update_count << " clusters rebuilt" << std::endl;
+}
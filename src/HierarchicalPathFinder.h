@@ -0,0 +1,141 @@
+#pragma once
+#ifndef __HIERARCHICAL_PATH_FINDER__
+#define __HIERARCHICAL_PATH_FINDER__
+
+// Core Libraries
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "TileGrid.h"
+
+/**
+ * \brief Waypoints of an abstract path - the start, the cluster entrances it crosses and the goal.
+ * Consecutive waypoints are either in the same cluster or on the two sides of a cluster border.
+ */
+struct HierarchicalPath
+{
+	std::vector<glm::ivec2> waypoints;
+	// waypoint the next refinement starts from
+	size_t next = 0;
+	float cost = 0.0f;
+
+	[[nodiscard]] bool IsComplete() const { return next + 1 >= waypoints.size(); }
+};
+
+/**
+ * \brief HPA* - the grid is cut into square clusters; every open stretch of a cluster border gets one or two
+ * entrances, and the entrances of a cluster are linked by the cost of the best path between them inside it.
+ * A query connects the start and goal to the entrances of their clusters and searches that small graph;
+ * the tiles of a leg are only found (inside one cluster) when RefineNext asks for it.
+ * Update re-reads the grid and rebuilds only the clusters around changed tiles.
+ * Moves are the PathFinder's 8-way, no corner cutting moves; paths are near optimal since they
+ * cross borders at entrances only. Queries share scratch space - one query at a time.
+ */
+class HierarchicalPathFinder
+{
+public:
+	explicit HierarchicalPathFinder(int cluster_size = 32);
+	~HierarchicalPathFinder();
+
+	void Build(const TileGrid& grid);
+	// returns the number of clusters rebuilt
+	int Update();
+
+	bool FindAbstractPath(glm::ivec2 start, glm::ivec2 goal, HierarchicalPath& path);
+	// tiles of the next leg (up to the next entrance, or the goal), not including the tile the leg starts on.
+	// Returns false once the path is complete, or if the grid changed so the leg no longer exists (search again).
+	bool RefineNext(HierarchicalPath& path, std::vector<glm::ivec2>& tiles);
+	// abstract search and every leg, tiles from start to goal inclusive
+	bool FindPath(glm::ivec2 start, glm::ivec2 goal, std::vector<glm::ivec2>& tiles);
+
+	// getters
+	[[nodiscard]] int GetClusterSize() const;
+	[[nodiscard]] int GetNodeCount() const;
+	[[nodiscard]] int GetEdgeCount() const;
+
+	// build, query and update times against A* on large grids
+	static void Benchmark(int size = 2048);
+
+private:
+	// sides of a cluster
+	enum Side { EAST, SOUTH, WEST, NORTH, NO_SIDE };
+
+	struct Edge
+	{
+		int to;
+		float cost;
+	};
+
+	struct Node
+	{
+		int tile = -1;
+		int cluster = -1;
+		Side side = NO_SIDE;
+		bool free = false;
+		std::vector<Edge> edges;
+	};
+
+	// Dijkstra inside one cluster, indices local to the cluster with a blocked one tile frame around it
+	struct LocalSearch
+	{
+		// tile costs of the cluster the search last ran in, framed so neighbours need no bounds checks
+		std::vector<std::uint8_t> tiles;
+		int cluster = -1;
+		std::vector<float> cost;
+		std::vector<int> parent;
+		std::vector<std::uint32_t> generation;
+		// tiles the search stops at once they are all settled, stamped with the generation
+		std::vector<std::uint32_t> stop;
+		std::uint32_t current = 0;
+		std::vector<std::pair<float, int>> open;
+	};
+
+	struct AbstractRecord
+	{
+		std::uint32_t generation = 0;
+		bool closed = false;
+		int parent = -1;
+		float g = 0.0f;
+	};
+
+	[[nodiscard]] int GetCluster(int x, int y) const;
+	[[nodiscard]] glm::ivec2 GetClusterMin(int cluster) const;
+	[[nodiscard]] glm::ivec2 GetClusterMax(int cluster) const;
+	[[nodiscard]] int GetLocalIndex(int cluster, int tile) const;
+
+	int AddNode(int tile, int cluster, Side side);
+	void RemoveNode(int node);
+	// the border between a cluster and its east or south neighbour
+	void BuildBorder(int cluster, Side side);
+	void BuildIntraEdges(int cluster, LocalSearch& search);
+	// backward gives the cost from each tile to the source instead of from the source; stops once every stop tile settles
+	void SearchCluster(int cluster, int source_tile, bool backward, const int* stop_tiles, int stop_count, LocalSearch& search) const;
+	[[nodiscard]] float GetLocalCost(int cluster, int tile, const LocalSearch& search) const;
+
+	const TileGrid* m_pGrid;
+	std::uint32_t m_gridVersion;
+	std::vector<std::uint8_t> m_costs;
+	int m_cols;
+	int m_rows;
+	int m_clusterSize;
+	int m_clusterCols;
+	int m_clusterRows;
+
+	std::vector<std::vector<int>> m_clusterNodes;
+	std::vector<Node> m_nodes;
+	std::vector<int> m_freeNodes;
+
+	// query scratch space
+	LocalSearch m_localSearch;
+	std::vector<AbstractRecord> m_records;
+	std::vector<std::pair<float, int>> m_open;
+	std::vector<float> m_goalCosts;
+	std::vector<Edge> m_startEdges;
+	std::vector<int> m_oldNodes;
+	std::uint32_t m_generation;
+};
+
+#endif /* defined (__HIERARCHICAL_PATH_FINDER__) */
@@ -1,11 +1,14 @@
 #include "ImGuiWindowFrame.h"
+#include <algorithm>
 #include <iostream>
 #include "imgui.h"
 #include "imgui_sdl.h"
 #include "Util.h"
 
-ImGuiWindowFrame::ImGuiWindowFrame()
-= default;
+ImGuiWindowFrame::ImGuiWindowFrame() :
+	m_windowID(0), m_refreshRate(30.0f), m_lastRenderCounter(0)
+{
+}
 
 ImGuiWindowFrame::~ImGuiWindowFrame()
 = default;
@@ -25,7 +28,8 @@ void ImGuiWindowFrame::Init(const char* title, const int x, const int y, const i
 		std::cout << "ImGui window creation success" << std::endl;
 
 		// create a new SDL Renderer and store it in the Singleton
-		m_pRenderer = (Config::MakeResource(SDL_CreateRenderer(m_pWindow.get(), -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC)));
+		// no vsync - the main renderer already waits for it, a second wait would halve the frame rate
+		m_pRenderer = (Config::MakeResource(SDL_CreateRenderer(m_pWindow.get(), -1, SDL_RENDERER_ACCELERATED)));
 
 		if (GetRenderer() != nullptr) // render init success
 		{
@@ -52,6 +56,22 @@ void ImGuiWindowFrame::Init(const char* title, const int x, const int y, const i
 
 void ImGuiWindowFrame::Render()
 {
+	if (!IsVisible())
+	{
+		return;
+	}
+
+	const auto now = SDL_GetPerformanceCounter();
+	const auto elapsed = static_cast<float>(now - m_lastRenderCounter) / static_cast<float>(SDL_GetPerformanceFrequency());
+	if (m_refreshRate > 0.0f && elapsed < 1.0f / m_refreshRate)
+	{
+		return;
+	}
+
+	// ImGui animates with the time since its own last frame, not the game's (capped after the window was hidden)
+	ImGui::GetIO().DeltaTime = (m_lastRenderCounter == 0) ? 1.0f / 60.0f : std::min(elapsed, 0.1f);
+	m_lastRenderCounter = now;
+
 	SDL_SetRenderDrawColor(GetRenderer(), 255, 255, 255, 255);
 	SDL_RenderClear(GetRenderer()); // clear the renderer to the draw colour
 
@@ -130,3 +150,18 @@ Uint32 ImGuiWindowFrame::GetWindowId() const
 {
 	return m_windowID;
 }
+
+bool ImGuiWindowFrame::IsVisible() const
+{
+	return m_pWindow != nullptr && (SDL_GetWindowFlags(m_pWindow.get()) & (SDL_WINDOW_HIDDEN | SDL_WINDOW_MINIMIZED)) == 0;
+}
+
+float ImGuiWindowFrame::GetRefreshRate() const
+{
+	return m_refreshRate;
+}
+
+void ImGuiWindowFrame::SetRefreshRate(const float refresh_rate)
+{
+	m_refreshRate = refresh_rate;
+}
@@ -5,7 +5,11 @@
 #include "Config.h"
 #include <functional>
 
-/* Singleton */
+/* Singleton
+ * The debug UI lives in its own window. Its renderer doesn't wait for vsync and it is redrawn at
+ * its own (throttled) rate, so presenting it never blocks the game frame. Nothing is drawn while
+ * the window is hidden (backtick toggle).
+ */
 class ImGuiWindowFrame
 {
 public:
@@ -24,6 +28,10 @@ public:
 	[[nodiscard]] SDL_Renderer* GetRenderer() const;
 	[[nodiscard]] SDL_Window* GetWindow() const;
 	[[nodiscard]] Uint32 GetWindowId() const;
+	[[nodiscard]] bool IsVisible() const;
+	[[nodiscard]] float GetRefreshRate() const;
+	// redraws per second, 0 redraws on every game frame
+	void SetRefreshRate(float refresh_rate);
 
 	typedef std::function<void()> Callback;
 	void SetGuiFunction(const Callback& callback);
@@ -42,5 +50,8 @@ private:
 
 	Uint32 m_windowID;
 	Callback m_callback;
+
+	float m_refreshRate;
+	Uint64 m_lastRenderCounter;
 };
 #endif /* defined (__IMGUI_WINDOW_FRAME__) */
@@ -0,0 +1,109 @@
+#include "JumpPointTable.h"
+#include <algorithm>
+
+namespace
+{
+	constexpr int DIRECTION_X[JumpPointTable::DIRECTION_COUNT] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	constexpr int DIRECTION_Y[JumpPointTable::DIRECTION_COUNT] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+
+	// one more tile travelled than the jump from the next tile
+	std::int16_t Extend(const int next_distance)
+	{
+		return static_cast<std::int16_t>(std::clamp(next_distance > 0 ? next_distance + 1 : next_distance - 1, -32767, 32767));
+	}
+}
+
+JumpPointTable::JumpPointTable() : m_pGrid(nullptr), m_gridVersion(0)
+{
+}
+
+JumpPointTable::~JumpPointTable()
+= default;
+
+/**
+ * \brief Every direction is swept against its travel direction, so the jump from the next tile is
+ * always known when a tile is reached. Straight directions go first because a diagonal jump stops
+ * where a straight jump from the tile would find a jump point.
+ */
+void JumpPointTable::Build(const TileGrid& grid)
+{
+	m_pGrid = &grid;
+	m_gridVersion = grid.GetVersion();
+	m_distances.assign(static_cast<size_t>(grid.GetTileCount()) * DIRECTION_COUNT, 0);
+
+	const auto cols = grid.GetCols();
+	const auto rows = grid.GetRows();
+
+	for (auto direction = 0; direction < DIRECTION_COUNT; ++direction)
+	{
+		const auto dx = DIRECTION_X[direction];
+		const auto dy = DIRECTION_Y[direction];
+		const auto diagonal = dx != 0 && dy != 0;
+		// the straight components of a diagonal
+		const auto direction_x = dx > 0 ? 0 : 2;
+		const auto direction_y = dy > 0 ? 1 : 3;
+
+		for (auto row_step = 0; row_step < rows; ++row_step)
+		{
+			const auto y = dy > 0 ? rows - 1 - row_step : row_step;
+			for (auto col_step = 0; col_step < cols; ++col_step)
+			{
+				const auto x = dx > 0 ? cols - 1 - col_step : col_step;
+				if (!grid.IsWalkable(x, y))
+				{
+					continue;
+				}
+
+				const auto next_x = x + dx;
+				const auto next_y = y + dy;
+				auto& distance = m_distances[static_cast<size_t>(grid.GetIndex(x, y)) * DIRECTION_COUNT + direction];
+
+				if (!grid.IsWalkable(next_x, next_y) || (diagonal && (!grid.IsWalkable(next_x, y) || !grid.IsWalkable(x, next_y))))
+				{
+					distance = 0;
+					continue;
+				}
+
+				const auto next_index = grid.GetIndex(next_x, next_y);
+				const auto is_jump_point = diagonal ?
+					GetDistance(next_index, direction_x) > 0 || GetDistance(next_index, direction_y) > 0 :
+					HasForcedNeighbour(grid, next_x, next_y, dx, dy);
+
+				distance = is_jump_point ? 1 : Extend(GetDistance(next_index, direction));
+			}
+		}
+	}
+}
+
+bool JumpPointTable::HasForcedNeighbour(const TileGrid& grid, const int x, const int y, const int dx, const int dy)
+{
+	if (dx != 0)
+	{
+		return (grid.IsWalkable(x, y - 1) && !grid.IsWalkable(x - dx, y - 1)) ||
+			(grid.IsWalkable(x, y + 1) && !grid.IsWalkable(x - dx, y + 1));
+	}
+	return (grid.IsWalkable(x - 1, y) && !grid.IsWalkable(x - 1, y - dy)) ||
+		(grid.IsWalkable(x + 1, y) && !grid.IsWalkable(x + 1, y - dy));
+}
+
+int JumpPointTable::GetDirection(const int dx, const int dy)
+{
+	// indexed by (dy + 1) * 3 + dx + 1
+	constexpr int directions[9] = { 6, 3, 7, 2, -1, 0, 5, 1, 4 };
+	return directions[(dy + 1) * 3 + dx + 1];
+}
+
+bool JumpPointTable::IsBuiltFrom(const TileGrid& grid) const
+{
+	return m_pGrid == &grid && m_gridVersion == grid.GetVersion();
+}
+
+const TileGrid* JumpPointTable::GetGrid() const
+{
+	return m_pGrid;
+}
+
+size_t JumpPointTable::GetMemoryUsage() const
+{
+	return m_distances.size() * sizeof(std::int16_t);
+}
@@ -0,0 +1,46 @@
+#pragma once
+#ifndef __JUMP_POINT_TABLE__
+#define __JUMP_POINT_TABLE__
+
+// Core Libraries
+#include <cstdint>
+#include <vector>
+
+#include "TileGrid.h"
+
+/**
+ * \brief Precomputed jump distances for JPS+ on a static map.
+ * For every tile and each of the 8 directions it stores how far a jump travels: a positive distance
+ * ends on a jump point, zero or a negative distance is the number of open tiles before a wall.
+ * Built in one sweep per direction; a search then never scans the grid, it only reads the table.
+ * The table belongs to the grid version it was built from and has to be rebuilt after any change.
+ */
+class JumpPointTable
+{
+public:
+	// directions in the same order as PathFinder's neighbour offsets: E, S, W, N, SE, SW, NW, NE
+	static constexpr int DIRECTION_COUNT = 8;
+
+	JumpPointTable();
+	~JumpPointTable();
+
+	void Build(const TileGrid& grid);
+
+	// a tile entered travelling straight is a jump point when a tile beside it can only be reached through it
+	[[nodiscard]] static bool HasForcedNeighbour(const TileGrid& grid, int x, int y, int dx, int dy);
+	[[nodiscard]] static int GetDirection(int dx, int dy);
+
+	// getters
+	[[nodiscard]] bool IsBuiltFrom(const TileGrid& grid) const;
+	[[nodiscard]] const TileGrid* GetGrid() const;
+	[[nodiscard]] int GetDistance(int index, int direction) const { return m_distances[static_cast<size_t>(index) * DIRECTION_COUNT + direction]; }
+	[[nodiscard]] size_t GetMemoryUsage() const;
+
+private:
+	const TileGrid* m_pGrid;
+	std::uint32_t m_gridVersion;
+	// [tile][direction]
+	std::vector<std::int16_t> m_distances;
+};
+
+#endif /* defined (__JUMP_POINT_TABLE__) */
@@ -1,21 +1,18 @@
 #include "Label.h"
-#include "TextureManager.h"
+#include "Renderer.h"
 
 Label::Label(const std::string& text, const std::string& font_name, const int font_size, const SDL_Color colour, const glm::vec2 position, const int font_style, const bool is_centered):
-	m_fontColour(colour), m_fontName(font_name), m_text(text), m_isCentered(is_centered), m_fontSize(font_size), m_fontStyle(font_style)
+	m_fontColour(colour), m_fontName(font_name), m_text(text), m_isCentered(is_centered), m_fontSize(font_size), m_fontStyle(font_style),
+	m_pGlyphAtlas(nullptr), m_atlasGeneration(0)
 {
 	m_fontPath = "../Assets/fonts/" + font_name + ".ttf";
 
 	BuildFontID();
 
-	// Load font, convert Label String to Texture and store in TextureManager
+	// Load font and build the glyph quads for the Label String
 	FontManager::Instance().Load(m_fontPath, m_fontID, font_size, font_style);
-	FontManager::Instance().TextToTexture(text, m_fontID, m_fontID, colour);
-
-	// set Size of Label Object based on computed Texture Size 
-	const auto size = TextureManager::Instance().GetTextureSize(m_fontID);
-	SetWidth(static_cast<int>(size.x));
-	SetHeight(static_cast<int>(size.y));
+	m_pGlyphAtlas = FontManager::Instance().GetGlyphAtlas(m_fontID);
+	BuildGeometry();
 
 	// set the position of the Label 
 	GetTransform()->position = position;
@@ -26,8 +23,35 @@ Label::~Label()
 
 void Label::Draw()
 {
+	if (m_pGlyphAtlas == nullptr || m_indices.empty())
+	{
+		return;
+	}
+
+	// the atlas grew since the quads were built, their texture coordinates are stale
+	if (m_atlasGeneration != m_pGlyphAtlas->GetGeneration())
+	{
+		BuildGeometry();
+	}
+
+	auto offset = GetTransform()->position;
+	if (m_isCentered)
+	{
+		offset.x -= static_cast<float>(static_cast<int>(GetWidth() * 0.5));
+		offset.y -= static_cast<float>(static_cast<int>(GetHeight() * 0.5));
+	}
+
+	m_vertices.resize(m_localVertices.size());
+	for (size_t i = 0; i < m_localVertices.size(); ++i)
+	{
+		m_vertices[i] = m_localVertices[i];
+		m_vertices[i].position.x += offset.x;
+		m_vertices[i].position.y += offset.y;
+	}
+
 	// draw the label
-	TextureManager::Instance().DrawText(m_fontID, GetTransform()->position, 0, 255, m_isCentered);
+	Renderer::Instance().DrawGeometry(m_pGlyphAtlas->GetTexture(),
+		m_vertices.data(), static_cast<int>(m_vertices.size()), m_indices.data(), static_cast<int>(m_indices.size()));
 }
 
 void Label::Update()
@@ -45,23 +69,24 @@ void Label::Clean()
 void Label::SetText(const std::string& new_text)
 {
 	m_text = new_text;
-	BuildFontID();
-
-	FontManager::Instance().Load(m_fontPath, m_fontID, m_fontSize, m_fontStyle);
-	FontManager::Instance().TextToTexture(new_text, m_fontID, m_fontID, m_fontColour);
-	const auto size = TextureManager::Instance().GetTextureSize(m_fontID);
-	SetWidth(static_cast<int>(size.x));
-	SetHeight(static_cast<int>(size.y));
+	BuildGeometry();
+	InvalidateLayerCache();
 }
 
 /**
  * \brief This function sets the colour value of the Label
  * \param new_colour 
  */
-void Label::SetColour(const SDL_Color new_colour) const
+void Label::SetColour(const SDL_Color new_colour)
 {
-	FontManager::Instance().Load(m_fontPath, m_fontID, m_fontSize, m_fontStyle);
-	FontManager::Instance().TextToTexture(m_text, m_fontID, m_fontID, new_colour);
+	m_fontColour = new_colour;
+
+	// colour is per vertex, nothing else changes
+	for (auto& vertex : m_localVertices)
+	{
+		vertex.color = new_colour;
+	}
+	InvalidateLayerCache();
 }
 
 /**
@@ -74,15 +99,15 @@ void Label::SetSize(const int new_size)
 
 	BuildFontID();
 	
-	FontManager::Instance().Load(m_fontPath, m_fontID, m_fontSize, TTF_STYLE_NORMAL);
-	FontManager::Instance().TextToTexture(m_text, m_fontID, m_fontID, m_fontColour);
-	const auto size = TextureManager::Instance().GetTextureSize(m_fontID);
-	SetWidth(static_cast<int>(size.x));
-	SetHeight(static_cast<int>(size.y));
+	FontManager::Instance().Load(m_fontPath, m_fontID, m_fontSize, m_fontStyle);
+	m_pGlyphAtlas = FontManager::Instance().GetGlyphAtlas(m_fontID);
+	BuildGeometry();
+	InvalidateLayerCache();
 }
 
 /**
- * \brief Private function that builds a font id to be used with TextureManager
+ * \brief Private function that builds a font id to be used with FontManager
+ * Labels with the same font, size and style share the font and its glyph atlas
  */
 void Label::BuildFontID()
 {
@@ -90,6 +115,25 @@ void Label::BuildFontID()
 	m_fontID += "-";
 	m_fontID += std::to_string(m_fontSize);
 	m_fontID += "-";
-	m_fontID += m_text;
+	m_fontID += std::to_string(m_fontStyle);
 }
 
+/**
+ * \brief Private function that rebuilds the glyph quads and resizes the Label to fit the text
+ */
+void Label::BuildGeometry()
+{
+	m_localVertices.clear();
+	m_indices.clear();
+
+	if (m_pGlyphAtlas == nullptr)
+	{
+		return;
+	}
+
+	const auto size = m_pGlyphAtlas->BuildQuads(m_text, m_fontColour, m_localVertices, m_indices);
+	m_atlasGeneration = m_pGlyphAtlas->GetGeneration();
+
+	SetWidth(static_cast<int>(size.x));
+	SetHeight(static_cast<int>(size.y));
+}
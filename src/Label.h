@@ -3,12 +3,15 @@
 #define __LABEL__
 
 #include <string>
+#include <vector>
 
 #include "UIControl.h"
 #include "FontManager.h"
 
 /**
  * \brief Label Class - Inherits from UIControl
+ * Text is drawn as one batch of glyph quads from the font's GlyphAtlas, so changing
+ * the text or colour rebuilds vertices instead of creating textures.
  */
 class Label final : public UIControl
 {
@@ -23,7 +26,7 @@ public:
 
 	// Mutator Functions 
 	void SetText(const std::string& new_text);
-	void SetColour(SDL_Color new_colour) const;
+	void SetColour(SDL_Color new_colour);
 	void SetSize(int new_size);
 
 private:
@@ -37,8 +40,16 @@ private:
 	int m_fontSize;
 	int m_fontStyle;
 
+	// glyph quads relative to the top left of the text, and the same quads moved to the label position
+	GlyphAtlas* m_pGlyphAtlas;
+	int m_atlasGeneration;
+	std::vector<SDL_Vertex> m_localVertices;
+	std::vector<SDL_Vertex> m_vertices;
+	std::vector<int> m_indices;
+
 	// private functions
 	void BuildFontID();
+	void BuildGeometry();
 };
 
 #endif /* defined (__LABEL__) */
\ No newline at end of file
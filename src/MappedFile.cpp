@@ -0,0 +1,152 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile() :
+	m_pData(nullptr), m_size(0), m_fileHandle(INVALID_HANDLE_VALUE), m_mappingHandle(nullptr)
+{
+}
+
+bool MappedFile::Open(const std::string& file_name)
+{
+	Close();
+
+	m_fileHandle = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (m_fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER file_size;
+	// empty files can't be mapped
+	if (!GetFileSizeEx(m_fileHandle, &file_size) || file_size.QuadPart == 0)
+	{
+		Close();
+		return false;
+	}
+
+	m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_mappingHandle == nullptr)
+	{
+		Close();
+		return false;
+	}
+
+	m_pData = static_cast<const unsigned char*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if (m_pData == nullptr)
+	{
+		Close();
+		return false;
+	}
+
+	m_size = static_cast<size_t>(file_size.QuadPart);
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_pData != nullptr)
+	{
+		UnmapViewOfFile(m_pData);
+		m_pData = nullptr;
+	}
+
+	if (m_mappingHandle != nullptr)
+	{
+		CloseHandle(m_mappingHandle);
+		m_mappingHandle = nullptr;
+	}
+
+	if (m_fileHandle != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(m_fileHandle);
+		m_fileHandle = INVALID_HANDLE_VALUE;
+	}
+
+	m_size = 0;
+}
+
+#else
+
+MappedFile::MappedFile() :
+	m_pData(nullptr), m_size(0)
+{
+}
+
+bool MappedFile::Open(const std::string& file_name)
+{
+	Close();
+
+	const auto file_descriptor = open(file_name.c_str(), O_RDONLY);
+	if (file_descriptor < 0)
+	{
+		return false;
+	}
+
+	struct stat file_status{};
+	// empty files can't be mapped
+	if (fstat(file_descriptor, &file_status) != 0 || file_status.st_size == 0)
+	{
+		close(file_descriptor);
+		return false;
+	}
+
+	const auto size = static_cast<size_t>(file_status.st_size);
+	const auto data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+	// the mapping keeps its own reference to the file
+	close(file_descriptor);
+
+	if (data == MAP_FAILED)
+	{
+		return false;
+	}
+
+	m_pData = static_cast<const unsigned char*>(data);
+	m_size = size;
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_pData != nullptr)
+	{
+		munmap(const_cast<unsigned char*>(m_pData), m_size);
+		m_pData = nullptr;
+	}
+
+	m_size = 0;
+}
+
+#endif /* defined (_WIN32) */
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+const unsigned char* MappedFile::GetData() const
+{
+	return m_pData;
+}
+
+size_t MappedFile::GetSize() const
+{
+	return m_size;
+}
+
+bool MappedFile::IsOpen() const
+{
+	return m_pData != nullptr;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#ifndef __MAPPED_FILE__
+#define __MAPPED_FILE__
+
+#include <cstddef>
+#include <string>
+
+/**
+ * \brief Read-only memory mapping of a whole file.
+ * The contents stay valid until Close is called or the object is destroyed.
+ */
+class MappedFile
+{
+public:
+	MappedFile();
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool Open(const std::string& file_name);
+	void Close();
+
+	// getters
+	[[nodiscard]] const unsigned char* GetData() const;
+	[[nodiscard]] size_t GetSize() const;
+	[[nodiscard]] bool IsOpen() const;
+
+private:
+	const unsigned char* m_pData;
+	size_t m_size;
+
+#ifdef _WIN32
+	void* m_fileHandle;
+	void* m_mappingHandle;
+#endif
+};
+
+#endif /* defined (__MAPPED_FILE__) */
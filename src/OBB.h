@@ -0,0 +1,103 @@
+#pragma once
+#ifndef __OBB__
+#define __OBB__
+
+#include <glm/vec2.hpp>
+#include <cmath>
+
+#include "AABB.h"
+
+/**
+ * \brief Oriented bounding box. The world space corners, axes and enclosing AABB are cached and only
+ * rebuilt by Update when the position, angle, size or anchor they were built from changes.
+ * The box rotates about the object's position, as objects are drawn.
+ */
+struct OBB
+{
+	// world space corners in right winding order (TL, TR, BR, BL before rotation)
+	glm::vec2 corners[4];
+	// unit edge directions - the only two separating axes a box can contribute
+	glm::vec2 axes[2] = { glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, 1.0f) };
+	AABB bounds;
+
+	// rebuilds the cache if any input differs from the last call, returns true if it did
+	bool Update(const glm::vec2 position, const float width, const float height, const float angle, const bool centered)
+	{
+		if (m_valid && position == m_position && angle == m_angle && width == m_width && height == m_height && centered == m_centered)
+		{
+			return false;
+		}
+
+		m_valid = true;
+		m_position = position;
+		m_angle = angle;
+		m_width = width;
+		m_height = height;
+		m_centered = centered;
+
+		const auto top_left = centered ? glm::vec2(-width * 0.5f, -height * 0.5f) : glm::vec2(0.0f, 0.0f);
+		const glm::vec2 local[4] = {
+			top_left,
+			top_left + glm::vec2(width, 0.0f),
+			top_left + glm::vec2(width, height),
+			top_left + glm::vec2(0.0f, height) };
+
+		// one sin and cos per rebuild, shared by all four corners
+		const float radians = angle * 0.0174532925f;
+		const float s = std::sin(radians);
+		const float c = std::cos(radians);
+		axes[0] = glm::vec2(c, s);
+		axes[1] = glm::vec2(-s, c);
+
+		bounds = AABB(glm::vec2(INFINITY, INFINITY), glm::vec2(-INFINITY, -INFINITY));
+		for (int i = 0; i < 4; ++i)
+		{
+			corners[i] = position + axes[0] * local[i].x + axes[1] * local[i].y;
+			bounds.min = glm::vec2(std::min(bounds.min.x, corners[i].x), std::min(bounds.min.y, corners[i].y));
+			bounds.max = glm::vec2(std::max(bounds.max.x, corners[i].x), std::max(bounds.max.y, corners[i].y));
+		}
+		return true;
+	}
+
+	/**
+	 * \brief Separating axis test. Two convex boxes are disjoint if and only if their projections
+	 * are disjoint on one of the four edge axes. Touching boxes do not overlap.
+	 */
+	[[nodiscard]] bool Overlaps(const OBB& other) const
+	{
+		const glm::vec2 test_axes[4] = { axes[0], axes[1], other.axes[0], other.axes[1] };
+		for (const auto axis : test_axes)
+		{
+			float min1, max1, min2, max2;
+			Project(axis, min1, max1);
+			other.Project(axis, min2, max2);
+			if (max1 <= min2 || max2 <= min1)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void Project(const glm::vec2 axis, float& min_projection, float& max_projection) const
+	{
+		min_projection = max_projection = corners[0].x * axis.x + corners[0].y * axis.y;
+		for (int i = 1; i < 4; ++i)
+		{
+			const float projection = corners[i].x * axis.x + corners[i].y * axis.y;
+			min_projection = std::min(min_projection, projection);
+			max_projection = std::max(max_projection, projection);
+		}
+	}
+
+private:
+	// inputs of the cached corners
+	glm::vec2 m_position = glm::vec2(0.0f, 0.0f);
+	float m_angle = 0.0f;
+	float m_width = 0.0f;
+	float m_height = 0.0f;
+	bool m_centered = false;
+	bool m_valid = false;
+};
+
+#endif /* defined (__OBB__) */
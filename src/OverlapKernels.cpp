@@ -0,0 +1,449 @@
+#include "OverlapKernels.h"
+#include <cmath>
+#include <iostream>
+#include <SDL.h>
+#include "CollisionManager.h"
+#include "Util.h"
+
+#if defined(__AVX2__)
+#define OVERLAP_KERNELS_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OVERLAP_KERNELS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace
+{
+	double ElapsedMilliseconds(const Uint64 start)
+	{
+		return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+	}
+
+	int CountTrailingZeros(const unsigned int mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return static_cast<int>(index);
+#else
+		return __builtin_ctz(mask);
+#endif
+	}
+
+	// writes base + the index of every set bit of mask to out
+	int EmitMask(unsigned int mask, const int base, int* out)
+	{
+		auto count = 0;
+		while (mask != 0)
+		{
+			out[count++] = base + CountTrailingZeros(mask);
+			mask &= mask - 1;
+		}
+		return count;
+	}
+
+#if defined(OVERLAP_KERNELS_AVX2)
+	typedef __m256 Lane;
+	constexpr int LANE_WIDTH = 8;
+	Lane Load(const float* values) { return _mm256_loadu_ps(values); }
+	Lane Splat(const float value) { return _mm256_set1_ps(value); }
+	Lane LessEqual(const Lane a, const Lane b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+	Lane And(const Lane a, const Lane b) { return _mm256_and_ps(a, b); }
+	Lane Add(const Lane a, const Lane b) { return _mm256_add_ps(a, b); }
+	Lane Sub(const Lane a, const Lane b) { return _mm256_sub_ps(a, b); }
+	Lane Mul(const Lane a, const Lane b) { return _mm256_mul_ps(a, b); }
+	Lane Max(const Lane a, const Lane b) { return _mm256_max_ps(a, b); }
+	unsigned int Mask(const Lane lane) { return static_cast<unsigned int>(_mm256_movemask_ps(lane)); }
+#elif defined(OVERLAP_KERNELS_SSE2)
+	typedef __m128 Lane;
+	constexpr int LANE_WIDTH = 4;
+	Lane Load(const float* values) { return _mm_loadu_ps(values); }
+	Lane Splat(const float value) { return _mm_set1_ps(value); }
+	Lane LessEqual(const Lane a, const Lane b) { return _mm_cmple_ps(a, b); }
+	Lane And(const Lane a, const Lane b) { return _mm_and_ps(a, b); }
+	Lane Add(const Lane a, const Lane b) { return _mm_add_ps(a, b); }
+	Lane Sub(const Lane a, const Lane b) { return _mm_sub_ps(a, b); }
+	Lane Mul(const Lane a, const Lane b) { return _mm_mul_ps(a, b); }
+	Lane Max(const Lane a, const Lane b) { return _mm_max_ps(a, b); }
+	unsigned int Mask(const Lane lane) { return static_cast<unsigned int>(_mm_movemask_ps(lane)); }
+#endif
+
+	// scalar kernels - the tail of the SIMD loops, the whole loop on other architectures and the benchmark baseline.
+	// the index is always written and the count only advanced on a hit, which keeps the loops branch free
+
+	int ScalarBoxBoxes(const AABB& box, const OverlapKernels::BoxArrays& boxes, const int begin, const int end, int* out)
+	{
+		auto count = 0;
+		for (auto i = begin; i < end; ++i)
+		{
+			out[count] = i;
+			count += (boxes.min_x[i] <= box.max.x) & (boxes.max_x[i] >= box.min.x) &
+				(boxes.min_y[i] <= box.max.y) & (boxes.max_y[i] >= box.min.y);
+		}
+		return count;
+	}
+
+	int ScalarCircleCircles(const glm::vec2 centre, const float radius, const OverlapKernels::CircleArrays& circles,
+		const int begin, const int end, int* out)
+	{
+		auto count = 0;
+		for (auto i = begin; i < end; ++i)
+		{
+			const auto dx = circles.x[i] - centre.x;
+			const auto dy = circles.y[i] - centre.y;
+			const auto radii = circles.radius[i] + radius;
+			out[count] = i;
+			count += (dx * dx + dy * dy) <= radii * radii;
+		}
+		return count;
+	}
+
+	int ScalarCircleBoxes(const glm::vec2 centre, const float radius, const OverlapKernels::BoxArrays& boxes,
+		const int begin, const int end, int* out)
+	{
+		auto count = 0;
+		for (auto i = begin; i < end; ++i)
+		{
+			// distance from the centre to the closest point of the box on each axis
+			const auto dx = std::max(std::max(boxes.min_x[i] - centre.x, centre.x - boxes.max_x[i]), 0.0f);
+			const auto dy = std::max(std::max(boxes.min_y[i] - centre.y, centre.y - boxes.max_y[i]), 0.0f);
+			out[count] = i;
+			count += (dx * dx + dy * dy) <= radius * radius;
+		}
+		return count;
+	}
+
+	// a GameObject that only carries bounds, for timing AABBCheck
+	class BenchmarkObject final : public GameObject
+	{
+	public:
+		void Draw() override {}
+		void Update() override {}
+		void Clean() override {}
+	};
+}
+
+void OverlapKernels::BoxArrays::Add(const AABB& aabb)
+{
+	min_x.push_back(aabb.min.x);
+	min_y.push_back(aabb.min.y);
+	max_x.push_back(aabb.max.x);
+	max_y.push_back(aabb.max.y);
+}
+
+void OverlapKernels::BoxArrays::Set(const int index, const AABB& aabb)
+{
+	min_x[index] = aabb.min.x;
+	min_y[index] = aabb.min.y;
+	max_x[index] = aabb.max.x;
+	max_y[index] = aabb.max.y;
+}
+
+void OverlapKernels::BoxArrays::Resize(const int count)
+{
+	min_x.resize(count);
+	min_y.resize(count);
+	max_x.resize(count);
+	max_y.resize(count);
+}
+
+void OverlapKernels::BoxArrays::Clear()
+{
+	Resize(0);
+}
+
+int OverlapKernels::BoxArrays::Size() const
+{
+	return static_cast<int>(min_x.size());
+}
+
+void OverlapKernels::CircleArrays::Add(const glm::vec2 centre, const float circle_radius)
+{
+	x.push_back(centre.x);
+	y.push_back(centre.y);
+	radius.push_back(circle_radius);
+}
+
+void OverlapKernels::CircleArrays::Set(const int index, const glm::vec2 centre, const float circle_radius)
+{
+	x[index] = centre.x;
+	y[index] = centre.y;
+	radius[index] = circle_radius;
+}
+
+void OverlapKernels::CircleArrays::Resize(const int count)
+{
+	x.resize(count);
+	y.resize(count);
+	radius.resize(count);
+}
+
+void OverlapKernels::CircleArrays::Clear()
+{
+	Resize(0);
+}
+
+int OverlapKernels::CircleArrays::Size() const
+{
+	return static_cast<int>(x.size());
+}
+
+int OverlapKernels::BoxBoxes(const AABB& box, const BoxArrays& boxes, std::vector<int>& hits)
+{
+	// reserve room for every entry up front and trim afterwards, so hits are written without push_back
+	const auto count = boxes.Size();
+	const auto first = hits.size();
+	hits.resize(first + count);
+	int* out = hits.data() + first;
+
+	auto hit_count = 0;
+	auto i = 0;
+#if defined(OVERLAP_KERNELS_AVX2) || defined(OVERLAP_KERNELS_SSE2)
+	const auto box_min_x = Splat(box.min.x);
+	const auto box_min_y = Splat(box.min.y);
+	const auto box_max_x = Splat(box.max.x);
+	const auto box_max_y = Splat(box.max.y);
+	for (; i + LANE_WIDTH <= count; i += LANE_WIDTH)
+	{
+		const auto overlap_x = And(LessEqual(Load(&boxes.min_x[i]), box_max_x), LessEqual(box_min_x, Load(&boxes.max_x[i])));
+		const auto overlap_y = And(LessEqual(Load(&boxes.min_y[i]), box_max_y), LessEqual(box_min_y, Load(&boxes.max_y[i])));
+		hit_count += EmitMask(Mask(And(overlap_x, overlap_y)), i, out + hit_count);
+	}
+#endif
+	hit_count += ScalarBoxBoxes(box, boxes, i, count, out + hit_count);
+
+	hits.resize(first + hit_count);
+	return hit_count;
+}
+
+int OverlapKernels::CircleCircles(const glm::vec2 centre, const float radius, const CircleArrays& circles, std::vector<int>& hits)
+{
+	const auto count = circles.Size();
+	const auto first = hits.size();
+	hits.resize(first + count);
+	int* out = hits.data() + first;
+
+	auto hit_count = 0;
+	auto i = 0;
+#if defined(OVERLAP_KERNELS_AVX2) || defined(OVERLAP_KERNELS_SSE2)
+	const auto centre_x = Splat(centre.x);
+	const auto centre_y = Splat(centre.y);
+	const auto circle_radius = Splat(radius);
+	for (; i + LANE_WIDTH <= count; i += LANE_WIDTH)
+	{
+		const auto dx = Sub(Load(&circles.x[i]), centre_x);
+		const auto dy = Sub(Load(&circles.y[i]), centre_y);
+		const auto radii = Add(Load(&circles.radius[i]), circle_radius);
+		const auto overlap = LessEqual(Add(Mul(dx, dx), Mul(dy, dy)), Mul(radii, radii));
+		hit_count += EmitMask(Mask(overlap), i, out + hit_count);
+	}
+#endif
+	hit_count += ScalarCircleCircles(centre, radius, circles, i, count, out + hit_count);
+
+	hits.resize(first + hit_count);
+	return hit_count;
+}
+
+int OverlapKernels::CircleBoxes(const glm::vec2 centre, const float radius, const BoxArrays& boxes, std::vector<int>& hits)
+{
+	const auto count = boxes.Size();
+	const auto first = hits.size();
+	hits.resize(first + count);
+	int* out = hits.data() + first;
+
+	auto hit_count = 0;
+	auto i = 0;
+#if defined(OVERLAP_KERNELS_AVX2) || defined(OVERLAP_KERNELS_SSE2)
+	const auto centre_x = Splat(centre.x);
+	const auto centre_y = Splat(centre.y);
+	const auto squared_radius = Splat(radius * radius);
+	const auto zero = Splat(0.0f);
+	for (; i + LANE_WIDTH <= count; i += LANE_WIDTH)
+	{
+		const auto dx = Max(Max(Sub(Load(&boxes.min_x[i]), centre_x), Sub(centre_x, Load(&boxes.max_x[i]))), zero);
+		const auto dy = Max(Max(Sub(Load(&boxes.min_y[i]), centre_y), Sub(centre_y, Load(&boxes.max_y[i]))), zero);
+		const auto overlap = LessEqual(Add(Mul(dx, dx), Mul(dy, dy)), squared_radius);
+		hit_count += EmitMask(Mask(overlap), i, out + hit_count);
+	}
+#endif
+	hit_count += ScalarCircleBoxes(centre, radius, boxes, i, count, out + hit_count);
+
+	hits.resize(first + hit_count);
+	return hit_count;
+}
+
+int OverlapKernels::BoxesBoxes(const BoxArrays& a, const BoxArrays& b, std::vector<std::pair<int, int>>& hits)
+{
+	static std::vector<int> row_hits;
+
+	auto hit_count = 0;
+	for (auto i = 0; i < a.Size(); ++i)
+	{
+		row_hits.clear();
+		const AABB box(glm::vec2(a.min_x[i], a.min_y[i]), glm::vec2(a.max_x[i], a.max_y[i]));
+		hit_count += BoxBoxes(box, b, row_hits);
+
+		for (const auto j : row_hits)
+		{
+			hits.emplace_back(i, j);
+		}
+	}
+
+	return hit_count;
+}
+
+const char* OverlapKernels::GetInstructionSet()
+{
+#if defined(OVERLAP_KERNELS_AVX2)
+	return "AVX2";
+#elif defined(OVERLAP_KERNELS_SSE2)
+	return "SSE2";
+#else
+	return "scalar";
+#endif
+}
+
+void OverlapKernels::Benchmark()
+{
+	// every measurement covers about this many tests so the small sizes are not lost in timer noise
+	constexpr auto tests_per_measurement = 20000000;
+	constexpr auto query_count = 256;
+
+	std::cout << "------------ Overlap Kernel Benchmark (" << GetInstructionSet() << ") ------------" << std::endl;
+
+	for (const auto count : { 1000, 10000, 100000 })
+	{
+		const auto world_size = std::sqrt(static_cast<float>(count)) * 40.0f;
+		const auto repeats = std::max(1, tests_per_measurement / count);
+
+		BoxArrays boxes;
+		CircleArrays circles;
+		std::vector<BenchmarkObject> objects(count);
+		for (auto& object : objects)
+		{
+			const auto position = Util::RandomRange(glm::vec2(0.0f, 0.0f), glm::vec2(world_size, world_size));
+			const auto size = Util::RandomRange(8.0f, 24.0f);
+			object.GetTransform()->position = position;
+			object.SetWidth(static_cast<int>(size));
+			object.SetHeight(static_cast<int>(size));
+
+			boxes.Add(CollisionManager::ComputeAABB(&object));
+			circles.Add(position, size * 0.5f);
+		}
+
+		BoxArrays queries;
+		for (auto i = 0; i < query_count; ++i)
+		{
+			const auto position = Util::RandomRange(glm::vec2(0.0f, 0.0f), glm::vec2(world_size, world_size));
+			queries.Add(AABB(position, position + glm::vec2(64.0f, 64.0f)));
+		}
+
+		const AABB query_box(glm::vec2(queries.min_x[0], queries.min_y[0]), glm::vec2(queries.max_x[0], queries.max_y[0]));
+		const auto query_centre = query_box.GetCentre();
+		BenchmarkObject query_object;
+		query_object.GetTransform()->position = query_centre;
+		query_object.SetWidth(64);
+		query_object.SetHeight(64);
+
+		std::vector<int> hits;
+		std::vector<int> scalar_hits(count);
+		auto report = [&](const char* name, const double elapsed, const double tests, const size_t hit_total)
+		{
+			std::cout << "  " << name << elapsed << " ms, " << elapsed * 1000000.0 / tests << " ns / test (" << hit_total << " hits)" << std::endl;
+		};
+
+		std::cout << count << " boxes, 1 x N repeated " << repeats << " times" << std::endl;
+
+		// current path - one pair at a time through the GameObject getters
+		auto start = SDL_GetPerformanceCounter();
+		size_t hit_total = 0;
+		for (auto repeat = 0; repeat < repeats; ++repeat)
+		{
+			for (auto& object : objects)
+			{
+				hit_total += CollisionManager::AABBCheck(&query_object, &object);
+			}
+		}
+		report("AABBCheck       ", ElapsedMilliseconds(start), static_cast<double>(repeats) * count, hit_total);
+
+		start = SDL_GetPerformanceCounter();
+		hit_total = 0;
+		for (auto repeat = 0; repeat < repeats; ++repeat)
+		{
+			hit_total += ScalarBoxBoxes(query_box, boxes, 0, count, scalar_hits.data());
+		}
+		report("box scalar      ", ElapsedMilliseconds(start), static_cast<double>(repeats) * count, hit_total);
+
+		start = SDL_GetPerformanceCounter();
+		hit_total = 0;
+		for (auto repeat = 0; repeat < repeats; ++repeat)
+		{
+			hits.clear();
+			hit_total += BoxBoxes(query_box, boxes, hits);
+		}
+		report("box batch       ", ElapsedMilliseconds(start), static_cast<double>(repeats) * count, hit_total);
+
+		start = SDL_GetPerformanceCounter();
+		hit_total = 0;
+		for (auto repeat = 0; repeat < repeats; ++repeat)
+		{
+			hit_total += ScalarCircleCircles(query_centre, 32.0f, circles, 0, count, scalar_hits.data());
+		}
+		report("circle scalar   ", ElapsedMilliseconds(start), static_cast<double>(repeats) * count, hit_total);
+
+		start = SDL_GetPerformanceCounter();
+		hit_total = 0;
+		for (auto repeat = 0; repeat < repeats; ++repeat)
+		{
+			hits.clear();
+			hit_total += CircleCircles(query_centre, 32.0f, circles, hits);
+		}
+		report("circle batch    ", ElapsedMilliseconds(start), static_cast<double>(repeats) * count, hit_total);
+
+		start = SDL_GetPerformanceCounter();
+		hit_total = 0;
+		for (auto repeat = 0; repeat < repeats; ++repeat)
+		{
+			hit_total += ScalarCircleBoxes(query_centre, 32.0f, boxes, 0, count, scalar_hits.data());
+		}
+		report("circle-box scalar ", ElapsedMilliseconds(start), static_cast<double>(repeats) * count, hit_total);
+
+		start = SDL_GetPerformanceCounter();
+		hit_total = 0;
+		for (auto repeat = 0; repeat < repeats; ++repeat)
+		{
+			hits.clear();
+			hit_total += CircleBoxes(query_centre, 32.0f, boxes, hits);
+		}
+		report("circle-box batch  ", ElapsedMilliseconds(start), static_cast<double>(repeats) * count, hit_total);
+
+		// N x M - 256 query boxes against every box
+		std::cout << count << " boxes x " << query_count << " queries" << std::endl;
+		const auto pair_tests = static_cast<double>(count) * query_count;
+
+		start = SDL_GetPerformanceCounter();
+		hit_total = 0;
+		for (auto i = 0; i < query_count; ++i)
+		{
+			const AABB box(glm::vec2(queries.min_x[i], queries.min_y[i]), glm::vec2(queries.max_x[i], queries.max_y[i]));
+			hit_total += ScalarBoxBoxes(box, boxes, 0, count, scalar_hits.data());
+		}
+		report("boxes scalar    ", ElapsedMilliseconds(start), pair_tests, hit_total);
+
+		std::vector<std::pair<int, int>> pairs;
+		start = SDL_GetPerformanceCounter();
+		hit_total = BoxesBoxes(queries, boxes, pairs);
+		report("boxes batch     ", ElapsedMilliseconds(start), pair_tests, hit_total);
+	}
+}
+
+OverlapKernels::OverlapKernels()
+= default;
+
+OverlapKernels::~OverlapKernels()
+= default;
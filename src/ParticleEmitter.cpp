@@ -0,0 +1,237 @@
+#include "ParticleEmitter.h"
+#include <algorithm>
+#include "Game.h"
+#include "Renderer.h"
+#include "TextureManager.h"
+#include "Util.h"
+
+ParticleEmitter::ParticleEmitter(const std::string& texture_path, const std::string& texture_id, const int capacity) :
+	m_textureID(texture_id), m_capacity(capacity), m_liveCount(0),
+	m_emissionRate(0.0f), m_emissionAccumulator(0.0f), m_minLifetime(0.5f), m_maxLifetime(1.0f),
+	m_minSpeed(50.0f), m_maxSpeed(150.0f), m_angle(0.0f), m_spread(360.0f), m_startSize(16.0f), m_endSize(4.0f),
+	m_startColour(1.0f, 1.0f, 1.0f, 1.0f), m_endColour(1.0f, 1.0f, 1.0f, 0.0f), m_gravity(0.0f, 0.0f), m_damping(1.0f)
+{
+	TextureManager::Instance().Load(texture_path, m_textureID);
+
+	m_positionX.resize(m_capacity);
+	m_positionY.resize(m_capacity);
+	m_velocityX.resize(m_capacity);
+	m_velocityY.resize(m_capacity);
+	m_age.resize(m_capacity);
+	m_lifetime.resize(m_capacity);
+
+	// every particle is a quad (TL, TR, BR, BL) - build the index buffer once
+	m_vertices.resize(static_cast<size_t>(m_capacity) * 4);
+	m_indices.resize(static_cast<size_t>(m_capacity) * 6);
+	for (auto i = 0; i < m_capacity; ++i)
+	{
+		const auto base = i * 4;
+		int* indices = &m_indices[static_cast<size_t>(i) * 6];
+		indices[0] = base;
+		indices[1] = base + 1;
+		indices[2] = base + 2;
+		indices[3] = base;
+		indices[4] = base + 2;
+		indices[5] = base + 3;
+	}
+
+	SetType(GameObjectType::NONE);
+}
+
+ParticleEmitter::~ParticleEmitter()
+= default;
+
+void ParticleEmitter::Draw()
+{
+	if (m_liveCount == 0)
+	{
+		return;
+	}
+
+	for (auto i = 0; i < m_liveCount; ++i)
+	{
+		const auto t = m_age[i] / m_lifetime[i];
+		const auto half_size = Util::LerpUnclamped(m_startSize, m_endSize, t) * 0.5f;
+		const auto colour = Util::ToSDLColour(m_startColour + (m_endColour - m_startColour) * t);
+
+		const auto left = m_positionX[i] - half_size;
+		const auto right = m_positionX[i] + half_size;
+		const auto top = m_positionY[i] - half_size;
+		const auto bottom = m_positionY[i] + half_size;
+
+		SDL_Vertex* quad = &m_vertices[static_cast<size_t>(i) * 4];
+		quad[0] = { { left, top }, colour, { 0.0f, 0.0f } };
+		quad[1] = { { right, top }, colour, { 1.0f, 0.0f } };
+		quad[2] = { { right, bottom }, colour, { 1.0f, 1.0f } };
+		quad[3] = { { left, bottom }, colour, { 0.0f, 1.0f } };
+	}
+
+	Renderer::Instance().DrawGeometry(TextureManager::Instance().GetTexture(m_textureID),
+		m_vertices.data(), m_liveCount * 4, m_indices.data(), m_liveCount * 6);
+}
+
+void ParticleEmitter::Update()
+{
+	Simulate(Game::Instance().GetDeltaTime());
+}
+
+void ParticleEmitter::Clean()
+{
+	Reset();
+}
+
+void ParticleEmitter::Burst(const int count)
+{
+	Spawn(count);
+}
+
+void ParticleEmitter::Simulate(const float delta_time)
+{
+	// continuous emission (trails)
+	if (m_emissionRate > 0.0f)
+	{
+		m_emissionAccumulator += m_emissionRate * delta_time;
+		const auto count = static_cast<int>(m_emissionAccumulator);
+		m_emissionAccumulator -= static_cast<float>(count);
+		Spawn(count);
+	}
+
+	// integrate - branch free so it vectorizes
+	const auto count = m_liveCount;
+	const auto gravity_x = m_gravity.x * delta_time;
+	const auto gravity_y = m_gravity.y * delta_time;
+	// damping is expressed per second, so it stays correct at any frame rate
+	const auto damping = powf(m_damping, delta_time);
+
+	float* __restrict position_x = m_positionX.data();
+	float* __restrict position_y = m_positionY.data();
+	float* __restrict velocity_x = m_velocityX.data();
+	float* __restrict velocity_y = m_velocityY.data();
+	float* __restrict age = m_age.data();
+
+	for (auto i = 0; i < count; ++i)
+	{
+		velocity_x[i] = (velocity_x[i] + gravity_x) * damping;
+		velocity_y[i] = (velocity_y[i] + gravity_y) * damping;
+		position_x[i] += velocity_x[i] * delta_time;
+		position_y[i] += velocity_y[i] * delta_time;
+		age[i] += delta_time;
+	}
+
+	// retire expired particles
+	for (auto i = 0; i < m_liveCount;)
+	{
+		if (m_age[i] >= m_lifetime[i])
+		{
+			Kill(i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+void ParticleEmitter::Reset()
+{
+	m_liveCount = 0;
+	m_emissionAccumulator = 0.0f;
+}
+
+int ParticleEmitter::GetCapacity() const
+{
+	return m_capacity;
+}
+
+int ParticleEmitter::GetLiveCount() const
+{
+	return m_liveCount;
+}
+
+void ParticleEmitter::SetEmissionRate(const float particles_per_second)
+{
+	m_emissionRate = particles_per_second;
+}
+
+void ParticleEmitter::SetLifetime(const float min, const float max)
+{
+	m_minLifetime = min;
+	m_maxLifetime = max;
+}
+
+void ParticleEmitter::SetSpeed(const float min, const float max)
+{
+	m_minSpeed = min;
+	m_maxSpeed = max;
+}
+
+/**
+ * \brief Sets the emission direction
+ * \param angle centre of the emission cone in degrees
+ * \param spread width of the emission cone in degrees (360 emits in every direction)
+ */
+void ParticleEmitter::SetDirection(const float angle, const float spread)
+{
+	m_angle = angle;
+	m_spread = spread;
+}
+
+void ParticleEmitter::SetSize(const float start, const float end)
+{
+	m_startSize = start;
+	m_endSize = end;
+}
+
+void ParticleEmitter::SetColour(const glm::vec4 start, const glm::vec4 end)
+{
+	m_startColour = start;
+	m_endColour = end;
+}
+
+void ParticleEmitter::SetGravity(const glm::vec2 gravity)
+{
+	m_gravity = gravity;
+}
+
+/**
+ * \brief Sets the fraction of velocity kept after one second (1 = no damping)
+ */
+void ParticleEmitter::SetDamping(const float damping)
+{
+	m_damping = damping;
+}
+
+void ParticleEmitter::Spawn(int count)
+{
+	// the pool never grows - particles beyond capacity are dropped
+	count = std::min(count, m_capacity - m_liveCount);
+
+	const auto origin = GetTransform()->position;
+	const auto half_spread = m_spread * 0.5f;
+
+	for (auto n = 0; n < count; ++n)
+	{
+		const auto i = m_liveCount++;
+		const auto angle = (m_angle + Util::RandomRange(-half_spread, half_spread)) * Util::Deg2Rad;
+		const auto speed = Util::RandomRange(m_minSpeed, m_maxSpeed);
+
+		m_positionX[i] = origin.x;
+		m_positionY[i] = origin.y;
+		m_velocityX[i] = cosf(angle) * speed;
+		m_velocityY[i] = sinf(angle) * speed;
+		m_age[i] = 0.0f;
+		m_lifetime[i] = Util::RandomRange(m_minLifetime, m_maxLifetime);
+	}
+}
+
+void ParticleEmitter::Kill(const int index)
+{
+	// swap the last live particle into the hole to keep the pool dense
+	const auto last = --m_liveCount;
+	m_positionX[index] = m_positionX[last];
+	m_positionY[index] = m_positionY[last];
+	m_velocityX[index] = m_velocityX[last];
+	m_velocityY[index] = m_velocityY[last];
+	m_age[index] = m_age[last];
+	m_lifetime[index] = m_lifetime[last];
+}
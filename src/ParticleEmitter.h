@@ -0,0 +1,87 @@
+#pragma once
+#ifndef __PARTICLE_EMITTER__
+#define __PARTICLE_EMITTER__
+
+#include <string>
+#include <vector>
+#include <glm/vec4.hpp>
+#include <SDL.h>
+
+#include "DisplayObject.h"
+
+/**
+ * \brief Fixed capacity particle pool drawn with a single texture.
+ * Particle state is stored as parallel float arrays (structure of arrays) so the
+ * integration loop is a straight pass over contiguous memory the compiler can vectorize.
+ * All live particles are submitted with one SDL_RenderGeometry call.
+ */
+class ParticleEmitter final : public DisplayObject
+{
+public:
+	explicit ParticleEmitter(const std::string& texture_path = "../Assets/textures/fireball.tga",
+		const std::string& texture_id = "fireball", int capacity = 1024);
+	~ParticleEmitter() override;
+
+	// Life Cycle Functions
+	void Draw() override;
+	void Update() override;
+	void Clean() override;
+
+	// spawns count particles at the emitter position (explosions)
+	void Burst(int count);
+	// advances the simulation by delta_time seconds
+	void Simulate(float delta_time);
+	void Reset();
+
+	// getters
+	[[nodiscard]] int GetCapacity() const;
+	[[nodiscard]] int GetLiveCount() const;
+
+	// setters
+	void SetEmissionRate(float particles_per_second);
+	void SetLifetime(float min, float max);
+	void SetSpeed(float min, float max);
+	void SetDirection(float angle, float spread);
+	void SetSize(float start, float end);
+	void SetColour(glm::vec4 start, glm::vec4 end);
+	void SetGravity(glm::vec2 gravity);
+	void SetDamping(float damping);
+
+private:
+	void Spawn(int count);
+	void Kill(int index);
+
+	std::string m_textureID;
+	int m_capacity;
+	int m_liveCount;
+
+	// particle pool (structure of arrays)
+	std::vector<float> m_positionX;
+	std::vector<float> m_positionY;
+	std::vector<float> m_velocityX;
+	std::vector<float> m_velocityY;
+	std::vector<float> m_age;
+	std::vector<float> m_lifetime;
+
+	// geometry buffers, the index buffer never changes after construction
+	std::vector<SDL_Vertex> m_vertices;
+	std::vector<int> m_indices;
+
+	// emission properties
+	float m_emissionRate;
+	float m_emissionAccumulator;
+	float m_minLifetime;
+	float m_maxLifetime;
+	float m_minSpeed;
+	float m_maxSpeed;
+	float m_angle;
+	float m_spread;
+	float m_startSize;
+	float m_endSize;
+	glm::vec4 m_startColour;
+	glm::vec4 m_endColour;
+	glm::vec2 m_gravity;
+	float m_damping;
+};
+
+#endif /* defined (__PARTICLE_EMITTER__) */
@@ -0,0 +1,620 @@
+#include "PathFinder.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <SDL.h>
+
+namespace
+{
+	constexpr float SQRT2 = 1.41421356f;
+
+	// neighbour offsets, the 4 straight moves first
+	constexpr int OFFSET_X[8] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	constexpr int OFFSET_Y[8] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+
+	double ElapsedMilliseconds(const Uint64 start)
+	{
+		return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+	}
+
+	// lowest f on top, ties go to the node furthest from the start (closest to the goal)
+	bool OpenGreater(const float f1, const float g1, const float f2, const float g2)
+	{
+		return f1 > f2 || (f1 == f2 && g1 < g2);
+	}
+
+	glm::ivec2 RandomWalkableTile(const TileGrid& grid, std::mt19937& generator)
+	{
+		std::uniform_int_distribution<int> col(0, grid.GetCols() - 1);
+		std::uniform_int_distribution<int> row(0, grid.GetRows() - 1);
+		while (true)
+		{
+			const glm::ivec2 tile(col(generator), row(generator));
+			if (grid.IsWalkable(tile.x, tile.y))
+			{
+				return tile;
+			}
+		}
+	}
+}
+
+PathSearchContext::PathSearchContext() :
+	m_generation(0), m_expandedCount(0), m_pGrid(nullptr), m_gridVersion(0), m_goal(0, 0), m_heuristic(OCTILE), m_allowDiagonal(true)
+{
+}
+
+PathSearchContext::~PathSearchContext()
+= default;
+
+void PathSearchContext::Reserve(const int tile_count)
+{
+	if (static_cast<int>(m_nodes.size()) < tile_count)
+	{
+		m_nodes.resize(tile_count);
+	}
+	m_open.reserve(static_cast<size_t>(tile_count) / 4);
+}
+
+int PathSearchContext::GetExpandedCount() const
+{
+	return m_expandedCount;
+}
+
+void PathSearchContext::Begin(const int tile_count)
+{
+	Reserve(tile_count);
+	m_open.clear();
+	m_expandedCount = 0;
+
+	// after 4 billion searches the stamps wrap around and old records could look current
+	if (++m_generation == 0)
+	{
+		std::fill(m_nodes.begin(), m_nodes.end(), NodeRecord());
+		m_generation = 1;
+	}
+}
+
+void PathSearchContext::Push(const OpenNode node)
+{
+	// sift up
+	auto i = m_open.size();
+	m_open.push_back(node);
+	while (i > 0)
+	{
+		const auto parent = (i - 1) / 2;
+		if (!OpenGreater(m_open[parent].f, m_open[parent].g, node.f, node.g))
+		{
+			break;
+		}
+		m_open[i] = m_open[parent];
+		i = parent;
+	}
+	m_open[i] = node;
+}
+
+PathSearchContext::OpenNode PathSearchContext::Pop()
+{
+	const auto top = m_open.front();
+	const auto last = m_open.back();
+	m_open.pop_back();
+
+	// sift the last node down from the root
+	const auto size = m_open.size();
+	size_t i = 0;
+	while (size > 0)
+	{
+		auto child = i * 2 + 1;
+		if (child >= size)
+		{
+			break;
+		}
+		if (child + 1 < size && OpenGreater(m_open[child].f, m_open[child].g, m_open[child + 1].f, m_open[child + 1].g))
+		{
+			++child;
+		}
+		if (!OpenGreater(last.f, last.g, m_open[child].f, m_open[child].g))
+		{
+			break;
+		}
+		m_open[i] = m_open[child];
+		i = child;
+	}
+	if (size > 0)
+	{
+		m_open[i] = last;
+	}
+
+	return top;
+}
+
+/**
+ * \brief A* with lazy deletion - a node whose cost improves is pushed again and the stale heap entry
+ * is skipped when it comes out, which is cheaper than a decrease-key on a binary heap.
+ */
+bool PathFinder::FindPath(const TileGrid& grid, const glm::ivec2 start, const glm::ivec2 goal, std::vector<glm::ivec2>& path,
+	PathSearchContext& context, const Heuristic heuristic, const bool allow_diagonal)
+{
+	path.clear();
+	return BeginSearch(grid, start, goal, context, heuristic, allow_diagonal) &&
+		ContinueSearch(context, -1, path) == PathSearchStatus::FOUND;
+}
+
+bool PathFinder::BeginSearch(const TileGrid& grid, const glm::ivec2 start, const glm::ivec2 goal, PathSearchContext& context,
+	const Heuristic heuristic, const bool allow_diagonal)
+{
+	context.m_pGrid = nullptr;
+	if (!grid.IsWalkable(start.x, start.y) || !grid.IsWalkable(goal.x, goal.y))
+	{
+		return false;
+	}
+
+	context.Begin(grid.GetTileCount());
+	context.m_pGrid = &grid;
+	context.m_gridVersion = grid.GetVersion();
+	context.m_goal = goal;
+	context.m_heuristic = heuristic;
+	context.m_allowDiagonal = allow_diagonal;
+
+	const auto start_index = grid.GetIndex(start.x, start.y);
+	context.m_nodes[start_index] = { context.m_generation, false, -1, 0.0f };
+	context.Push({ Estimate(start, goal, heuristic), 0.0f, start_index });
+	return true;
+}
+
+PathSearchStatus PathFinder::ContinueSearch(PathSearchContext& context, const int max_expansions, std::vector<glm::ivec2>& path)
+{
+	// a search that was never started, already finished, or whose grid changed under it
+	const auto grid = context.m_pGrid;
+	if (grid == nullptr || grid->GetVersion() != context.m_gridVersion)
+	{
+		context.m_pGrid = nullptr;
+		return PathSearchStatus::NOT_FOUND;
+	}
+
+	const auto cols = grid->GetCols();
+	const auto costs = grid->GetCosts();
+	const auto goal = context.m_goal;
+	const auto heuristic = context.m_heuristic;
+	const auto goal_index = grid->GetIndex(goal.x, goal.y);
+	const auto direction_count = context.m_allowDiagonal ? 8 : 4;
+	const auto last_expansion = max_expansions < 0 ? -1 : context.m_expandedCount + max_expansions;
+
+	while (!context.m_open.empty())
+	{
+		if (context.m_expandedCount == last_expansion)
+		{
+			return PathSearchStatus::SEARCHING;
+		}
+
+		const auto current = context.Pop();
+		auto& current_node = context.m_nodes[current.index];
+		if (current_node.closed || current.g > current_node.g)
+		{
+			continue;
+		}
+
+		if (current.index == goal_index)
+		{
+			path.clear();
+			BuildPath(context, *grid, goal_index, path);
+			context.m_pGrid = nullptr;
+			return PathSearchStatus::FOUND;
+		}
+
+		current_node.closed = true;
+		++context.m_expandedCount;
+
+		const auto x = current.index % cols;
+		const auto y = current.index / cols;
+		for (auto direction = 0; direction < direction_count; ++direction)
+		{
+			const auto nx = x + OFFSET_X[direction];
+			const auto ny = y + OFFSET_Y[direction];
+			if (!grid->IsWalkable(nx, ny))
+			{
+				continue;
+			}
+
+			auto step = 1.0f;
+			if (direction >= 4)
+			{
+				// no squeezing diagonally between two blocked tiles or past a blocked corner
+				if (!grid->IsWalkable(x + OFFSET_X[direction], y) || !grid->IsWalkable(x, y + OFFSET_Y[direction]))
+				{
+					continue;
+				}
+				step = SQRT2;
+			}
+
+			const auto neighbour_index = ny * cols + nx;
+			const auto g = current.g + step * static_cast<float>(costs[neighbour_index]);
+
+			auto& neighbour = context.m_nodes[neighbour_index];
+			if (neighbour.generation == context.m_generation && (neighbour.closed || neighbour.g <= g))
+			{
+				continue;
+			}
+
+			neighbour = { context.m_generation, false, current.index, g };
+			context.Push({ g + Estimate(glm::ivec2(nx, ny), goal, heuristic), g, neighbour_index });
+		}
+	}
+
+	context.m_pGrid = nullptr;
+	return PathSearchStatus::NOT_FOUND;
+}
+
+bool PathFinder::FindJumpPointPath(const TileGrid& grid, const glm::ivec2 start, const glm::ivec2 goal, std::vector<glm::ivec2>& path,
+	PathSearchContext& context, const Heuristic heuristic)
+{
+	return JumpPointSearch(grid, nullptr, start, goal, path, context, heuristic);
+}
+
+bool PathFinder::FindJumpPointPath(const JumpPointTable& table, const glm::ivec2 start, const glm::ivec2 goal, std::vector<glm::ivec2>& path,
+	PathSearchContext& context, const Heuristic heuristic)
+{
+	const auto grid = table.GetGrid();
+	if (grid == nullptr || !table.IsBuiltFrom(*grid))
+	{
+		path.clear();
+		return false;
+	}
+	return JumpPointSearch(*grid, &table, start, goal, path, context, heuristic);
+}
+
+/**
+ * \brief A* whose successors are the next jump points in the pruned directions instead of the neighbours.
+ * From a tile reached straight only the forward move, its two diagonals and the two sides can start a
+ * shorter path; from a tile reached diagonally only the diagonal and its two straight components can.
+ * Every other neighbour is reached at least as cheaply through the parent.
+ */
+bool PathFinder::JumpPointSearch(const TileGrid& grid, const JumpPointTable* table, const glm::ivec2 start, const glm::ivec2 goal,
+	std::vector<glm::ivec2>& path, PathSearchContext& context, const Heuristic heuristic)
+{
+	path.clear();
+	if (!grid.IsWalkable(start.x, start.y) || !grid.IsWalkable(goal.x, goal.y))
+	{
+		return false;
+	}
+
+	context.Begin(grid.GetTileCount());
+
+	const auto cols = grid.GetCols();
+	const auto goal_index = grid.GetIndex(goal.x, goal.y);
+	const auto tile_cost = static_cast<float>(Config::TILE_COST);
+
+	const auto start_index = grid.GetIndex(start.x, start.y);
+	context.m_nodes[start_index] = { context.m_generation, false, -1, 0.0f };
+	context.Push({ Estimate(start, goal, heuristic), 0.0f, start_index });
+
+	while (!context.m_open.empty())
+	{
+		const auto current = context.Pop();
+		auto& current_node = context.m_nodes[current.index];
+		if (current_node.closed || current.g > current_node.g)
+		{
+			continue;
+		}
+
+		if (current.index == goal_index)
+		{
+			BuildPath(context, grid, goal_index, path);
+			return true;
+		}
+
+		current_node.closed = true;
+		++context.m_expandedCount;
+
+		const auto x = current.index % cols;
+		const auto y = current.index / cols;
+
+		// pruned directions
+		int directions[8];
+		auto direction_count = 0;
+		if (current_node.parent == -1)
+		{
+			for (auto direction = 0; direction < 8; ++direction)
+			{
+				directions[direction_count++] = direction;
+			}
+		}
+		else
+		{
+			const auto px = current_node.parent % cols;
+			const auto py = current_node.parent / cols;
+			const auto dx = (x > px) - (x < px);
+			const auto dy = (y > py) - (y < py);
+			if (dx != 0 && dy != 0)
+			{
+				directions[direction_count++] = JumpPointTable::GetDirection(dx, dy);
+				directions[direction_count++] = JumpPointTable::GetDirection(dx, 0);
+				directions[direction_count++] = JumpPointTable::GetDirection(0, dy);
+			}
+			else
+			{
+				directions[direction_count++] = JumpPointTable::GetDirection(dx, dy);
+				directions[direction_count++] = JumpPointTable::GetDirection(dx == 0 ? 1 : dx, dy == 0 ? 1 : dy);
+				directions[direction_count++] = JumpPointTable::GetDirection(dx == 0 ? -1 : dx, dy == 0 ? -1 : dy);
+				directions[direction_count++] = JumpPointTable::GetDirection(dy, dx);
+				directions[direction_count++] = JumpPointTable::GetDirection(-dy, -dx);
+			}
+		}
+
+		for (auto i = 0; i < direction_count; ++i)
+		{
+			const auto direction = directions[i];
+			const auto dx = OFFSET_X[direction];
+			const auto dy = OFFSET_Y[direction];
+			const auto diagonal = dx != 0 && dy != 0;
+
+			auto jump_point = -1;
+			if (table == nullptr)
+			{
+				// no corner cutting on the first diagonal step either
+				if (diagonal && (!grid.IsWalkable(x + dx, y) || !grid.IsWalkable(x, y + dy)))
+				{
+					continue;
+				}
+				jump_point = Jump(grid, x + dx, y + dy, dx, dy, goal_index);
+			}
+			else
+			{
+				const auto distance = table->GetDistance(current.index, direction);
+				const auto reach = std::abs(distance);
+				const auto to_goal_x = goal.x - x;
+				const auto to_goal_y = goal.y - y;
+
+				// the table knows nothing about the goal - stop where the goal is in reach
+				if (!diagonal && to_goal_x * dy == to_goal_y * dx && to_goal_x * dx + to_goal_y * dy > 0 &&
+					std::abs(to_goal_x + to_goal_y) <= reach)
+				{
+					jump_point = goal_index;
+				}
+				else if (diagonal && (to_goal_x > 0) - (to_goal_x < 0) == dx && (to_goal_y > 0) - (to_goal_y < 0) == dy &&
+					std::min(std::abs(to_goal_x), std::abs(to_goal_y)) <= reach)
+				{
+					// the tile on the diagonal level with the goal, the goal is straight ahead from there
+					const auto steps = std::min(std::abs(to_goal_x), std::abs(to_goal_y));
+					jump_point = grid.GetIndex(x + dx * steps, y + dy * steps);
+				}
+				else if (distance > 0)
+				{
+					jump_point = grid.GetIndex(x + dx * distance, y + dy * distance);
+				}
+			}
+
+			if (jump_point == -1)
+			{
+				continue;
+			}
+
+			const auto jx = jump_point % cols;
+			const auto jy = jump_point / cols;
+			const auto steps = std::max(std::abs(jx - x), std::abs(jy - y));
+			const auto g = current.g + static_cast<float>(steps) * (diagonal ? SQRT2 : 1.0f) * tile_cost;
+
+			auto& jump_node = context.m_nodes[jump_point];
+			if (jump_node.generation == context.m_generation && (jump_node.closed || jump_node.g <= g))
+			{
+				continue;
+			}
+
+			jump_node = { context.m_generation, false, current.index, g };
+			context.Push({ g + Estimate(glm::ivec2(jx, jy), goal, heuristic), g, jump_point });
+		}
+	}
+
+	return false;
+}
+
+int PathFinder::Jump(const TileGrid& grid, int x, int y, const int dx, const int dy, const int goal_index)
+{
+	while (grid.IsWalkable(x, y))
+	{
+		const auto index = grid.GetIndex(x, y);
+		if (index == goal_index)
+		{
+			return index;
+		}
+
+		if (dx != 0 && dy != 0)
+		{
+			// a diagonal stops wherever one of its straight components finds something
+			if (Jump(grid, x + dx, y, dx, 0, goal_index) != -1 || Jump(grid, x, y + dy, 0, dy, goal_index) != -1)
+			{
+				return index;
+			}
+
+			if (!grid.IsWalkable(x + dx, y) || !grid.IsWalkable(x, y + dy))
+			{
+				return -1;
+			}
+		}
+		else if (JumpPointTable::HasForcedNeighbour(grid, x, y, dx, dy))
+		{
+			return index;
+		}
+
+		x += dx;
+		y += dy;
+	}
+
+	return -1;
+}
+
+float PathFinder::Estimate(const glm::ivec2 from, const glm::ivec2 to, const Heuristic heuristic)
+{
+	const auto dx = static_cast<float>(std::abs(to.x - from.x));
+	const auto dy = static_cast<float>(std::abs(to.y - from.y));
+
+	switch (heuristic)
+	{
+	case EUCLIDEAN:
+		return std::sqrt(dx * dx + dy * dy) * static_cast<float>(Config::TILE_COST);
+	case OCTILE:
+		// diagonal steps for the shorter side, straight for the rest
+		return (std::max(dx, dy) + (SQRT2 - 1.0f) * std::min(dx, dy)) * static_cast<float>(Config::TILE_COST);
+	case MANHATTAN:
+	default:
+		return (dx + dy) * static_cast<float>(Config::TILE_COST);
+	}
+}
+
+void PathFinder::BuildPath(const PathSearchContext& context, const TileGrid& grid, const int goal_index, std::vector<glm::ivec2>& path)
+{
+	const auto cols = grid.GetCols();
+	for (auto index = goal_index; index != -1; index = context.m_nodes[index].parent)
+	{
+		glm::ivec2 tile(index % cols, index / cols);
+		path.push_back(tile);
+
+		// jump point parents are further than one tile away, along a straight or diagonal line
+		const auto parent = context.m_nodes[index].parent;
+		if (parent != -1)
+		{
+			const glm::ivec2 parent_tile(parent % cols, parent / cols);
+			const glm::ivec2 step((parent_tile.x > tile.x) - (parent_tile.x < tile.x), (parent_tile.y > tile.y) - (parent_tile.y < tile.y));
+			for (tile += step; tile != parent_tile; tile += step)
+			{
+				path.push_back(tile);
+			}
+		}
+	}
+	std::reverse(path.begin(), path.end());
+}
+
+void PathFinder::Benchmark(const int large_grid_size)
+{
+	PathSearchContext context;
+	std::vector<glm::ivec2> path;
+	std::mt19937 generator(42);
+
+	std::cout << "------------ Path Finder Benchmark ----------" << std::endl;
+
+	// the shipped map, or a random one of the same size when it is not there
+	TileGrid map;
+	if (!map.LoadCSV("../Assets/data/map.csv"))
+	{
+		map.FillRandom(0.2f, 1);
+	}
+
+	constexpr auto small_query_count = 10000;
+	for (const auto diagonal : { false, true })
+	{
+		auto found = 0;
+		auto expanded = 0;
+		const auto start = SDL_GetPerformanceCounter();
+		for (auto i = 0; i < small_query_count; ++i)
+		{
+			const auto from = RandomWalkableTile(map, generator);
+			const auto to = RandomWalkableTile(map, generator);
+			found += FindPath(map, from, to, path, context, diagonal ? EUCLIDEAN : MANHATTAN, diagonal);
+			expanded += context.GetExpandedCount();
+		}
+		const auto time = ElapsedMilliseconds(start);
+		std::cout << map.GetCols() << "x" << map.GetRows() << (diagonal ? " 8-way: " : " 4-way: ")
+			<< small_query_count << " queries in " << time << " ms (" << small_query_count / time << " per ms, "
+			<< found << " found, " << expanded / small_query_count << " expanded per query)" << std::endl;
+	}
+
+	// large random grid, short and long queries
+	TileGrid large(large_grid_size, large_grid_size);
+	large.FillRandom(0.2f, 7);
+	context.Reserve(large.GetTileCount());
+
+	for (const auto range : { 64, large_grid_size })
+	{
+		constexpr auto large_query_count = 100;
+		auto found = 0;
+		auto expanded = 0;
+		const auto start = SDL_GetPerformanceCounter();
+		for (auto i = 0; i < large_query_count; ++i)
+		{
+			const auto from = RandomWalkableTile(large, generator);
+			auto to = from;
+			do
+			{
+				std::uniform_int_distribution<int> offset(-range, range);
+				to = glm::ivec2(std::clamp(from.x + offset(generator), 0, large_grid_size - 1), std::clamp(from.y + offset(generator), 0, large_grid_size - 1));
+			} while (!large.IsWalkable(to.x, to.y));
+
+			found += FindPath(large, from, to, path, context, EUCLIDEAN, true);
+			expanded += context.GetExpandedCount();
+		}
+		const auto time = ElapsedMilliseconds(start);
+		std::cout << large_grid_size << "x" << large_grid_size << " 8-way, range " << range << ": "
+			<< time / large_query_count << " ms per query (" << found << "/" << large_query_count << " found, "
+			<< expanded / large_query_count << " expanded per query)" << std::endl;
+	}
+}
+
+void PathFinder::JumpPointBenchmark(const int large_grid_size)
+{
+	PathSearchContext context;
+	std::vector<glm::ivec2> path;
+	std::mt19937 generator(42);
+
+	std::cout << "------------ Jump Point Search Benchmark ----------" << std::endl;
+
+	auto run = [&](const char* name, const TileGrid& grid, const int query_count)
+	{
+		context.Reserve(grid.GetTileCount());
+
+		auto start = SDL_GetPerformanceCounter();
+		JumpPointTable table;
+		table.Build(grid);
+		const auto build_time = ElapsedMilliseconds(start);
+
+		// the same queries for every search
+		std::vector<std::pair<glm::ivec2, glm::ivec2>> queries;
+		for (auto i = 0; i < query_count; ++i)
+		{
+			queries.emplace_back(RandomWalkableTile(grid, generator), RandomWalkableTile(grid, generator));
+		}
+
+		std::cout << name << " " << grid.GetCols() << "x" << grid.GetRows() << ", " << query_count << " queries (JPS+ table "
+			<< build_time << " ms, " << static_cast<double>(table.GetMemoryUsage()) / (1024.0 * 1024.0) << " MB)" << std::endl;
+
+		for (auto algorithm = 0; algorithm < 3; ++algorithm)
+		{
+			auto found = 0;
+			auto expanded = 0.0;
+			auto length = 0.0;
+			start = SDL_GetPerformanceCounter();
+			for (const auto& [from, to] : queries)
+			{
+				const auto success =
+					algorithm == 0 ? FindPath(grid, from, to, path, context, OCTILE, true) :
+					algorithm == 1 ? FindJumpPointPath(grid, from, to, path, context, OCTILE) :
+					FindJumpPointPath(table, from, to, path, context, OCTILE);
+				found += success;
+				expanded += context.GetExpandedCount();
+				length += static_cast<double>(path.size());
+			}
+			const auto time = ElapsedMilliseconds(start);
+
+			static const char* names[] = { "  A*  ", "  JPS ", "  JPS+" };
+			std::cout << names[algorithm] << ": " << time / query_count << " ms per query, "
+				<< expanded / query_count << " expanded, " << found << " found, average length " << length / query_count << std::endl;
+		}
+	};
+
+	TileGrid map;
+	if (map.LoadCSV("../Assets/data/map.csv"))
+	{
+		run("map.csv", map, 10000);
+	}
+
+	TileGrid random(large_grid_size, large_grid_size);
+	random.FillRandom(0.2f, 7);
+	run("random 20%", random, 20);
+
+	TileGrid open(large_grid_size, large_grid_size);
+	open.FillRandom(0.02f, 11);
+	run("random 2%", open, 20);
+
+	TileGrid maze(large_grid_size, large_grid_size);
+	maze.FillMaze(3);
+	run("maze", maze, 20);
+}
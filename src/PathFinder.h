@@ -0,0 +1,120 @@
+#pragma once
+#ifndef __PATH_FINDER__
+#define __PATH_FINDER__
+
+// Core Libraries
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "Heuristic.h"
+#include "PathSearchStatus.h"
+#include "TileGrid.h"
+#include "JumpPointTable.h"
+
+/**
+ * \brief Scratch memory of a search, kept between searches.
+ * Node records are stamped with the search that wrote them - a record from an older search reads as
+ * unvisited, so starting a search costs nothing however large the grid is. The arrays only grow.
+ * One context per thread; a context can be used on any grid.
+ */
+class PathSearchContext
+{
+public:
+	PathSearchContext();
+	~PathSearchContext();
+
+	// sizes the arrays up front so the first search on a large grid does not allocate
+	void Reserve(int tile_count);
+
+	// getters - statistics of the last search
+	[[nodiscard]] int GetExpandedCount() const;
+
+private:
+	friend class PathFinder;
+
+	struct NodeRecord
+	{
+		std::uint32_t generation = 0;
+		bool closed = false;
+		int parent = -1;
+		float g = 0.0f;
+	};
+
+	struct OpenNode
+	{
+		float f;
+		float g;
+		int index;
+	};
+
+	// starts a new generation, the records of the last search become stale
+	void Begin(int tile_count);
+	[[nodiscard]] bool IsVisited(int index) const { return m_nodes[index].generation == m_generation; }
+
+	void Push(OpenNode node);
+	OpenNode Pop();
+
+	std::vector<NodeRecord> m_nodes;
+	// binary min heap on f
+	std::vector<OpenNode> m_open;
+	std::uint32_t m_generation;
+	int m_expandedCount;
+
+	// the search in progress between BeginSearch and the end of ContinueSearch, null otherwise
+	const TileGrid* m_pGrid;
+	std::uint32_t m_gridVersion;
+	glm::ivec2 m_goal;
+	Heuristic m_heuristic;
+	bool m_allowDiagonal;
+};
+
+/**
+ * \brief A* over a TileGrid.
+ * Moves go to the 4 (or 8) neighbouring tiles and cost the destination tile's cost, times sqrt(2) diagonally.
+ * Diagonal moves may not cut the corner of a blocked tile.
+ * MANHATTAN never overestimates on 4-connected grids but does with diagonals (faster, no longer
+ * guaranteed shortest); EUCLIDEAN never overestimates; OCTILE is the exact open ground distance with diagonals.
+ */
+class PathFinder
+{
+public:
+	// on success path holds the tiles from start to goal inclusive
+	static bool FindPath(const TileGrid& grid, glm::ivec2 start, glm::ivec2 goal, std::vector<glm::ivec2>& path,
+		PathSearchContext& context, Heuristic heuristic = MANHATTAN, bool allow_diagonal = false);
+
+	// the same search in slices - BeginSearch fails if start or goal is blocked, each ContinueSearch expands at most
+	// max_expansions nodes (all of them if negative). The grid must outlive the search; changing it ends the search.
+	static bool BeginSearch(const TileGrid& grid, glm::ivec2 start, glm::ivec2 goal, PathSearchContext& context,
+		Heuristic heuristic = OCTILE, bool allow_diagonal = true);
+	static PathSearchStatus ContinueSearch(PathSearchContext& context, int max_expansions, std::vector<glm::ivec2>& path);
+
+	// Jump Point Search - the same 8-way moves as FindPath with diagonals, for grids where every open tile costs
+	// the same (tile costs are ignored). Only jump points are pushed on the open list; the path is returned tile by tile.
+	static bool FindJumpPointPath(const TileGrid& grid, glm::ivec2 start, glm::ivec2 goal, std::vector<glm::ivec2>& path,
+		PathSearchContext& context, Heuristic heuristic = OCTILE);
+	// JPS+ - jumps are read from a table built from the grid instead of scanned. Fails if the grid changed since the build.
+	static bool FindJumpPointPath(const JumpPointTable& table, glm::ivec2 start, glm::ivec2 goal, std::vector<glm::ivec2>& path,
+		PathSearchContext& context, Heuristic heuristic = OCTILE);
+
+	// heuristic distance between two tiles in tile cost units
+	[[nodiscard]] static float Estimate(glm::ivec2 from, glm::ivec2 to, Heuristic heuristic);
+
+	// queries per frame on the Config sized map and time per query on a large random grid
+	static void Benchmark(int large_grid_size = 1024);
+	// A*, JPS and JPS+ on map.csv, a large random grid and a large maze
+	static void JumpPointBenchmark(int large_grid_size = 1025);
+
+private:
+	PathFinder();
+
+	static bool JumpPointSearch(const TileGrid& grid, const JumpPointTable* table, glm::ivec2 start, glm::ivec2 goal,
+		std::vector<glm::ivec2>& path, PathSearchContext& context, Heuristic heuristic);
+	// the first jump point (or the goal) travelling from (x, y) in a direction, -1 if a wall comes first
+	static int Jump(const TileGrid& grid, int x, int y, int dx, int dy, int goal_index);
+
+	static void BuildPath(const PathSearchContext& context, const TileGrid& grid, int goal_index, std::vector<glm::ivec2>& path);
+};
+
+#endif /* defined (__PATH_FINDER__) */
@@ -0,0 +1,477 @@
+#include "PathRequestQueue.h"
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <SDL.h>
+
+namespace
+{
+	// nodes a main thread search expands between two looks at the clock
+	constexpr int SLICE_EXPANSIONS = 256;
+
+	double ElapsedMilliseconds(const Uint64 start)
+	{
+		return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+	}
+}
+
+size_t PathRequestQueue::JobKeyHash::operator()(const JobKey& key) const
+{
+	auto hash = std::hash<const TileGrid*>()(key.grid);
+	for (const auto value : { key.start.x, key.start.y, key.goal.x, key.goal.y, static_cast<int>(key.heuristic) })
+	{
+		hash ^= std::hash<int>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	}
+	return hash;
+}
+
+PathTicket PathRequestQueue::Request(const TileGrid& grid, const glm::ivec2 start, const glm::ivec2 goal, const Callback& callback, const Heuristic heuristic)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto ticket = m_nextTicket++;
+	if (ticket == INVALID_TICKET)
+	{
+		ticket = m_nextTicket++;
+	}
+	++m_requestCount;
+
+	const JobKey key = { &grid, start, goal, heuristic };
+	if (const auto existing = m_jobs.find(key); existing != m_jobs.end())
+	{
+		// the same search is already waiting, running or waiting for delivery
+		existing->second->waiters.push_back({ ticket, callback });
+		m_tickets[ticket] = existing->second;
+		++m_coalescedCount;
+		return ticket;
+	}
+
+	auto job = std::make_unique<Job>();
+	job->grid = &grid;
+	job->start = start;
+	job->goal = goal;
+	job->heuristic = heuristic;
+	job->gridVersion = grid.GetVersion();
+	job->waiters.push_back({ ticket, callback });
+	job->found = false;
+	job->delivering = false;
+
+	m_jobs[key] = job.get();
+	m_tickets[ticket] = job.get();
+	m_queue.push_back(std::move(job));
+	m_jobQueued.notify_one();
+	return ticket;
+}
+
+bool PathRequestQueue::Cancel(const PathTicket ticket)
+{
+	auto in_flight = false;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		const auto found = m_tickets.find(ticket);
+		if (found == m_tickets.end())
+		{
+			return false;
+		}
+		const auto job = found->second;
+		m_tickets.erase(found);
+
+		// Update is calling this job back - forgetting the ticket is enough, its waiters are being walked
+		if (job->delivering)
+		{
+			return true;
+		}
+
+		auto& waiters = job->waiters;
+		waiters.erase(std::remove_if(waiters.begin(), waiters.end(), [ticket](const Waiter& waiter) { return waiter.ticket == ticket; }), waiters.end());
+		if (!waiters.empty())
+		{
+			return true;
+		}
+
+		// nobody waits for the search any more - drop it unless a worker is running it (that result is dropped on delivery)
+		auto owns = [job](const std::unique_ptr<Job>& owned) { return owned.get() == job; };
+		if (const auto queued = std::find_if(m_queue.begin(), m_queue.end(), owns); queued != m_queue.end())
+		{
+			RemoveJob(job);
+			m_queue.erase(queued);
+		}
+		else if (const auto finished = std::find_if(m_finished.begin(), m_finished.end(), owns); finished != m_finished.end())
+		{
+			RemoveJob(job);
+			m_finished.erase(finished);
+		}
+		else if (m_pCurrent.get() == job)
+		{
+			RemoveJob(job);
+			m_pCurrent.reset();
+		}
+		else
+		{
+			in_flight = true;
+		}
+	}
+
+	// a worker is still reading the grid - wait for it, as Clear does, so the caller may free the grid on return
+	if (in_flight)
+	{
+		std::unique_lock<std::shared_mutex> grid_lock(m_gridMutex);
+	}
+	return true;
+}
+
+void PathRequestQueue::Clear()
+{
+	// no worker is searching once this is held, and none starts until it is released
+	std::unique_lock<std::shared_mutex> grid_lock(m_gridMutex);
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_queue.clear();
+	m_finished.clear();
+	m_pCurrent.reset();
+	m_jobs.clear();
+	m_tickets.clear();
+}
+
+/**
+ * \brief Without workers the job at the head of the queue is searched a slice at a time until the budget is spent;
+ * a search that does not finish keeps its place and its context for the next frame.
+ * Callbacks run without the lock held, so they may request, cancel or clear.
+ */
+void PathRequestQueue::Update()
+{
+	const auto start = SDL_GetPerformanceCounter();
+	const auto budget = static_cast<double>(m_timeBudget) / 1000.0;
+
+	while (!IsRunning() && ElapsedMilliseconds(start) < budget)
+	{
+		if (m_pCurrent == nullptr)
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (m_queue.empty())
+				{
+					break;
+				}
+				m_pCurrent = std::move(m_queue.front());
+				m_queue.pop_front();
+			}
+
+			m_pCurrent->gridVersion = m_pCurrent->grid->GetVersion();
+			if (!PathFinder::BeginSearch(*m_pCurrent->grid, m_pCurrent->start, m_pCurrent->goal, m_context, m_pCurrent->heuristic))
+			{
+				m_pCurrent->found = false;
+				m_pCurrent->path.clear();
+				Finish(std::move(m_pCurrent));
+				continue;
+			}
+		}
+
+		const auto status = PathFinder::ContinueSearch(m_context, SLICE_EXPANSIONS, m_pCurrent->path);
+		if (status != PathSearchStatus::SEARCHING)
+		{
+			m_pCurrent->found = status == PathSearchStatus::FOUND;
+			if (!m_pCurrent->found)
+			{
+				m_pCurrent->path.clear();
+			}
+			Finish(std::move(m_pCurrent));
+		}
+	}
+
+	std::vector<std::unique_ptr<Job>> delivered;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (auto& job : m_finished)
+		{
+			// searched against an older grid, go again (at the front, it has waited long enough)
+			if (!job->waiters.empty() && job->grid->GetVersion() != job->gridVersion)
+			{
+				m_queue.push_front(std::move(job));
+				m_jobQueued.notify_one();
+				continue;
+			}
+
+			// the tickets stay live until their callback runs, so a callback can still cancel or clear the rest
+			RemoveJob(job.get());
+			job->delivering = true;
+			delivered.push_back(std::move(job));
+		}
+		m_finished.clear();
+	}
+
+	for (const auto& job : delivered)
+	{
+		for (const auto& waiter : job->waiters)
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (m_tickets.erase(waiter.ticket) == 0)
+				{
+					// cancelled or cleared by an earlier callback
+					continue;
+				}
+			}
+
+			if (waiter.callback)
+			{
+				waiter.callback(waiter.ticket, job->found, job->path);
+			}
+		}
+	}
+
+	m_lastUpdateTime = ElapsedMilliseconds(start);
+}
+
+bool PathRequestQueue::Start(const int worker_count)
+{
+	Stop();
+	if (worker_count <= 0)
+	{
+		return false;
+	}
+
+	// the search the main thread was slicing starts over on a worker
+	if (m_pCurrent != nullptr)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_queue.push_front(std::move(m_pCurrent));
+	}
+
+	for (auto i = 0; i < worker_count; ++i)
+	{
+		m_workers.emplace_back(&PathRequestQueue::Run, this);
+	}
+
+	std::cout << "path request queue: " << worker_count << " worker threads" << std::endl;
+	return true;
+}
+
+void PathRequestQueue::Stop()
+{
+	if (m_workers.empty())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_jobQueued.notify_all();
+	for (auto& worker : m_workers)
+	{
+		worker.join();
+	}
+	m_workers.clear();
+	m_stopping = false;
+}
+
+bool PathRequestQueue::IsRunning() const
+{
+	return !m_workers.empty();
+}
+
+std::shared_mutex& PathRequestQueue::GetGridMutex()
+{
+	return m_gridMutex;
+}
+
+int PathRequestQueue::GetWorkerCount() const
+{
+	return static_cast<int>(m_workers.size());
+}
+
+int PathRequestQueue::GetTimeBudget() const
+{
+	return m_timeBudget;
+}
+
+int PathRequestQueue::GetPendingCount()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return static_cast<int>(m_tickets.size());
+}
+
+int PathRequestQueue::GetRequestCount() const
+{
+	return m_requestCount;
+}
+
+int PathRequestQueue::GetSearchCount() const
+{
+	return m_searchCount.load(std::memory_order_relaxed);
+}
+
+int PathRequestQueue::GetCoalescedCount() const
+{
+	return m_coalescedCount;
+}
+
+double PathRequestQueue::GetLastUpdateTime() const
+{
+	return m_lastUpdateTime;
+}
+
+void PathRequestQueue::SetTimeBudget(const int microseconds)
+{
+	m_timeBudget = std::max(microseconds, 0);
+}
+
+void PathRequestQueue::Benchmark(const int request_count)
+{
+	auto& queue = Instance();
+	const auto worker_count = queue.GetWorkerCount();
+	const auto time_budget = queue.GetTimeBudget();
+
+	std::cout << "------------ Path Request Queue Benchmark ----------" << std::endl;
+
+	TileGrid grid(512, 512);
+	grid.FillRandom(0.2f, 11);
+
+	// a quarter of the agents share a destination and a start with another agent
+	std::mt19937 generator(42);
+	std::vector<std::pair<glm::ivec2, glm::ivec2>> requests;
+	for (auto i = 0; i < request_count; ++i)
+	{
+		std::uniform_int_distribution<int> tile(0, 511);
+		if (i > 0 && i % 4 == 0)
+		{
+			requests.push_back(requests[std::uniform_int_distribution<int>(0, i - 1)(generator)]);
+		}
+		else
+		{
+			requests.emplace_back(glm::ivec2(tile(generator), tile(generator)), glm::ivec2(tile(generator), tile(generator)));
+		}
+	}
+
+	// everything in one frame, the spike the queue avoids
+	PathSearchContext context;
+	std::vector<glm::ivec2> path;
+	auto start = SDL_GetPerformanceCounter();
+	for (const auto& [from, to] : requests)
+	{
+		PathFinder::FindPath(grid, from, to, path, context, OCTILE, true);
+	}
+	std::cout << request_count << " requests on a 512x512 grid, synchronous: " << ElapsedMilliseconds(start) << " ms in one frame" << std::endl;
+
+	auto run = [&](const char* name)
+	{
+		const auto searches = queue.GetSearchCount();
+		auto delivered = 0;
+		for (const auto& [from, to] : requests)
+		{
+			queue.Request(grid, from, to, [&delivered](PathTicket, bool, const std::vector<glm::ivec2>&) { ++delivered; });
+		}
+
+		auto frames = 0;
+		auto worst_frame = 0.0;
+		start = SDL_GetPerformanceCounter();
+		while (delivered < request_count)
+		{
+			queue.Update();
+			// the first frame sizes the main thread's search context
+			if (frames > 0)
+			{
+				worst_frame = std::max(worst_frame, queue.GetLastUpdateTime());
+			}
+			++frames;
+			if (queue.IsRunning())
+			{
+				// a frame's worth of other work while the workers search
+				SDL_Delay(1);
+			}
+		}
+		std::cout << name << ": " << frames << " frames, " << ElapsedMilliseconds(start) << " ms until the last delivery, worst Update "
+			<< worst_frame << " ms, " << queue.GetSearchCount() - searches << " searches" << std::endl;
+	};
+
+	queue.Stop();
+	queue.SetTimeBudget(1000);
+	run("  main thread, 1000 us per frame");
+	queue.SetTimeBudget(4000);
+	run("  main thread, 4000 us per frame");
+
+	const auto threads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 2u)) - 1;
+	queue.Start(threads);
+	const auto name = "  " + std::to_string(threads) + " worker" + (threads == 1 ? "" : "s");
+	run(name.c_str());
+
+	// back to how the game had it
+	queue.Stop();
+	if (worker_count > 0)
+	{
+		queue.Start(worker_count);
+	}
+	queue.SetTimeBudget(time_budget);
+}
+
+PathRequestQueue::PathRequestQueue() :
+	m_stopping(false), m_nextTicket(1), m_timeBudget(1000),
+	m_requestCount(0), m_searchCount(0), m_coalescedCount(0), m_lastUpdateTime(0.0)
+{
+}
+
+PathRequestQueue::~PathRequestQueue()
+{
+	Stop();
+}
+
+void PathRequestQueue::Run()
+{
+	PathSearchContext context;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_jobQueued.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+			if (m_stopping)
+			{
+				// whatever is still queued goes back to the main thread
+				break;
+			}
+		}
+
+		// the grid lock comes first, so Clear can never free a grid between taking a job and searching it
+		std::shared_lock<std::shared_mutex> grid_lock(m_gridMutex);
+		std::unique_ptr<Job> job;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_queue.empty())
+			{
+				continue;
+			}
+			job = std::move(m_queue.front());
+			m_queue.pop_front();
+		}
+
+		Search(*job, context);
+		Finish(std::move(job));
+	}
+}
+
+void PathRequestQueue::Search(Job& job, PathSearchContext& context) const
+{
+	job.gridVersion = job.grid->GetVersion();
+	job.found = PathFinder::FindPath(*job.grid, job.start, job.goal, job.path, context, job.heuristic, true);
+}
+
+void PathRequestQueue::Finish(std::unique_ptr<Job> job)
+{
+	m_searchCount.fetch_add(1, std::memory_order_relaxed);
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_finished.push_back(std::move(job));
+}
+
+void PathRequestQueue::RemoveJob(const Job* job)
+{
+	// a job can lose its key to a newer one after Clear
+	const JobKey key = { job->grid, job->start, job->goal, job->heuristic };
+	if (const auto found = m_jobs.find(key); found != m_jobs.end() && found->second == job)
+	{
+		m_jobs.erase(found);
+	}
+}
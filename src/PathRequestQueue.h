@@ -0,0 +1,169 @@
+#pragma once
+#ifndef __PATH_REQUEST_QUEUE__
+#define __PATH_REQUEST_QUEUE__
+
+// Core Libraries
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "Heuristic.h"
+#include "PathFinder.h"
+#include "TileGrid.h"
+
+typedef std::uint32_t PathTicket;
+
+/* Singleton
+ * Asynchronous path requests. Request returns a ticket straight away; the search runs later and the
+ * callback gets the result on the main thread, from Update, in the frame the search finishes.
+ * Without worker threads Update searches on the main thread in slices until the time budget is spent,
+ * so a long search is spread over several frames. With workers (Start) the searches run on them and
+ * Update only delivers.
+ * Requests for the same grid, start, goal and heuristic while one is pending share a single search.
+ * A cancelled request is never called back - cancel before whatever the callback captures goes away.
+ * Grids must outlive their requests. Workers read the grids while they search, so changing a grid that has
+ * pending requests while workers run must hold GetGridMutex(). A path whose grid changed before it was
+ * delivered is searched again.
+ */
+class PathRequestQueue
+{
+public:
+	static PathRequestQueue& Instance()
+	{
+		static PathRequestQueue instance;
+		return instance;
+	}
+
+	static constexpr PathTicket INVALID_TICKET = 0;
+
+	// found is false when there is no path, path holds the tiles from start to goal inclusive otherwise
+	typedef std::function<void(PathTicket ticket, bool found, const std::vector<glm::ivec2>& path)> Callback;
+
+	PathTicket Request(const TileGrid& grid, glm::ivec2 start, glm::ivec2 goal, const Callback& callback, Heuristic heuristic = OCTILE);
+	// returns false if the ticket was already delivered or cancelled
+	// if a worker is running the search it waits for it, so the grid is no longer read once this returns
+	bool Cancel(PathTicket ticket);
+	// drops every request without calling back, for a scene change
+	void Clear();
+
+	// main thread, once per frame - searches (without workers) and delivers finished requests
+	void Update();
+
+	// worker_count threads search from now on, Stop goes back to searching on the main thread
+	// returns false (and stops any workers) when worker_count is not positive
+	bool Start(int worker_count);
+	void Stop();
+	[[nodiscard]] bool IsRunning() const;
+
+	// held (shared) by the workers while they search
+	[[nodiscard]] std::shared_mutex& GetGridMutex();
+
+	// getters
+	[[nodiscard]] int GetWorkerCount() const;
+	[[nodiscard]] int GetTimeBudget() const;
+	[[nodiscard]] int GetPendingCount();
+	// totals since the queue was created
+	[[nodiscard]] int GetRequestCount() const;
+	[[nodiscard]] int GetSearchCount() const;
+	[[nodiscard]] int GetCoalescedCount() const;
+	// milliseconds the last Update took
+	[[nodiscard]] double GetLastUpdateTime() const;
+
+	// setters
+	// microseconds the main thread may spend searching per Update
+	void SetTimeBudget(int microseconds);
+
+	// a burst of agents requesting routes on a large grid, main thread slices against workers
+	static void Benchmark(int request_count = 1000);
+
+private:
+	PathRequestQueue();
+	~PathRequestQueue();
+	PathRequestQueue(const PathRequestQueue&) = delete;
+	PathRequestQueue& operator=(const PathRequestQueue&) = delete;
+
+	struct Waiter
+	{
+		PathTicket ticket;
+		Callback callback;
+	};
+
+	// one search and everyone waiting for it
+	struct Job
+	{
+		const TileGrid* grid;
+		glm::ivec2 start;
+		glm::ivec2 goal;
+		Heuristic heuristic;
+		std::uint32_t gridVersion;
+		std::vector<Waiter> waiters;
+		bool found;
+		std::vector<glm::ivec2> path;
+		// handed to Update's callbacks, no longer owned by the queue
+		bool delivering;
+	};
+
+	struct JobKey
+	{
+		const TileGrid* grid;
+		glm::ivec2 start;
+		glm::ivec2 goal;
+		Heuristic heuristic;
+
+		bool operator==(const JobKey& other) const
+		{
+			return grid == other.grid && start == other.start && goal == other.goal && heuristic == other.heuristic;
+		}
+	};
+
+	struct JobKeyHash
+	{
+		size_t operator()(const JobKey& key) const;
+	};
+
+	void Run();
+	// runs a job to the end on the calling thread
+	void Search(Job& job, PathSearchContext& context) const;
+	// hands a searched job over for delivery
+	void Finish(std::unique_ptr<Job> job);
+	// under the lock - forgets a job for coalescing
+	void RemoveJob(const Job* job);
+
+	std::mutex m_mutex;
+	std::shared_mutex m_gridMutex;
+	std::condition_variable m_jobQueued;
+	std::vector<std::thread> m_workers;
+	bool m_stopping;
+
+	// waiting to be searched, in request order
+	std::deque<std::unique_ptr<Job>> m_queue;
+	// searched, waiting for Update to deliver
+	std::vector<std::unique_ptr<Job>> m_finished;
+	// every job not yet delivered, for coalescing
+	std::unordered_map<JobKey, Job*, JobKeyHash> m_jobs;
+	std::unordered_map<PathTicket, Job*> m_tickets;
+	PathTicket m_nextTicket;
+
+	// main thread slicing - the job being searched keeps its context between frames
+	std::unique_ptr<Job> m_pCurrent;
+	PathSearchContext m_context;
+	int m_timeBudget;
+
+	int m_requestCount;
+	// bumped by the workers
+	std::atomic<int> m_searchCount;
+	int m_coalescedCount;
+	double m_lastUpdateTime;
+};
+
+#endif /* defined (__PATH_REQUEST_QUEUE__) */
@@ -0,0 +1,13 @@
+#pragma once
+#ifndef __PATH_SEARCH_STATUS__
+#define __PATH_SEARCH_STATUS__
+
+enum class PathSearchStatus
+{
+	SEARCHING,
+	FOUND,
+	NOT_FOUND,
+	NUM_OF_STATUSES
+};
+
+#endif /* defined (__PATH_SEARCH_STATUS__) */
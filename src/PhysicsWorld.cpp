@@ -0,0 +1,172 @@
+#include "PhysicsWorld.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	// longest frame the accumulator takes in, so a stall (breakpoint, window drag) does not trigger a spiral of catch-up steps
+	constexpr float MAX_FRAME_TIME = 0.25f;
+	constexpr int MAX_STEPS_PER_FRAME = 8;
+
+	// a body slower than this (px/s) with no acceleration for SLEEP_DELAY seconds goes to sleep
+	constexpr float SLEEP_SPEED = 2.0f;
+	constexpr float SLEEP_DELAY = 0.5f;
+
+	bool IsZero(const glm::vec2 v)
+	{
+		return v.x == 0.0f && v.y == 0.0f;
+	}
+}
+
+void PhysicsWorld::AddBody(GameObject* object)
+{
+	const auto found = std::find_if(m_bodies.begin(), m_bodies.end(), [object](const Body& body) { return body.object == object; });
+	if (found != m_bodies.end())
+	{
+		return;
+	}
+
+	m_bodies.push_back({ object, object->GetRigidBody(), object->GetTransform() });
+}
+
+void PhysicsWorld::RemoveBody(const GameObject* object)
+{
+	const auto found = std::find_if(m_bodies.begin(), m_bodies.end(), [object](const Body& body) { return body.object == object; });
+	if (found == m_bodies.end())
+	{
+		return;
+	}
+
+	// order does not matter - swap with the last body and pop
+	*found = m_bodies.back();
+	m_bodies.pop_back();
+}
+
+void PhysicsWorld::Clear()
+{
+	m_bodies.clear();
+	m_accumulator = 0.0f;
+	m_awakeBodyCount = 0;
+	m_lastStepCount = 0;
+}
+
+void PhysicsWorld::Step(const float delta_time)
+{
+	m_accumulator += std::min(delta_time, MAX_FRAME_TIME);
+
+	m_lastStepCount = 0;
+	while (m_accumulator >= m_fixedTimeStep && m_lastStepCount < MAX_STEPS_PER_FRAME)
+	{
+		Integrate(m_fixedTimeStep);
+		m_accumulator -= m_fixedTimeStep;
+		++m_lastStepCount;
+	}
+
+	// whatever is left after the step limit is dropped rather than carried into the next frame
+	if (m_lastStepCount == MAX_STEPS_PER_FRAME)
+	{
+		m_accumulator = std::min(m_accumulator, m_fixedTimeStep);
+	}
+}
+
+void PhysicsWorld::Wake(GameObject* object)
+{
+	auto rigid_body = object->GetRigidBody();
+	rigid_body->isSleeping = false;
+	rigid_body->sleepTime = 0.0f;
+}
+
+float PhysicsWorld::GetFixedTimeStep() const
+{
+	return m_fixedTimeStep;
+}
+
+float PhysicsWorld::GetInterpolationAlpha() const
+{
+	return m_accumulator / m_fixedTimeStep;
+}
+
+int PhysicsWorld::GetBodyCount() const
+{
+	return static_cast<int>(m_bodies.size());
+}
+
+int PhysicsWorld::GetAwakeBodyCount() const
+{
+	return m_awakeBodyCount;
+}
+
+int PhysicsWorld::GetLastStepCount() const
+{
+	return m_lastStepCount;
+}
+
+void PhysicsWorld::SetFixedTimeStep(const float fixed_time_step)
+{
+	if (fixed_time_step > 0.0f)
+	{
+		m_fixedTimeStep = fixed_time_step;
+	}
+}
+
+/**
+ * \brief Semi-implicit Euler - velocity first, then position with the new velocity.
+ * Damping is a fraction per second raised to the step length, so it does not depend on the step size.
+ */
+void PhysicsWorld::Integrate(const float delta_time)
+{
+	const float sleep_speed_squared = SLEEP_SPEED * SLEEP_SPEED;
+
+	m_awakeBodyCount = 0;
+	for (const auto& body : m_bodies)
+	{
+		auto& rigid_body = *body.rigid_body;
+
+		if (rigid_body.isSleeping)
+		{
+			// a sleeping body has zero velocity, so anything set since it fell asleep wakes it
+			if (IsZero(rigid_body.velocity) && IsZero(rigid_body.acceleration) && IsZero(rigid_body.force))
+			{
+				continue;
+			}
+			rigid_body.isSleeping = false;
+			rigid_body.sleepTime = 0.0f;
+		}
+
+		const float inverse_mass = rigid_body.mass > 0.0f ? 1.0f / rigid_body.mass : 1.0f;
+		const auto acceleration = rigid_body.acceleration + rigid_body.force * inverse_mass;
+		rigid_body.force = glm::vec2(0.0f, 0.0f);
+
+		rigid_body.velocity += acceleration * delta_time;
+		if (rigid_body.damping < 1.0f)
+		{
+			rigid_body.velocity *= std::pow(rigid_body.damping, delta_time);
+		}
+		body.transform->position += rigid_body.velocity * delta_time;
+
+		const float speed_squared = rigid_body.velocity.x * rigid_body.velocity.x + rigid_body.velocity.y * rigid_body.velocity.y;
+		if (speed_squared < sleep_speed_squared && IsZero(acceleration))
+		{
+			rigid_body.sleepTime += delta_time;
+			if (rigid_body.sleepTime >= SLEEP_DELAY)
+			{
+				rigid_body.isSleeping = true;
+				rigid_body.velocity = glm::vec2(0.0f, 0.0f);
+				continue;
+			}
+		}
+		else
+		{
+			rigid_body.sleepTime = 0.0f;
+		}
+
+		++m_awakeBodyCount;
+	}
+}
+
+PhysicsWorld::PhysicsWorld() : m_fixedTimeStep(1.0f / 60.0f), m_accumulator(0.0f), m_awakeBodyCount(0), m_lastStepCount(0)
+{
+}
+
+PhysicsWorld::~PhysicsWorld()
+= default;
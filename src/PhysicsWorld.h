@@ -0,0 +1,68 @@
+#pragma once
+#ifndef __PHYSICS_WORLD__
+#define __PHYSICS_WORLD__
+
+// Core Libraries
+#include <vector>
+
+#include "GameObject.h"
+
+/* Singleton
+ * Integrates the RigidBody of every registered object at a fixed timestep.
+ * Step is called once per frame with the frame time; it runs as many fixed steps as fit in the
+ * accumulated time, so motion is the same at any frame rate. The transform and rigid body pointers
+ * are cached at registration so the integration loop never goes through the GameObject.
+ * Bodies moving slower than the sleep speed for long enough are put to sleep and skipped until
+ * their velocity, acceleration or force is set again (or Wake is called).
+ */
+class PhysicsWorld
+{
+public:
+	static PhysicsWorld& Instance()
+	{
+		static PhysicsWorld instance;
+		return instance;
+	}
+
+	void AddBody(GameObject* object);
+	void RemoveBody(const GameObject* object);
+	void Clear();
+
+	// advances the simulation by delta_time seconds in fixed steps
+	void Step(float delta_time);
+	void Wake(GameObject* object);
+
+	// getters
+	[[nodiscard]] float GetFixedTimeStep() const;
+	// fraction of a fixed step left over in the accumulator, for interpolating between the last two states
+	[[nodiscard]] float GetInterpolationAlpha() const;
+	[[nodiscard]] int GetBodyCount() const;
+	[[nodiscard]] int GetAwakeBodyCount() const;
+	[[nodiscard]] int GetLastStepCount() const;
+
+	// setters
+	void SetFixedTimeStep(float fixed_time_step);
+
+private:
+	PhysicsWorld();
+	~PhysicsWorld();
+	PhysicsWorld(const PhysicsWorld&) = delete;
+	PhysicsWorld& operator=(const PhysicsWorld&) = delete;
+
+	void Integrate(float delta_time);
+
+	struct Body
+	{
+		GameObject* object;
+		RigidBody* rigid_body;
+		Transform* transform;
+	};
+
+	std::vector<Body> m_bodies;
+	float m_fixedTimeStep;
+	float m_accumulator;
+	int m_awakeBodyCount;
+	int m_lastStepCount;
+};
+
+#endif /* defined (__PHYSICS_WORLD__) */
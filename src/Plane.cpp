@@ -1,14 +1,22 @@
 #include "Plane.h"
 #include "TextureManager.h"
 
+namespace
+{
+	// everything the plane looks up in the shared sheet, so a typo fails in one place
+	constexpr auto SHEET_DATA = "../Assets/sprites/atlas.txt";
+	constexpr auto SHEET_TEXTURE = "../Assets/sprites/atlas.png";
+	constexpr auto SHEET_NAME = "spritesheet";
+
+	constexpr auto PLANE_CLIP = "plane";
+	constexpr const char* PLANE_FRAMES[] = { "plane1", "plane2", "plane3" };
+}
+
 Plane::Plane()
 {
-	TextureManager::Instance().LoadSpriteSheet(
-		"../Assets/sprites/atlas.txt",
-		"../Assets/sprites/atlas.png", 
-		"spritesheet");
+	TextureManager::Instance().LoadSpriteSheet(SHEET_DATA, SHEET_TEXTURE, SHEET_NAME);
 
-	SetSpriteSheet(TextureManager::Instance().GetSpriteSheet("spritesheet"));
+	SetSpriteSheet(TextureManager::Instance().GetSpriteSheet(SHEET_NAME));
 
 	// set frame width
 	SetWidth(65);
@@ -31,8 +39,8 @@ Plane::~Plane()
 void Plane::Draw()
 {
 	// draw the plane sprite with simple propeller animation
-	TextureManager::Instance().PlayAnimation("spritesheet", GetAnimation("plane"),
-		GetTransform()->position, 0.5f, 0, 255, true);
+	TextureManager::Instance().DrawAnimation(SHEET_NAME, *GetAnimator(),
+		GetTransform()->position, 0, 255, true);
 }
 
 void Plane::Update()
@@ -47,10 +55,14 @@ void Plane::BuildAnimations()
 {
 	auto plane_animation = Animation();
 
-	plane_animation.name = "plane";
-	plane_animation.frames.push_back(GetSpriteSheet()->GetFrame("plane1"));
-	plane_animation.frames.push_back(GetSpriteSheet()->GetFrame("plane2"));
-	plane_animation.frames.push_back(GetSpriteSheet()->GetFrame("plane3"));
+	plane_animation.name = PLANE_CLIP;
+	for (const auto frame : PLANE_FRAMES)
+	{
+		plane_animation.frames.push_back(GetSpriteSheet()->GetFrame(frame));
+	}
 
 	SetAnimation(plane_animation);
+	AddAnimationClip(AnimationClip::FromAnimation(plane_animation, 20.0f));
+
+	PlayAnimationClip(PLANE_CLIP);
 }
\ No newline at end of file
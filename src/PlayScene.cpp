@@ -7,7 +7,18 @@
 #include "imgui.h"
 #include "imgui_sdl.h"
 #include "Renderer.h"
+#include "RenderThread.h"
 #include "Util.h"
+#include "SpriteSheetLoader.h"
+#include "AABBTree.h"
+#include "OverlapKernels.h"
+#include "CollisionManager.h"
+#include "CollisionFilter.h"
+#include "PathFinder.h"
+#include "FlowField.h"
+#include "HierarchicalPathFinder.h"
+#include "PathRequestQueue.h"
+#include "SteeringSystem.h"
 
 PlayScene::PlayScene()
 {
@@ -23,11 +34,15 @@ void PlayScene::Draw()
 	// Blend test
 	Util::DrawFilledRect(glm::vec2(400.0f, 300.0f), 80, 60,
 		glm::vec4(1.0f, 0.0f, 0.0f, 0.5f));
-	SDL_SetRenderDrawColor(Renderer::Instance().GetRenderer(), 255, 255, 255, 255);
+	Renderer::Instance().SetDrawColour(255, 255, 255, 255);
 }
 
 void PlayScene::Update()
 {
+	// the trail streams out behind the player, opposite the way it faces
+	m_pTrail->GetTransform()->position = m_pPlayer->GetTransform()->position;
+	m_pTrail->SetDirection(m_playerFacingRight ? 180.0f : 0.0f, 30.0f);
+
 	UpdateDisplayList();
 }
 
@@ -197,11 +212,30 @@ void PlayScene::Start()
 	m_pPlaneSprite = new Plane();
 	AddChild(m_pPlaneSprite);
 
+	// Trail Effect - added before the player so it is drawn behind it, Update keeps it on the player
+	m_pTrail = new ParticleEmitter("../Assets/textures/firetrail.tga", "firetrail", 2048);
+	m_pTrail->SetEmissionRate(120.0f);
+	m_pTrail->SetLifetime(0.3f, 0.6f);
+	m_pTrail->SetSpeed(20.0f, 60.0f);
+	m_pTrail->SetSize(12.0f, 2.0f);
+	m_pTrail->SetColour(glm::vec4(1.0f, 0.8f, 0.3f, 0.8f), glm::vec4(1.0f, 0.1f, 0.0f, 0.0f));
+	AddChild(m_pTrail);
+
 	// Player Sprite
 	m_pPlayer = new Player();
 	AddChild(m_pPlayer);
 	m_playerFacingRight = true;
 
+	// Explosion Effect
+	m_pExplosion = new ParticleEmitter("../Assets/textures/fireball.tga", "fireball", 50000);
+	m_pExplosion->GetTransform()->position = m_pPlaneSprite->GetTransform()->position;
+	m_pExplosion->SetLifetime(0.4f, 1.2f);
+	m_pExplosion->SetSpeed(40.0f, 240.0f);
+	m_pExplosion->SetSize(24.0f, 4.0f);
+	m_pExplosion->SetColour(glm::vec4(1.0f, 0.9f, 0.5f, 1.0f), glm::vec4(1.0f, 0.2f, 0.0f, 0.0f));
+	m_pExplosion->SetDamping(0.2f);
+	AddChild(m_pExplosion);
+
 	// Back Button
 	m_pBackButton = new Button("../Assets/textures/backButton.png", "backButton", GameObjectType::BACK_BUTTON);
 	m_pBackButton->GetTransform()->position = glm::vec2(300.0f, 400.0f);
@@ -220,7 +254,7 @@ void PlayScene::Start()
 	{
 		m_pBackButton->SetAlpha(255);
 	});
-	AddChild(m_pBackButton);
+	AddChild(m_pBackButton, Config::UI_LAYER);
 
 	// Next Button
 	m_pNextButton = new Button("../Assets/textures/nextButton.png", "nextButton", GameObjectType::NEXT_BUTTON);
@@ -241,13 +275,16 @@ void PlayScene::Start()
 		m_pNextButton->SetAlpha(255);
 	});
 
-	AddChild(m_pNextButton);
+	AddChild(m_pNextButton, Config::UI_LAYER);
 
 	/* Instructions Label */
 	m_pInstructionsLabel = new Label("Press the backtick (`) character to toggle Debug View", "Consolas");
 	m_pInstructionsLabel->GetTransform()->position = glm::vec2(Config::SCREEN_WIDTH * 0.5f, 500.0f);
 
-	AddChild(m_pInstructionsLabel);
+	AddChild(m_pInstructionsLabel, Config::UI_LAYER);
+
+	// menus only change on hover, composite them once and reuse the result
+	SetLayerStatic(Config::UI_LAYER);
 
 	/* DO NOT REMOVE */
 	ImGuiWindowFrame::Instance().SetGuiFunction([this] { GUI_Function(); });
@@ -277,6 +314,252 @@ void PlayScene::GUI_Function()
 
 	ImGui::Separator();
 
+	static int burst_size = 500;
+	ImGui::SliderInt("Burst Size", &burst_size, 1, m_pExplosion->GetCapacity());
+	if (ImGui::Button("Explode"))
+	{
+		m_pExplosion->Burst(burst_size);
+	}
+	ImGui::SameLine();
+	ImGui::Text("Live Particles: %d", m_pExplosion->GetLiveCount());
+
+	static float trail_rate = 120.0f;
+	if (ImGui::SliderFloat("Trail Rate", &trail_rate, 0.0f, 1000.0f, "%.0f"))
+	{
+		m_pTrail->SetEmissionRate(trail_rate);
+	}
+	ImGui::SameLine();
+	ImGui::Text("Trail Particles: %d", m_pTrail->GetLiveCount());
+
+	ImGui::Separator();
+
+	static float gui_refresh_rate = ImGuiWindowFrame::Instance().GetRefreshRate();
+	if (ImGui::SliderFloat("Debug UI Rate (Hz)", &gui_refresh_rate, 0.0f, 120.0f, "%.0f"))
+	{
+		ImGuiWindowFrame::Instance().SetRefreshRate(gui_refresh_rate);
+	}
+
+	ImGui::Separator();
+
+	auto& render_thread = RenderThread::Instance();
+
+	static int max_queued_frames = render_thread.GetMaxQueuedFrames();
+	static bool render_thread_enabled = render_thread.IsRunning();
+	if (ImGui::Checkbox("Render Thread", &render_thread_enabled))
+	{
+		if (render_thread_enabled)
+		{
+			render_thread_enabled = render_thread.Start(max_queued_frames);
+		}
+		else
+		{
+			render_thread.Stop();
+		}
+	}
+
+	// the queue depth only takes effect when the thread is (re)started
+	if (ImGui::SliderInt("Queued Frames", &max_queued_frames, 1, 2) && render_thread.IsRunning())
+	{
+		render_thread.Stop();
+		render_thread.Start(max_queued_frames);
+	}
+
+	if (render_thread.IsRunning())
+	{
+		ImGui::Text("Latency: %.2f ms  Presents: %.1f / s", render_thread.GetAverageLatency(), render_thread.GetFramesPerSecond());
+		ImGui::Text("Queued: %d  Main Thread Wait: %.2f ms", render_thread.GetQueuedFrameCount(), render_thread.GetLastWaitTime());
+	}
+
+	ImGui::Separator();
+
+	if (ImGui::CollapsingHeader("Path Requests"))
+	{
+		auto& path_requests = PathRequestQueue::Instance();
+
+		// 0 workers searches on the main thread within the budget
+		static int path_workers = path_requests.GetWorkerCount();
+		if (ImGui::SliderInt("Path Workers", &path_workers, 0, 8))
+		{
+			if (path_workers > 0)
+			{
+				path_requests.Start(path_workers);
+			}
+			else
+			{
+				path_requests.Stop();
+			}
+		}
+
+		static int path_budget = path_requests.GetTimeBudget();
+		if (ImGui::SliderInt("Search Budget (us)", &path_budget, 100, 8000))
+		{
+			path_requests.SetTimeBudget(path_budget);
+		}
+
+		ImGui::Text("Pending: %d  Update: %.3f ms", path_requests.GetPendingCount(), path_requests.GetLastUpdateTime());
+		ImGui::Text("Requests: %d  Searches: %d  Coalesced: %d",
+			path_requests.GetRequestCount(), path_requests.GetSearchCount(), path_requests.GetCoalescedCount());
+	}
+
+	if (ImGui::CollapsingHeader("Texture Memory"))
+	{
+		auto& texture_manager = TextureManager::Instance();
+
+		static int budget_megabytes = static_cast<int>(texture_manager.GetMemoryBudget() / (1024 * 1024));
+		if (ImGui::SliderInt("Budget (MB)", &budget_megabytes, 1, 1024))
+		{
+			texture_manager.SetMemoryBudget(static_cast<size_t>(budget_megabytes) * 1024 * 1024);
+		}
+
+		ImGui::Text("In use: %.2f MB  Evictions: %d  Reloads: %d",
+			static_cast<double>(texture_manager.GetMemoryUsage()) / (1024.0 * 1024.0),
+			texture_manager.GetEvictionCount(), texture_manager.GetReloadCount());
+
+		if (ImGui::BeginTable("textures", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+		{
+			ImGui::TableSetupColumn("Texture");
+			ImGui::TableSetupColumn("Size (KB)");
+			ImGui::TableSetupColumn("Last Used Frame");
+			ImGui::TableHeadersRow();
+
+			for (const auto& texture : texture_manager.GetTextureInfo())
+			{
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::Text("%s%s", texture.id.c_str(), texture.pinned ? " (pinned)" : "");
+				ImGui::TableNextColumn();
+				if (texture.size == 0 && texture.reloadable)
+				{
+					ImGui::Text("evicted");
+				}
+				else
+				{
+					ImGui::Text("%.1f", static_cast<double>(texture.size) / 1024.0);
+				}
+				ImGui::TableNextColumn();
+				ImGui::Text("%llu", static_cast<unsigned long long>(texture.last_used_frame));
+			}
+			ImGui::EndTable();
+		}
+	}
+
+	if (ImGui::CollapsingHeader("Collision Matrix"))
+	{
+		// pairs that passed the category / mask filter last frame, by type - only types that were tested are shown
+		std::vector<GameObjectType> tested_types;
+		for (auto i = -1; i < static_cast<int>(GameObjectType::NUM_OF_TYPES); ++i)
+		{
+			const auto type = static_cast<GameObjectType>(i);
+			for (auto j = -1; j < static_cast<int>(GameObjectType::NUM_OF_TYPES); ++j)
+			{
+				if (CollisionFilter::GetTestCount(type, static_cast<GameObjectType>(j)) > 0)
+				{
+					tested_types.push_back(type);
+					break;
+				}
+			}
+		}
+
+		ImGui::Text("Filtered out: %d", CollisionFilter::GetRejectedCount());
+
+		if (!tested_types.empty() &&
+			ImGui::BeginTable("collision matrix", static_cast<int>(tested_types.size()) + 1, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+		{
+			ImGui::TableSetupColumn("");
+			for (const auto type : tested_types)
+			{
+				ImGui::TableSetupColumn(CollisionFilter::GetTypeName(type));
+			}
+			ImGui::TableHeadersRow();
+
+			for (const auto row : tested_types)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", CollisionFilter::GetTypeName(row));
+				for (const auto column : tested_types)
+				{
+					ImGui::TableNextColumn();
+					const auto count = CollisionFilter::GetTestCount(row, column);
+					if (count > 0)
+					{
+						ImGui::Text("%d", count);
+					}
+					else
+					{
+						ImGui::TextDisabled("-");
+					}
+				}
+			}
+			ImGui::EndTable();
+		}
+	}
+
+	ImGui::Separator();
+
+	// benchmarks - each prints its results to the console
+	if (ImGui::Button("Sprite Sheet Loader Benchmark"))
+	{
+		// 50k frame synthetic atlas in txt, xml and json
+		SpriteSheetLoader::Benchmark(50000);
+	}
+
+	if (ImGui::Button("AABB Tree Broadphase Benchmark"))
+	{
+		// up to 10k moving boxes against the brute force pair test
+		AABBTree::Benchmark(10000);
+	}
+
+	if (ImGui::Button("Overlap Kernel Benchmark"))
+	{
+		// batched SoA kernels against the scalar loop and AABBCheck at 1k, 10k and 100k boxes
+		OverlapKernels::Benchmark();
+	}
+
+	if (ImGui::Button("LOS Benchmark"))
+	{
+		// 500 agents against 200 obstacles, object list against the obstacle tree
+		CollisionManager::LOSBenchmark(500, 200);
+	}
+
+	if (ImGui::Button("Path Finder Benchmark"))
+	{
+		// random queries on map.csv and on a 1024x1024 random grid
+		PathFinder::Benchmark(1024);
+	}
+
+	if (ImGui::Button("Jump Point Search Benchmark"))
+	{
+		// A*, JPS and JPS+ on map.csv, large random grids and a large maze
+		PathFinder::JumpPointBenchmark(1025);
+	}
+
+	if (ImGui::Button("Flow Field Benchmark"))
+	{
+		// 10k agents chasing one target, searches against a shared field, plus large grid build and repair
+		FlowField::Benchmark(10000);
+	}
+
+	if (ImGui::Button("Hierarchical Path Finder Benchmark"))
+	{
+		// HPA* build, long queries against A* and single tile updates on a 2048x2048 random grid
+		HierarchicalPathFinder::Benchmark(2048);
+	}
+
+	if (ImGui::Button("Path Request Queue Benchmark"))
+	{
+		// 1000 requests resolved by main thread slices and by workers against one synchronous burst
+		PathRequestQueue::Benchmark(1000);
+	}
+
+	if (ImGui::Button("Steering Benchmark"))
+	{
+		// 1k to 20k agents running every behaviour, and grid separation against every pair
+		SteeringSystem::Benchmark(5000);
+	}
+
+	ImGui::Separator();
+
 	static float float3[3] = { 0.0f, 1.0f, 1.5f };
 	if(ImGui::SliderFloat3("My Slider", float3, 0.0f, 2.0f))
 	{
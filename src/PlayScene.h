@@ -7,6 +7,7 @@
 #include "Player.h"
 #include "Button.h"
 #include "Label.h"
+#include "ParticleEmitter.h"
 
 class PlayScene : public Scene
 {
@@ -31,6 +32,10 @@ private:
 	Player* m_pPlayer{};
 	bool m_playerFacingRight{};
 
+	// Effects
+	ParticleEmitter* m_pExplosion{};
+	ParticleEmitter* m_pTrail{};
+
 	// UI Items
 	Button* m_pBackButton{};
 	Button* m_pNextButton{};
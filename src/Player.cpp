@@ -1,14 +1,24 @@
 #include "Player.h"
 #include "TextureManager.h"
 
+namespace
+{
+	// everything the player looks up in the shared sheet, so a typo fails in one place
+	constexpr auto SHEET_DATA = "../Assets/sprites/atlas.txt";
+	constexpr auto SHEET_TEXTURE = "../Assets/sprites/atlas.png";
+	constexpr auto SHEET_NAME = "spritesheet";
+
+	constexpr auto IDLE_CLIP = "idle";
+	constexpr const char* IDLE_FRAMES[] = { "megaman-idle-0", "megaman-idle-1", "megaman-idle-2", "megaman-idle-3" };
+	constexpr auto RUN_CLIP = "run";
+	constexpr const char* RUN_FRAMES[] = { "megaman-run-0", "megaman-run-1", "megaman-run-2", "megaman-run-3" };
+}
+
 Player::Player(): m_currentAnimationState(PlayerAnimationState::PLAYER_IDLE_RIGHT)
 {
-	TextureManager::Instance().LoadSpriteSheet(
-		"../Assets/sprites/atlas.txt",
-		"../Assets/sprites/atlas.png", 
-		"spritesheet");
+	TextureManager::Instance().LoadSpriteSheet(SHEET_DATA, SHEET_TEXTURE, SHEET_NAME);
 
-	SetSpriteSheet(TextureManager::Instance().GetSpriteSheet("spritesheet"));
+	SetSpriteSheet(TextureManager::Instance().GetSpriteSheet(SHEET_NAME));
 	
 	// set frame width
 	SetWidth(53);
@@ -34,20 +44,14 @@ void Player::Draw()
 	switch(m_currentAnimationState)
 	{
 	case PlayerAnimationState::PLAYER_IDLE_RIGHT:
-		TextureManager::Instance().PlayAnimation("spritesheet", GetAnimation("idle"),
-			GetTransform()->position, 0.12f, 0, 255, true);
-		break;
-	case PlayerAnimationState::PLAYER_IDLE_LEFT:
-		TextureManager::Instance().PlayAnimation("spritesheet", GetAnimation("idle"),
-			GetTransform()->position, 0.12f, 0, 255, true, SDL_FLIP_HORIZONTAL);
-		break;
 	case PlayerAnimationState::PLAYER_RUN_RIGHT:
-		TextureManager::Instance().PlayAnimation("spritesheet", GetAnimation("run"),
-			GetTransform()->position, 0.25f, 0, 255, true);
+		TextureManager::Instance().DrawAnimation(SHEET_NAME, *GetAnimator(),
+			GetTransform()->position, 0, 255, true);
 		break;
+	case PlayerAnimationState::PLAYER_IDLE_LEFT:
 	case PlayerAnimationState::PLAYER_RUN_LEFT:
-		TextureManager::Instance().PlayAnimation("spritesheet", GetAnimation("run"),
-			GetTransform()->position, 0.25f, 0, 255, true, SDL_FLIP_HORIZONTAL);
+		TextureManager::Instance().DrawAnimation(SHEET_NAME, *GetAnimator(),
+			GetTransform()->position, 0, 255, true, SDL_FLIP_HORIZONTAL);
 		break;
 	default:
 		break;
@@ -65,27 +69,45 @@ void Player::Clean()
 void Player::SetAnimationState(const PlayerAnimationState new_state)
 {
 	m_currentAnimationState = new_state;
+
+	switch (m_currentAnimationState)
+	{
+	case PlayerAnimationState::PLAYER_IDLE_RIGHT:
+	case PlayerAnimationState::PLAYER_IDLE_LEFT:
+		PlayAnimationClip(IDLE_CLIP);
+		break;
+	case PlayerAnimationState::PLAYER_RUN_RIGHT:
+	case PlayerAnimationState::PLAYER_RUN_LEFT:
+		PlayAnimationClip(RUN_CLIP);
+		break;
+	default:
+		break;
+	}
 }
 
 void Player::BuildAnimations()
 {
 	auto idle_animation = Animation();
 
-	idle_animation.name = "idle";
-	idle_animation.frames.push_back(GetSpriteSheet()->GetFrame("megaman-idle-0"));
-	idle_animation.frames.push_back(GetSpriteSheet()->GetFrame("megaman-idle-1"));
-	idle_animation.frames.push_back(GetSpriteSheet()->GetFrame("megaman-idle-2"));
-	idle_animation.frames.push_back(GetSpriteSheet()->GetFrame("megaman-idle-3"));
+	idle_animation.name = IDLE_CLIP;
+	for (const auto frame : IDLE_FRAMES)
+	{
+		idle_animation.frames.push_back(GetSpriteSheet()->GetFrame(frame));
+	}
 
 	SetAnimation(idle_animation);
+	AddAnimationClip(AnimationClip::FromAnimation(idle_animation, 3.5f));
 
 	auto run_animation = Animation();
 
-	run_animation.name = "run";
-	run_animation.frames.push_back(GetSpriteSheet()->GetFrame("megaman-run-0"));
-	run_animation.frames.push_back(GetSpriteSheet()->GetFrame("megaman-run-1"));
-	run_animation.frames.push_back(GetSpriteSheet()->GetFrame("megaman-run-2"));
-	run_animation.frames.push_back(GetSpriteSheet()->GetFrame("megaman-run-3"));
+	run_animation.name = RUN_CLIP;
+	for (const auto frame : RUN_FRAMES)
+	{
+		run_animation.frames.push_back(GetSpriteSheet()->GetFrame(frame));
+	}
 
 	SetAnimation(run_animation);
+	AddAnimationClip(AnimationClip::FromAnimation(run_animation, 7.5f));
+
+	SetAnimationState(m_currentAnimationState);
 }
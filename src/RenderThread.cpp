@@ -0,0 +1,217 @@
+#include "RenderThread.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include "Renderer.h"
+
+RenderThread::RenderThread() :
+	m_running(false), m_stopping(false), m_busy(false), m_maxQueuedFrames(2), m_pRecording(nullptr),
+	m_presentedFrameCount(0), m_averageLatency(0.0), m_framesPerSecond(0.0), m_lastWaitTime(0.0)
+{
+}
+
+RenderThread::~RenderThread()
+{
+	Stop();
+}
+
+bool RenderThread::Start(const int max_queued_frames)
+{
+	if (m_running)
+	{
+		return true;
+	}
+
+	SDL_RendererInfo info;
+	if (SDL_GetRendererInfo(Renderer::Instance().GetRenderer(), &info) != 0)
+	{
+		std::cout << "render thread: no renderer" << std::endl;
+		return false;
+	}
+
+	if (strncmp(info.name, "opengl", 6) == 0)
+	{
+		std::cout << "render thread: not supported by the " << info.name << " renderer" << std::endl;
+		return false;
+	}
+
+	// one list being recorded plus the ones waiting in the queue
+	m_maxQueuedFrames = std::max(1, std::min(max_queued_frames, 2));
+	m_drawLists.clear();
+	m_freeLists.clear();
+	m_queue.clear();
+	for (auto i = 0; i < m_maxQueuedFrames + 1; ++i)
+	{
+		m_drawLists.push_back(std::make_unique<DrawList>());
+		m_freeLists.push_back(m_drawLists.back().get());
+	}
+
+	m_stopping = false;
+	m_busy = false;
+	m_presentedFrameCount = 0;
+	m_running = true;
+	m_thread = std::thread(&RenderThread::Run, this);
+
+	std::cout << "render thread started (" << info.name << ", " << m_maxQueuedFrames << " queued frames)" << std::endl;
+	return true;
+}
+
+void RenderThread::Stop()
+{
+	if (!m_running)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_frameQueued.notify_all();
+	m_thread.join();
+
+	m_running = false;
+	m_pRecording = nullptr;
+	std::cout << "render thread stopped" << std::endl;
+}
+
+bool RenderThread::IsRunning() const
+{
+	return m_running;
+}
+
+DrawList& RenderThread::BeginFrame()
+{
+	const auto start = SDL_GetPerformanceCounter();
+	{
+		// back pressure - wait for the render thread to hand a list back when the queue is full
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_frameDone.wait(lock, [this] { return !m_freeLists.empty(); });
+		m_pRecording = m_freeLists.back();
+		m_freeLists.pop_back();
+	}
+	m_lastWaitTime = static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+
+	m_pRecording->Reset();
+	return *m_pRecording;
+}
+
+void RenderThread::EndFrame()
+{
+	if (m_pRecording == nullptr)
+	{
+		return;
+	}
+
+	m_pRecording->SetSubmitTime(SDL_GetPerformanceCounter());
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_queue.push_back(m_pRecording);
+	}
+	m_pRecording = nullptr;
+	m_frameQueued.notify_one();
+}
+
+void RenderThread::WaitIdle()
+{
+	if (!m_running)
+	{
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_frameDone.wait(lock, [this] { return m_queue.empty() && !m_busy; });
+}
+
+std::mutex& RenderThread::GetDeviceMutex()
+{
+	return m_deviceMutex;
+}
+
+int RenderThread::GetMaxQueuedFrames() const
+{
+	return m_maxQueuedFrames;
+}
+
+int RenderThread::GetQueuedFrameCount()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return static_cast<int>(m_queue.size());
+}
+
+Uint64 RenderThread::GetPresentedFrameCount() const
+{
+	return m_presentedFrameCount;
+}
+
+double RenderThread::GetAverageLatency() const
+{
+	return m_averageLatency;
+}
+
+double RenderThread::GetFramesPerSecond() const
+{
+	return m_framesPerSecond;
+}
+
+double RenderThread::GetLastWaitTime() const
+{
+	return m_lastWaitTime;
+}
+
+void RenderThread::Run()
+{
+	const auto frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+	auto window_start = SDL_GetPerformanceCounter();
+	auto window_frames = 0;
+	auto window_latency = 0.0;
+
+	while (true)
+	{
+		DrawList* draw_list;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_frameQueued.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+			if (m_queue.empty())
+			{
+				// stopping with nothing left to present
+				break;
+			}
+			draw_list = m_queue.front();
+			m_queue.pop_front();
+			m_busy = true;
+		}
+
+		{
+			std::lock_guard<std::mutex> device_lock(m_deviceMutex);
+			const auto renderer = Renderer::Instance().GetRenderer();
+			draw_list->Playback(renderer);
+			SDL_RenderPresent(renderer);
+		}
+
+		const auto now = SDL_GetPerformanceCounter();
+		window_latency += static_cast<double>(now - draw_list->GetSubmitTime()) * 1000.0 / frequency;
+		++window_frames;
+		++m_presentedFrameCount;
+
+		// publish the averages once a second
+		if (const auto elapsed = static_cast<double>(now - window_start) / frequency; elapsed >= 1.0)
+		{
+			m_averageLatency = window_latency / window_frames;
+			m_framesPerSecond = window_frames / elapsed;
+			window_start = now;
+			window_frames = 0;
+			window_latency = 0.0;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_freeLists.push_back(draw_list);
+			m_busy = false;
+		}
+		m_frameDone.notify_all();
+	}
+
+	// wake anyone still waiting on a frame
+	m_frameDone.notify_all();
+}
@@ -0,0 +1,91 @@
+#pragma once
+#ifndef __RENDER_THREAD__
+#define __RENDER_THREAD__
+
+// Core Libraries
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <SDL.h>
+
+#include "DrawList.h"
+
+/* Singleton
+ * Optional render thread. Each frame the main thread records the scene into a DrawList
+ * (BeginFrame / EndFrame) and queues it; the render thread plays queued lists back on the
+ * main renderer and presents them, so simulation of frame N+1 overlaps submission of frame N.
+ * At most max_queued_frames lists wait in the queue - BeginFrame blocks when it is full.
+ *
+ * The render thread and the main thread share one SDL_Renderer. Creating or updating textures from
+ * the main thread must hold GetDeviceMutex(), and textures that queued frames may still reference
+ * must only be destroyed after WaitIdle(). SDL's OpenGL renderers tie their context to the thread
+ * that created it, so Start refuses to run on them.
+ */
+class RenderThread
+{
+public:
+	static RenderThread& Instance()
+	{
+		static RenderThread instance;
+		return instance;
+	}
+
+	bool Start(int max_queued_frames = 2);
+	void Stop();
+	[[nodiscard]] bool IsRunning() const;
+
+	// main thread - returns an empty list to record the next frame into
+	DrawList& BeginFrame();
+	// main thread - queues the list returned by BeginFrame for playback and present
+	void EndFrame();
+	// blocks until every queued frame has been presented
+	void WaitIdle();
+
+	// held by the render thread while it talks to the renderer
+	[[nodiscard]] std::mutex& GetDeviceMutex();
+
+	// counters
+	[[nodiscard]] int GetMaxQueuedFrames() const;
+	[[nodiscard]] int GetQueuedFrameCount();
+	[[nodiscard]] Uint64 GetPresentedFrameCount() const;
+	// milliseconds from EndFrame to the end of SDL_RenderPresent, averaged over the last second
+	[[nodiscard]] double GetAverageLatency() const;
+	// presents per second over the last second
+	[[nodiscard]] double GetFramesPerSecond() const;
+	// milliseconds the main thread spent blocked in BeginFrame last frame
+	[[nodiscard]] double GetLastWaitTime() const;
+
+private:
+	RenderThread();
+	~RenderThread();
+
+	void Run();
+
+	std::thread m_thread;
+	std::mutex m_mutex;
+	std::mutex m_deviceMutex;
+	std::condition_variable m_frameQueued;
+	std::condition_variable m_frameDone;
+	bool m_running;
+	bool m_stopping;
+	bool m_busy;
+
+	int m_maxQueuedFrames;
+	std::vector<std::unique_ptr<DrawList>> m_drawLists;
+	std::vector<DrawList*> m_freeLists;
+	std::deque<DrawList*> m_queue;
+	DrawList* m_pRecording;
+
+	// statistics, written by the render thread
+	std::atomic<Uint64> m_presentedFrameCount;
+	std::atomic<double> m_averageLatency;
+	std::atomic<double> m_framesPerSecond;
+	double m_lastWaitTime;
+};
+
+#endif /* defined (__RENDER_THREAD__) */
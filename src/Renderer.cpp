@@ -1,6 +1,7 @@
 #include "Renderer.h"
 
 #include <utility>
+#include "DrawList.h"
 
 /**
  * \brief Get Accessor function used to return a reference to the SDL_Renderer 
@@ -20,8 +21,113 @@ void Renderer::SetRenderer(std::shared_ptr<SDL_Renderer> renderer)
 	m_pRenderer = std::move(renderer);
 }
 
-Renderer::Renderer()
-= default;
+DrawList* Renderer::GetDrawList() const
+{
+	return m_pDrawList;
+}
+
+bool Renderer::IsRecording() const
+{
+	return m_pDrawList != nullptr;
+}
+
+void Renderer::SetDrawList(DrawList* draw_list)
+{
+	m_pDrawList = draw_list;
+}
+
+void Renderer::SetDrawColour(const Uint8 r, const Uint8 g, const Uint8 b, const Uint8 a, SDL_Renderer* renderer) const
+{
+	if (const auto draw_list = GetRecorder(renderer))
+	{
+		draw_list->SetDrawColour({ r, g, b, a });
+		return;
+	}
+	SDL_SetRenderDrawColor(renderer ? renderer : GetRenderer(), r, g, b, a);
+}
+
+void Renderer::Clear(SDL_Renderer* renderer) const
+{
+	if (const auto draw_list = GetRecorder(renderer))
+	{
+		draw_list->Clear();
+		return;
+	}
+	SDL_RenderClear(renderer ? renderer : GetRenderer());
+}
+
+void Renderer::Copy(SDL_Texture* texture, const SDL_Rect* src_rect, const SDL_Rect* dest_rect, const double angle,
+	const SDL_RendererFlip flip, const Uint8 alpha, SDL_Renderer* renderer) const
+{
+	if (const auto draw_list = GetRecorder(renderer))
+	{
+		draw_list->Copy(texture, src_rect, dest_rect, angle, flip, alpha);
+		return;
+	}
+	SDL_SetTextureAlphaMod(texture, alpha);
+	SDL_RenderCopyEx(renderer ? renderer : GetRenderer(), texture, src_rect, dest_rect, angle, nullptr, flip);
+}
+
+void Renderer::DrawGeometry(SDL_Texture* texture, const SDL_Vertex* vertices, const int vertex_count, const int* indices,
+	const int index_count, SDL_Renderer* renderer) const
+{
+	if (const auto draw_list = GetRecorder(renderer))
+	{
+		draw_list->DrawGeometry(texture, vertices, vertex_count, indices, index_count);
+		return;
+	}
+	SDL_RenderGeometry(renderer ? renderer : GetRenderer(), texture, vertices, vertex_count, indices, index_count);
+}
+
+void Renderer::DrawLines(const SDL_FPoint* points, const int count, SDL_Renderer* renderer) const
+{
+	if (const auto draw_list = GetRecorder(renderer))
+	{
+		draw_list->DrawLines(points, count);
+		return;
+	}
+	SDL_RenderDrawLinesF(renderer ? renderer : GetRenderer(), points, count);
+}
+
+void Renderer::DrawPoints(const SDL_FPoint* points, const int count, SDL_Renderer* renderer) const
+{
+	if (const auto draw_list = GetRecorder(renderer))
+	{
+		draw_list->DrawPoints(points, count);
+		return;
+	}
+	SDL_RenderDrawPointsF(renderer ? renderer : GetRenderer(), points, count);
+}
+
+void Renderer::DrawRect(const SDL_FRect& rect, SDL_Renderer* renderer) const
+{
+	if (const auto draw_list = GetRecorder(renderer))
+	{
+		draw_list->DrawRect(rect);
+		return;
+	}
+	SDL_RenderDrawRectF(renderer ? renderer : GetRenderer(), &rect);
+}
+
+void Renderer::FillRect(const SDL_FRect& rect, SDL_Renderer* renderer) const
+{
+	if (const auto draw_list = GetRecorder(renderer))
+	{
+		draw_list->FillRect(rect);
+		return;
+	}
+	SDL_RenderFillRectF(renderer ? renderer : GetRenderer(), &rect);
+}
+
+DrawList* Renderer::GetRecorder(SDL_Renderer* renderer) const
+{
+	return (renderer == nullptr || renderer == GetRenderer()) ? m_pDrawList : nullptr;
+}
+
+Renderer::Renderer() :
+	m_pDrawList(nullptr)
+{
+}
 
 Renderer::~Renderer()
 = default;
@@ -4,6 +4,8 @@
 #include <SDL.h>
 #include "Config.h"
 
+class DrawList;
+
 /* Singleton */
 class Renderer
 {
@@ -18,11 +20,33 @@ public:
 	SDL_Renderer* GetRenderer() const;
 	void SetRenderer(std::shared_ptr<SDL_Renderer> renderer);
 
+	// while a DrawList is set, draw calls aimed at the main renderer are recorded into it
+	// instead of being issued (render thread mode)
+	[[nodiscard]] DrawList* GetDrawList() const;
+	[[nodiscard]] bool IsRecording() const;
+	void SetDrawList(DrawList* draw_list);
+
+	// drawing functions - renderer defaults to the main renderer
+	void SetDrawColour(Uint8 r, Uint8 g, Uint8 b, Uint8 a, SDL_Renderer* renderer = nullptr) const;
+	void Clear(SDL_Renderer* renderer = nullptr) const;
+	void Copy(SDL_Texture* texture, const SDL_Rect* src_rect, const SDL_Rect* dest_rect, double angle = 0,
+		SDL_RendererFlip flip = SDL_FLIP_NONE, Uint8 alpha = 255, SDL_Renderer* renderer = nullptr) const;
+	void DrawGeometry(SDL_Texture* texture, const SDL_Vertex* vertices, int vertex_count, const int* indices, int index_count,
+		SDL_Renderer* renderer = nullptr) const;
+	void DrawLines(const SDL_FPoint* points, int count, SDL_Renderer* renderer = nullptr) const;
+	void DrawPoints(const SDL_FPoint* points, int count, SDL_Renderer* renderer = nullptr) const;
+	void DrawRect(const SDL_FRect& rect, SDL_Renderer* renderer = nullptr) const;
+	void FillRect(const SDL_FRect& rect, SDL_Renderer* renderer = nullptr) const;
+
 private:
 	Renderer();
 	~Renderer();
 
+	// returns the draw list to record into, or nullptr if the call should go straight to SDL
+	[[nodiscard]] DrawList* GetRecorder(SDL_Renderer* renderer) const;
+
 	std::shared_ptr<SDL_Renderer> m_pRenderer;
+	DrawList* m_pDrawList;
 };
 
-#endif /* defined (__RENDERER__) */
\ No newline at end of file
+#endif /* defined (__RENDERER__) */
@@ -2,6 +2,7 @@
 #ifndef __RIGID_BODY__
 #define __RIGID_BODY__
 #include <glm/vec2.hpp>
+#include <cstdint>
 
 struct RigidBody
 {
@@ -11,5 +12,19 @@ struct RigidBody
 	glm::vec2 velocity;
 	glm::vec2 acceleration;
 	bool isColliding = false;
+	// fast bodies opt in to swept checks so they cannot pass through thin objects between two steps
+	bool isContinuous = false;
+
+	// integrated by the PhysicsWorld - force is applied (divided by mass, 1 if unset) on the next step and cleared
+	glm::vec2 force = glm::vec2(0.0f, 0.0f);
+	// fraction of velocity kept after one second (1 = no damping)
+	float damping = 1.0f;
+	// bodies at rest stop being integrated until something sets their velocity, acceleration or force
+	bool isSleeping = false;
+	float sleepTime = 0.0f;
+
+	// collision filtering (see CollisionFilter) - a pair is tested only if each category is in the other's mask
+	std::uint32_t categoryBits = 0x80000000u;
+	std::uint32_t maskBits = 0xFFFFFFFFu;
 };
 #endif /* defined (__RIGID_BODY__) */
\ No newline at end of file
@@ -1,8 +1,13 @@
 #include "Scene.h"
 
 #include <algorithm>
+#include <iostream>
 
 #include "DisplayObject.h"
+#include "Renderer.h"
+#include "Animator.h"
+#include "CollisionEventQueue.h"
+#include "Game.h"
 
 Scene::Scene()
 = default;
@@ -29,16 +34,26 @@ void Scene::AddChild(DisplayObject * child, uint32_t layer_index, std::optional<
 	child->SetLayerIndex(layer_index, index);
 	child->m_pParentScene = this;
 	m_displayList.push_back(child);
+	InvalidateLayer(layer_index);
+
+	if (const auto animator = child->GetAnimator(); animator != nullptr)
+	{
+		m_animators.push_back(animator);
+	}
 }
 
 void Scene::RemoveChild(DisplayObject * child)
 {
+	InvalidateLayer(child->m_layerIndex);
+	m_animators.erase(std::remove(m_animators.begin(), m_animators.end(), child->GetAnimator()), m_animators.end());
+	CollisionEventQueue::Instance().RemoveObject(child);
 	delete child;
 	m_displayList.erase(std::remove(m_displayList.begin(), m_displayList.end(), child), m_displayList.end());
 }
 
 void Scene::RemoveAllChildren()
 {
+	CollisionEventQueue::Instance().Clear();
 	for (auto& count : m_displayList)
 	{
 		delete count;
@@ -46,6 +61,15 @@ void Scene::RemoveAllChildren()
 	}
 
 	m_displayList.clear();
+	m_animators.clear();
+
+	// keep the static flags but release the cached textures
+	for (auto& [layer_index, cache] : m_layerCaches)
+	{
+		cache.texture = nullptr;
+		cache.children.clear();
+		cache.dirty = true;
+	}
 }
 
 
@@ -74,6 +98,8 @@ bool Scene::SortObjects(DisplayObject * left, DisplayObject * right)
 
 void Scene::UpdateDisplayList()
 {
+	UpdateAnimators(Game::Instance().GetDeltaTime());
+
 	std::sort(m_displayList.begin(), m_displayList.end(), SortObjects);
 	for (auto& display_object : m_displayList)
 	{
@@ -86,19 +112,55 @@ void Scene::UpdateDisplayList()
 	}
 }
 
+void Scene::UpdateAnimators(const float delta_time)
+{
+	for (const auto animator : m_animators)
+	{
+		animator->Advance(delta_time);
+	}
+}
+
 void Scene::DrawDisplayList()
 {
 	std::sort(m_displayList.begin(), m_displayList.end(), SortObjects);
-	for (auto& display_object : m_displayList)
+	for (size_t i = 0; i < m_displayList.size();)
 	{
-		if (display_object != nullptr)
+		const auto display_object = m_displayList[i];
+		if (display_object == nullptr)
+		{
+			++i;
+			continue;
+		}
+
+		// objects of a static layer are contiguous after sorting - draw them as one block. Removed or disabled
+		// children inside the block are skipped without ending it, so the layer stays one cached image.
+		// a recorded frame is played back later on the render thread, so the render target is not touched then
+		if (const auto cache = m_layerCaches.find(display_object->m_layerIndex);
+			cache != m_layerCaches.end() && display_object->IsEnabled() && !Renderer::Instance().IsRecording())
 		{
-			if (display_object->IsEnabled() && display_object->IsVisible())
+			auto last = i;
+			while (last < m_displayList.size() &&
+				(m_displayList[last] == nullptr || !m_displayList[last]->IsEnabled() ||
+					m_displayList[last]->m_layerIndex == display_object->m_layerIndex))
 			{
-				display_object->Draw();
+				++last;
+			}
+			// trailing removed or disabled objects are not part of the block
+			while (m_displayList[last - 1] == nullptr || !m_displayList[last - 1]->IsEnabled())
+			{
+				--last;
 			}
 
+			DrawStaticLayer(cache->second, i, last);
+			i = last;
+			continue;
+		}
+
+		if (display_object->IsEnabled() && display_object->IsVisible())
+		{
+			display_object->Draw();
 		}
+		++i;
 	}
 
 }
@@ -107,3 +169,146 @@ std::vector<DisplayObject*> Scene::GetDisplayList() const
 {
 	return m_displayList;
 }
+
+void Scene::SetLayerStatic(const uint32_t layer_index, const bool state)
+{
+	if (state)
+	{
+		m_layerCaches[layer_index].dirty = true;
+	}
+	else
+	{
+		m_layerCaches.erase(layer_index);
+	}
+}
+
+bool Scene::IsLayerStatic(const uint32_t layer_index) const
+{
+	return m_layerCaches.find(layer_index) != m_layerCaches.end();
+}
+
+void Scene::InvalidateLayer(const uint32_t layer_index)
+{
+	if (const auto cache = m_layerCaches.find(layer_index); cache != m_layerCaches.end())
+	{
+		cache->second.dirty = true;
+	}
+}
+
+/**
+ * \brief Updates the stored child state of a static layer, skipping removed and disabled children
+ * \return true if any child moved, rotated, resized, changed visibility or the set of children changed
+ */
+bool Scene::CaptureLayerState(LayerCache& cache, const size_t first, const size_t last) const
+{
+	auto changed = false;
+	size_t child_count = 0;
+
+	for (auto i = first; i < last; ++i)
+	{
+		const auto display_object = m_displayList[i];
+		if (display_object == nullptr || !display_object->IsEnabled())
+		{
+			continue;
+		}
+
+		if (child_count == cache.children.size())
+		{
+			cache.children.emplace_back();
+		}
+		auto& state = cache.children[child_count++];
+
+		const auto position = display_object->GetTransform()->position;
+		const auto rotation = display_object->GetRotation();
+		const auto width = display_object->GetWidth();
+		const auto height = display_object->GetHeight();
+		const auto visible = display_object->IsVisible();
+
+		if (state.object != display_object || state.position != position || state.rotation != rotation ||
+			state.width != width || state.height != height || state.visible != visible)
+		{
+			changed = true;
+			state.object = display_object;
+			state.position = position;
+			state.rotation = rotation;
+			state.width = width;
+			state.height = height;
+			state.visible = visible;
+		}
+	}
+
+	if (child_count != cache.children.size())
+	{
+		changed = true;
+		cache.children.resize(child_count);
+	}
+
+	return changed;
+}
+
+void Scene::DrawStaticLayer(LayerCache& cache, const size_t first, const size_t last)
+{
+	SDL_Renderer* renderer = Renderer::Instance().GetRenderer();
+
+	if (CaptureLayerState(cache, first, last))
+	{
+		cache.dirty = true;
+	}
+
+	// lazily create a screen sized render target for the layer
+	if (cache.texture == nullptr && cache.supported)
+	{
+		int width, height;
+		SDL_GetRendererOutputSize(renderer, &width, &height);
+		cache.texture = Config::MakeResource(SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height));
+
+		if (cache.texture == nullptr)
+		{
+			std::cout << "static layer cache unavailable: " << SDL_GetError() << std::endl;
+			cache.supported = false;
+		}
+		else
+		{
+			// the cache holds colour already multiplied by alpha, so it is composited as premultiplied
+			SDL_SetTextureBlendMode(cache.texture.get(), SDL_ComposeCustomBlendMode(
+				SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+				SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD));
+			cache.dirty = true;
+		}
+	}
+
+	// fall back to drawing the children directly
+	if (!cache.supported)
+	{
+		for (auto i = first; i < last; ++i)
+		{
+			if (m_displayList[i] != nullptr && m_displayList[i]->IsEnabled() && m_displayList[i]->IsVisible())
+			{
+				m_displayList[i]->Draw();
+			}
+		}
+		return;
+	}
+
+	if (cache.dirty)
+	{
+		SDL_Texture* previous_target = SDL_GetRenderTarget(renderer);
+		SDL_SetRenderTarget(renderer, cache.texture.get());
+		SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+		SDL_RenderClear(renderer);
+		SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+
+		for (auto i = first; i < last; ++i)
+		{
+			if (m_displayList[i] != nullptr && m_displayList[i]->IsEnabled() && m_displayList[i]->IsVisible())
+			{
+				m_displayList[i]->Draw();
+			}
+		}
+
+		SDL_SetRenderTarget(renderer, previous_target);
+		cache.dirty = false;
+	}
+
+	SDL_RenderCopy(renderer, cache.texture.get(), nullptr, nullptr);
+}
@@ -4,8 +4,12 @@
 
 #include <vector>
 #include <optional>
+#include <memory>
+#include <unordered_map>
+#include <SDL.h>
 #include "GameObject.h"
 
+class Animator;
 
 class Scene : public GameObject
 {
@@ -30,13 +34,54 @@ public:
 	void UpdateDisplayList();
 	void DrawDisplayList();
 
+	// advances every animator in the scene in a single pass
+	void UpdateAnimators(float delta_time);
+
 	[[nodiscard]] std::vector<DisplayObject*> GetDisplayList() const;
 
+	/*
+	 * Marks a layer as static. A static layer is composited once into a render target texture
+	 * and drawn with a single blit until one of its children changes.
+	 */
+	void SetLayerStatic(uint32_t layer_index, bool state = true);
+	[[nodiscard]] bool IsLayerStatic(uint32_t layer_index) const;
+	/*
+	 * Forces a static layer to be re-composited on the next draw
+	 */
+	void InvalidateLayer(uint32_t layer_index);
+
 private:
 	uint32_t m_nextLayerIndex = 0;
 	std::vector<DisplayObject*> m_displayList;
 
+	// animators of the children, gathered on AddChild
+	std::vector<Animator*> m_animators;
+
 	static bool SortObjects(DisplayObject* left, DisplayObject* right);
+
+	// the per-child state that is compared each frame to detect changes in a static layer
+	struct LayerChildState
+	{
+		const DisplayObject* object = nullptr;
+		glm::vec2 position{};
+		float rotation = 0.0f;
+		int width = 0;
+		int height = 0;
+		bool visible = false;
+	};
+
+	struct LayerCache
+	{
+		std::shared_ptr<SDL_Texture> texture;
+		std::vector<LayerChildState> children;
+		bool dirty = true;
+		bool supported = true;
+	};
+
+	void DrawStaticLayer(LayerCache& cache, size_t first, size_t last);
+	bool CaptureLayerState(LayerCache& cache, size_t first, size_t last) const;
+
+	std::unordered_map<uint32_t, LayerCache> m_layerCaches;
 };
 
 #endif /* defined (__SCENE__) */
@@ -17,6 +17,17 @@ Animation& Sprite::GetAnimation(const std::string& name)
 	return m_pAnimations[name];
 }
 
+const AnimationClip* Sprite::GetAnimationClip(const std::string& name) const
+{
+	const auto clip = m_animationClips.find(name);
+	return (clip != m_animationClips.end()) ? &clip->second : nullptr;
+}
+
+Animator* Sprite::GetAnimator()
+{
+	return &m_animator;
+}
+
 void Sprite::SetSpriteSheet(SpriteSheet* sprite_sheet)
 {
 	m_pSpriteSheet = sprite_sheet;
@@ -30,6 +41,23 @@ void Sprite::SetAnimation(const Animation& animation)
 	}
 }
 
+void Sprite::AddAnimationClip(const AnimationClip& clip)
+{
+	auto& stored_clip = m_animationClips[clip.name];
+	stored_clip = clip;
+
+	// the frame table may have changed size under a playing animator
+	if (m_animator.GetClip() == &stored_clip)
+	{
+		m_animator.Play(&stored_clip, true);
+	}
+}
+
+void Sprite::PlayAnimationClip(const std::string& name, const bool restart)
+{
+	m_animator.Play(GetAnimationClip(name), restart);
+}
+
 bool Sprite::CheckIfAnimationExists(const std::string& id)
 {
 	return m_pAnimations.find(id) != m_pAnimations.end();
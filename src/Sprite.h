@@ -4,6 +4,8 @@
 
 #include "DisplayObject.h"
 #include "Animation.h"
+#include "AnimationClip.h"
+#include "Animator.h"
 #include <unordered_map>
 #include "SpriteSheet.h"
 
@@ -21,10 +23,16 @@ public:
 	// getters
 	SpriteSheet* GetSpriteSheet();
 	Animation& GetAnimation(const std::string& name);
+	[[nodiscard]] const AnimationClip* GetAnimationClip(const std::string& name) const;
+	Animator* GetAnimator() override;
 	
 	// setters
 	void SetSpriteSheet(SpriteSheet* sprite_sheet);
 	void SetAnimation(const Animation& animation);
+	void AddAnimationClip(const AnimationClip& clip);
+
+	// starts playing the named clip on this sprite's animator
+	void PlayAnimationClip(const std::string& name, bool restart = false);
 private:
 	// private utility functions
 	bool CheckIfAnimationExists(const std::string& id);
@@ -32,6 +40,10 @@ private:
 	SpriteSheet* m_pSpriteSheet;
 
 	std::unordered_map<std::string, Animation> m_pAnimations;
+
+	// clips are node based so the pointers handed to the animator stay valid
+	std::unordered_map<std::string, AnimationClip> m_animationClips;
+	Animator m_animator;
 };
 
 #endif /* defined (__SPRITE__) */
\ No newline at end of file
@@ -14,9 +14,30 @@ SpriteSheet::SpriteSheet(std::string name)
 SpriteSheet::~SpriteSheet()
 = default;
 
-Frame SpriteSheet::GetFrame(const std::string& frame_name)
+/**
+ * \brief Looks up the id of a frame by name
+ * \return the frame id, -1 if the sheet has no frame called frame_name
+ */
+int SpriteSheet::GetFrameId(const std::string& frame_name) const
 {
-	return m_frames[frame_name];
+	const auto frame_id = m_frameIds.find(frame_name);
+	return (frame_id != m_frameIds.end()) ? frame_id->second : -1;
+}
+
+const Frame& SpriteSheet::GetFrame(const int frame_id) const
+{
+	static const Frame empty_frame;
+	return (frame_id >= 0 && frame_id < static_cast<int>(m_frames.size())) ? m_frames[frame_id] : empty_frame;
+}
+
+const Frame& SpriteSheet::GetFrame(const std::string& frame_name) const
+{
+	return GetFrame(GetFrameId(frame_name));
+}
+
+int SpriteSheet::GetFrameCount() const
+{
+	return static_cast<int>(m_frames.size());
 }
 
 SDL_Texture* SpriteSheet::GetTexture() const
@@ -24,12 +45,34 @@ SDL_Texture* SpriteSheet::GetTexture() const
 	return m_pTexture;
 }
 
+const AnimationClip* SpriteSheet::GetClip(const std::string& clip_name) const
+{
+	const auto clip = m_clips.find(clip_name);
+	return (clip != m_clips.end()) ? &clip->second : nullptr;
+}
+
 void SpriteSheet::SetTexture(SDL_Texture* texture)
 {
 	m_pTexture = texture;
 }
 
-void SpriteSheet::AddFrame(const Frame& frame)
+int SpriteSheet::AddFrame(const std::string_view frame_name, const Frame& frame)
+{
+	const auto [frame_id, inserted] = m_frameIds.try_emplace(std::string(frame_name), static_cast<int>(m_frames.size()));
+	if (inserted)
+	{
+		m_frames.push_back(frame);
+	}
+	else
+	{
+		m_frames[frame_id->second] = frame;
+	}
+
+	return frame_id->second;
+}
+
+void SpriteSheet::AddClip(AnimationClip clip)
 {
-	m_frames[frame.name] = frame;
+	auto name = clip.name;
+	m_clips[std::move(name)] = std::move(clip);
 }
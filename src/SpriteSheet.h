@@ -1,10 +1,13 @@
 #pragma once
 #ifndef __SPRITE_SHEET__
 #define __SPRITE_SHEET__
+#include <string>
+#include <string_view>
 #include <vector>
 #include "Frame.h"
 #include <unordered_map>
 #include <SDL.h>
+#include "AnimationClip.h"
 
 class SpriteSheet
 {
@@ -14,17 +17,28 @@ public:
 	~SpriteSheet();
 
 	// getters
-	Frame GetFrame(const std::string& frame_name);
+	// frame names are interned to ids at load, look the id up once and keep it
+	[[nodiscard]] int GetFrameId(const std::string& frame_name) const;
+	[[nodiscard]] const Frame& GetFrame(int frame_id) const;
+	[[nodiscard]] const Frame& GetFrame(const std::string& frame_name) const;
+	[[nodiscard]] int GetFrameCount() const;
 	[[nodiscard]] SDL_Texture* GetTexture() const;
+	// clips read from the data file (JSON animations blocks), nullptr if there is no clip called clip_name
+	[[nodiscard]] const AnimationClip* GetClip(const std::string& clip_name) const;
 
 	// setters
-	void AddFrame(const Frame& frame);
+	// returns the id of the frame, adding a name twice replaces the frame and keeps its id
+	int AddFrame(std::string_view frame_name, const Frame& frame);
+	void AddClip(AnimationClip clip);
 	void SetTexture(SDL_Texture* texture);
 	
 private:
 	std::string m_name;
 
-	std::unordered_map<std::string, Frame> m_frames;
+	// frames are stored flat and indexed by id
+	std::vector<Frame> m_frames;
+	std::unordered_map<std::string, int> m_frameIds;
+	std::unordered_map<std::string, AnimationClip> m_clips;
 
 	SDL_Texture* m_pTexture;
 };
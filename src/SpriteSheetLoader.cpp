@@ -0,0 +1,723 @@
+#include "SpriteSheetLoader.h"
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <SDL.h>
+#include "Frame.h"
+#include "MappedFile.h"
+#include "SpriteSheet.h"
+
+namespace
+{
+	// forward only reader over a buffer that is not null terminated
+	struct Cursor
+	{
+		const char* position;
+		const char* end;
+
+		[[nodiscard]] bool AtEnd() const
+		{
+			return position >= end;
+		}
+
+		void SkipWhitespace()
+		{
+			while (position < end && (*position == ' ' || *position == '\t' || *position == '\r' || *position == '\n'))
+			{
+				++position;
+			}
+		}
+
+		void SkipBlanks()
+		{
+			while (position < end && (*position == ' ' || *position == '\t'))
+			{
+				++position;
+			}
+		}
+
+		void SkipLine()
+		{
+			while (position < end && *position != '\n')
+			{
+				++position;
+			}
+			if (position < end)
+			{
+				++position;
+			}
+		}
+
+		[[nodiscard]] char Peek()
+		{
+			SkipWhitespace();
+			return AtEnd() ? '\0' : *position;
+		}
+
+		bool Match(const char c)
+		{
+			if (Peek() != c)
+			{
+				return false;
+			}
+			++position;
+			return true;
+		}
+
+		bool ReadInt(int& value)
+		{
+			SkipWhitespace();
+			const auto [next, error] = std::from_chars(position, end, value);
+			if (error != std::errc())
+			{
+				return false;
+			}
+			position = next;
+			return true;
+		}
+
+		// decimal numbers only (no exponent), that is all the atlas formats use
+		bool ReadNumber(float& value)
+		{
+			SkipWhitespace();
+			auto sign = 1.0f;
+			if (position < end && *position == '-')
+			{
+				sign = -1.0f;
+				++position;
+			}
+
+			const auto start = position;
+			auto result = 0.0f;
+			while (position < end && *position >= '0' && *position <= '9')
+			{
+				result = result * 10.0f + static_cast<float>(*position++ - '0');
+			}
+			if (position < end && *position == '.')
+			{
+				++position;
+				auto scale = 0.1f;
+				while (position < end && *position >= '0' && *position <= '9')
+				{
+					result += static_cast<float>(*position++ - '0') * scale;
+					scale *= 0.1f;
+				}
+			}
+
+			value = sign * result;
+			return position != start;
+		}
+
+		// reads a quoted string without unescaping it, the view points into the buffer
+		bool ReadString(std::string_view& value)
+		{
+			const auto quote = Peek();
+			if (quote != '"' && quote != '\'')
+			{
+				return false;
+			}
+
+			const auto start = ++position;
+			while (position < end && *position != quote)
+			{
+				position += (*position == '\\') ? 2 : 1;
+			}
+			if (position >= end)
+			{
+				return false;
+			}
+
+			value = std::string_view(start, static_cast<size_t>(position - start));
+			++position;
+			return true;
+		}
+
+		bool ReadWord(std::string_view& value)
+		{
+			SkipBlanks();
+			const auto start = position;
+			while (position < end && *position != ' ' && *position != '\t' && *position != '\r' && *position != '\n')
+			{
+				++position;
+			}
+			value = std::string_view(start, static_cast<size_t>(position - start));
+			return !value.empty();
+		}
+
+		// skips any JSON value
+		bool SkipValue()
+		{
+			switch (Peek())
+			{
+			case '"':
+			{
+				std::string_view unused;
+				return ReadString(unused);
+			}
+			case '[':
+			case '{':
+			{
+				auto depth = 0;
+				while (position < end)
+				{
+					const auto c = *position;
+					if (c == '"')
+					{
+						std::string_view unused;
+						if (!ReadString(unused))
+						{
+							return false;
+						}
+						continue;
+					}
+					++position;
+					if (c == '[' || c == '{')
+					{
+						++depth;
+					}
+					else if ((c == ']' || c == '}') && --depth == 0)
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+			default:
+				// numbers, true, false, null
+				while (position < end && *position != ',' && *position != '}' && *position != ']')
+				{
+					++position;
+				}
+				return true;
+			}
+		}
+	};
+
+	int ToInt(const std::string_view text)
+	{
+		auto value = 0;
+		std::from_chars(text.data(), text.data() + text.size(), value);
+		return value;
+	}
+
+	// "bullet.png" and "bullet" name the same frame
+	std::string_view StripExtension(const std::string_view name)
+	{
+		const auto dot = name.find_last_of('.');
+		const auto slash = name.find_last_of("/\\");
+		if (dot == std::string_view::npos || (slash != std::string_view::npos && dot < slash))
+		{
+			return name;
+		}
+		return name.substr(0, dot);
+	}
+
+	void AppendInt(std::string& text, const int value)
+	{
+		char digits[16];
+		const auto [last, error] = std::to_chars(digits, digits + sizeof(digits), value);
+		text.append(digits, last);
+	}
+
+	double ElapsedMilliseconds(const Uint64 start)
+	{
+		return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+	}
+}
+
+bool SpriteSheetLoader::Load(const std::string& data_file_name, SpriteSheet& sprite_sheet)
+{
+	MappedFile data_file;
+	if (!data_file.Open(data_file_name))
+	{
+		std::cout << "error opening file: " << data_file_name << std::endl;
+		return false;
+	}
+
+	if (!Parse(std::string_view(reinterpret_cast<const char*>(data_file.GetData()), data_file.GetSize()), sprite_sheet))
+	{
+		std::cout << "error parsing sprite sheet: " << data_file_name << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+bool SpriteSheetLoader::Parse(std::string_view data, SpriteSheet& sprite_sheet)
+{
+	// UTF-8 byte order mark
+	if (data.substr(0, 3) == "\xEF\xBB\xBF")
+	{
+		data.remove_prefix(3);
+	}
+
+	Cursor cursor{ data.data(), data.data() + data.size() };
+	switch (cursor.Peek())
+	{
+	case '{':
+		return ParseJSON(data, sprite_sheet);
+	case '<':
+		return ParseXML(data, sprite_sheet);
+	default:
+		return ParseText(data, sprite_sheet);
+	}
+}
+
+bool SpriteSheetLoader::ParseText(const std::string_view data, SpriteSheet& sprite_sheet)
+{
+	Cursor cursor{ data.data(), data.data() + data.size() };
+	Frame frame;
+
+	while (cursor.Peek() != '\0')
+	{
+		std::string_view name;
+		if (!cursor.ReadWord(name) ||
+			!cursor.ReadInt(frame.x) || !cursor.ReadInt(frame.y) || !cursor.ReadInt(frame.w) || !cursor.ReadInt(frame.h))
+		{
+			return false;
+		}
+
+		sprite_sheet.AddFrame(name, frame);
+
+		cursor.SkipLine();
+	}
+
+	return true;
+}
+
+bool SpriteSheetLoader::ParseXML(const std::string_view data, SpriteSheet& sprite_sheet)
+{
+	constexpr std::string_view sprite_tag = "<sprite";
+	Frame frame;
+
+	for (auto offset = data.find(sprite_tag); offset != std::string_view::npos; offset = data.find(sprite_tag, offset))
+	{
+		offset += sprite_tag.size();
+		Cursor cursor{ data.data() + offset, data.data() + data.size() };
+
+		std::string_view name;
+		frame.x = frame.y = frame.w = frame.h = 0;
+		auto rotated = false;
+
+		// attributes up to the end of the tag
+		while (cursor.Peek() != '/' && cursor.Peek() != '>' && !cursor.AtEnd())
+		{
+			const auto attribute_start = cursor.position;
+			while (!cursor.AtEnd() && *cursor.position != '=' && *cursor.position != ' ')
+			{
+				++cursor.position;
+			}
+			const std::string_view attribute(attribute_start, static_cast<size_t>(cursor.position - attribute_start));
+
+			std::string_view value;
+			if (!cursor.Match('=') || !cursor.ReadString(value))
+			{
+				return false;
+			}
+
+			if (attribute == "n")
+			{
+				name = StripExtension(value);
+			}
+			else if (attribute == "x")
+			{
+				frame.x = ToInt(value);
+			}
+			else if (attribute == "y")
+			{
+				frame.y = ToInt(value);
+			}
+			else if (attribute == "w")
+			{
+				frame.w = ToInt(value);
+			}
+			else if (attribute == "h")
+			{
+				frame.h = ToInt(value);
+			}
+			else if (attribute == "r" && value == "y")
+			{
+				rotated = true;
+			}
+		}
+
+		// TexturePacker turns these a quarter turn in the texture, frames are always drawn upright
+		if (rotated)
+		{
+			std::cout << "rotated sprite sheet frames are not supported: " << name << std::endl;
+			return false;
+		}
+
+		sprite_sheet.AddFrame(name, frame);
+
+		offset = static_cast<size_t>(cursor.position - data.data());
+	}
+
+	return true;
+}
+
+bool SpriteSheetLoader::ParseJSON(const std::string_view data, SpriteSheet& sprite_sheet)
+{
+	Cursor cursor{ data.data(), data.data() + data.size() };
+
+	// EaselJS frames are unnamed - they take their names from the animations that use them
+	struct FrameEntry
+	{
+		SDL_Rect rect;
+		std::string_view name;
+		std::string_view animation;
+		int animation_index;
+		bool single;
+	};
+	std::vector<FrameEntry> frames;
+
+	auto frame_rate = 0.0f;
+	Cursor animations{ nullptr, nullptr };
+
+	if (!cursor.Match('{'))
+	{
+		return false;
+	}
+
+	while (!cursor.Match('}'))
+	{
+		std::string_view key;
+		if (!cursor.ReadString(key) || !cursor.Match(':'))
+		{
+			return false;
+		}
+
+		if (key == "frames" && cursor.Peek() == '[')
+		{
+			cursor.Match('[');
+			while (!cursor.Match(']'))
+			{
+				FrameEntry entry{};
+				if (cursor.Match('['))
+				{
+					// [x, y, w, h, image index, reg x, reg y]
+					if (!cursor.ReadInt(entry.rect.x) || !cursor.Match(',') || !cursor.ReadInt(entry.rect.y) || !cursor.Match(',') ||
+						!cursor.ReadInt(entry.rect.w) || !cursor.Match(',') || !cursor.ReadInt(entry.rect.h))
+					{
+						return false;
+					}
+					while (!cursor.Match(']'))
+					{
+						if (!cursor.Match(',') || !cursor.SkipValue())
+						{
+							return false;
+						}
+					}
+				}
+				else if (cursor.Match('{'))
+				{
+					// { "filename": "name", "frame": { "x": 0, "y": 0, "w": 0, "h": 0 }, ... }
+					while (!cursor.Match('}'))
+					{
+						std::string_view field;
+						if (!cursor.ReadString(field) || !cursor.Match(':'))
+						{
+							return false;
+						}
+
+						if (field == "filename")
+						{
+							if (!cursor.ReadString(entry.name))
+							{
+								return false;
+							}
+							entry.name = StripExtension(entry.name);
+						}
+						else if (field == "frame" && cursor.Match('{'))
+						{
+							while (!cursor.Match('}'))
+							{
+								std::string_view component;
+								auto value = 0;
+								if (!cursor.ReadString(component) || !cursor.Match(':') || !cursor.ReadInt(value))
+								{
+									return false;
+								}
+								if (component == "x") entry.rect.x = value;
+								else if (component == "y") entry.rect.y = value;
+								else if (component == "w") entry.rect.w = value;
+								else if (component == "h") entry.rect.h = value;
+								cursor.Match(',');
+							}
+						}
+						else if (field == "rotated" && cursor.Peek() == 't')
+						{
+							std::cout << "rotated sprite sheet frames are not supported: " << entry.name << std::endl;
+							return false;
+						}
+						else if (!cursor.SkipValue())
+						{
+							return false;
+						}
+						cursor.Match(',');
+					}
+				}
+				else
+				{
+					return false;
+				}
+
+				frames.push_back(entry);
+				cursor.Match(',');
+			}
+		}
+		else if (key == "framerate")
+		{
+			if (!cursor.ReadNumber(frame_rate))
+			{
+				return false;
+			}
+		}
+		else if (key == "animations" && cursor.Peek() == '{')
+		{
+			// animations refer to frames by index, come back to them once every frame is known
+			animations.position = cursor.position;
+			if (!cursor.SkipValue())
+			{
+				return false;
+			}
+			animations.end = cursor.position;
+		}
+		else if (!cursor.SkipValue())
+		{
+			return false;
+		}
+
+		cursor.Match(',');
+	}
+
+	std::vector<int> frame_indices;
+	std::vector<AnimationClip> clips;
+
+	if (animations.position != nullptr)
+	{
+		animations.Match('{');
+		while (!animations.Match('}'))
+		{
+			std::string_view animation_name;
+			if (!animations.ReadString(animation_name) || !animations.Match(':'))
+			{
+				return false;
+			}
+
+			frame_indices.clear();
+			auto speed = 1.0f;
+			auto loop = true;
+
+			// EaselJS writes an animation as an object, as [first, last, next, speed] or as a single frame number
+			if (animations.Match('{'))
+			{
+				while (!animations.Match('}'))
+				{
+					std::string_view field;
+					if (!animations.ReadString(field) || !animations.Match(':'))
+					{
+						return false;
+					}
+
+					if (field == "frames" && animations.Match('['))
+					{
+						while (!animations.Match(']'))
+						{
+							auto index = 0;
+							if (!animations.ReadInt(index))
+							{
+								return false;
+							}
+							frame_indices.push_back(index);
+							animations.Match(',');
+						}
+					}
+					else if (field == "speed")
+					{
+						animations.ReadNumber(speed);
+					}
+					else if (field == "next")
+					{
+						// "next": false stops on the last frame, anything else keeps playing
+						loop = animations.Peek() != 'f';
+						animations.SkipValue();
+					}
+					else if (!animations.SkipValue())
+					{
+						return false;
+					}
+					animations.Match(',');
+				}
+			}
+			else if (animations.Match('['))
+			{
+				auto first = 0;
+				if (!animations.ReadInt(first))
+				{
+					return false;
+				}
+				auto last = first;
+				if (animations.Match(',') && !animations.ReadInt(last))
+				{
+					return false;
+				}
+				if (animations.Match(','))
+				{
+					// the next animation, false to stop on the last frame
+					loop = animations.Peek() != 'f';
+					if (!animations.SkipValue() || (animations.Match(',') && !animations.ReadNumber(speed)))
+					{
+						return false;
+					}
+				}
+				if (!animations.Match(']') || last < first)
+				{
+					return false;
+				}
+
+				for (auto index = first; index <= last; ++index)
+				{
+					frame_indices.push_back(index);
+				}
+			}
+			else
+			{
+				auto index = 0;
+				if (!animations.ReadInt(index))
+				{
+					return false;
+				}
+				frame_indices.push_back(index);
+			}
+
+			const auto frame_duration = (frame_rate > 0.0f && speed > 0.0f) ? 1.0f / (frame_rate * speed) : 0.0f;
+			AnimationClip clip;
+			clip.name.assign(animation_name);
+			clip.loop = loop;
+
+			for (auto i = 0; i < static_cast<int>(frame_indices.size()); ++i)
+			{
+				const auto index = frame_indices[i];
+				if (index < 0 || index >= static_cast<int>(frames.size()))
+				{
+					return false;
+				}
+
+				auto& entry = frames[index];
+				if (entry.name.empty() && entry.animation.empty())
+				{
+					entry.animation = animation_name;
+					entry.animation_index = i;
+					entry.single = frame_indices.size() == 1;
+				}
+				clip.AddFrame(entry.rect, frame_duration);
+			}
+
+			clips.push_back(std::move(clip));
+			animations.Match(',');
+		}
+	}
+
+	std::string name; // reused so it keeps its capacity between frames
+	for (auto i = 0; i < static_cast<int>(frames.size()); ++i)
+	{
+		const auto& entry = frames[i];
+
+		// single frame animations name their frame, longer ones number them ("megaman-idle-0")
+		if (!entry.name.empty())
+		{
+			name.assign(entry.name);
+		}
+		else if (!entry.animation.empty())
+		{
+			name.assign(entry.animation);
+			if (!entry.single)
+			{
+				name.push_back('-');
+				AppendInt(name, entry.animation_index);
+			}
+		}
+		else
+		{
+			name.clear();
+			AppendInt(name, i);
+		}
+
+		sprite_sheet.AddFrame(name, { entry.rect.x, entry.rect.y, entry.rect.w, entry.rect.h });
+	}
+
+	for (auto& clip : clips)
+	{
+		sprite_sheet.AddClip(std::move(clip));
+	}
+
+	return true;
+}
+
+void SpriteSheetLoader::Benchmark(const int frame_count)
+{
+	std::error_code error;
+	const auto directory = std::filesystem::temp_directory_path(error);
+	if (error)
+	{
+		std::cout << "error finding a temporary directory" << std::endl;
+		return;
+	}
+
+	const auto text_file_name = (directory / "benchmark_atlas.txt").string();
+	const auto xml_file_name = (directory / "benchmark_atlas.xml").string();
+	const auto json_file_name = (directory / "benchmark_atlas.json").string();
+
+	// synthetic 64x64 frames on a 256 frame wide grid, grouped into 8 frame animations
+	constexpr auto columns = 256;
+	constexpr auto animation_length = 8;
+	{
+		std::ofstream text_file(text_file_name);
+		std::ofstream xml_file(xml_file_name);
+		std::ofstream json_file(json_file_name);
+
+		xml_file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<TextureAtlas imagePath=\"benchmark.png\">\n";
+		json_file << "{\n\"images\": [\"benchmark.png\"],\n\"framerate\": 20,\n\"frames\": [\n";
+
+		for (auto i = 0; i < frame_count; ++i)
+		{
+			const auto x = (i % columns) * 64;
+			const auto y = (i / columns) * 64;
+			text_file << "frame" << i << ' ' << x << ' ' << y << " 64 64\n";
+			xml_file << "    <sprite n=\"frame" << i << ".png\" x=\"" << x << "\" y=\"" << y << "\" w=\"64\" h=\"64\"/>\n";
+			json_file << "    [" << x << ", " << y << ", 64, 64, 0, 0, 0]" << (i + 1 < frame_count ? ",\n" : "\n");
+		}
+
+		xml_file << "</TextureAtlas>\n";
+		json_file << "],\n\"animations\": {\n";
+		for (auto start = 0; start < frame_count; start += animation_length)
+		{
+			json_file << "    \"animation" << start / animation_length << "\": { \"frames\": [";
+			for (auto i = start; i < std::min(start + animation_length, frame_count); ++i)
+			{
+				json_file << (i > start ? ", " : "") << i;
+			}
+			json_file << "] }" << (start + animation_length < frame_count ? ",\n" : "\n");
+		}
+		json_file << "}\n}\n";
+	}
+
+	std::cout << "------------ Sprite Sheet Loader Benchmark -----------" << std::endl;
+	const std::pair<const char*, std::string> files[] = {
+		{ "txt ", text_file_name }, { "xml ", xml_file_name }, { "json", json_file_name } };
+
+	for (const auto& [format, file_name] : files)
+	{
+		SpriteSheet sprite_sheet("benchmark");
+		const auto start = SDL_GetPerformanceCounter();
+		const auto loaded = Load(file_name, sprite_sheet);
+		const auto elapsed = ElapsedMilliseconds(start);
+
+		std::cout << format << ": " << (loaded ? "" : "FAILED ") << frame_count << " frames in " << elapsed << " ms" << std::endl;
+		std::filesystem::remove(file_name, error);
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+#ifndef __SPRITE_SHEET_LOADER__
+#define __SPRITE_SHEET_LOADER__
+
+#include <string>
+#include <string_view>
+
+class SpriteSheet;
+
+/**
+ * \brief Reads sprite sheet data files straight out of a memory mapped buffer.
+ * Supported formats (detected from the first non-blank character):
+ *  - TexturePacker plain text: one "name x y w h" line per frame
+ *  - TexturePacker XML: <sprite n="name" x="" y="" w="" h=""/>
+ *  - TexturePacker JSON array / EaselJS JSON: "frames" as [x, y, w, h, ...] arrays or
+ *    { "filename": "", "frame": { "x", "y", "w", "h" } } objects, plus optional "animations"
+ *    (a frame number, [first, last, next, speed] or { "frames", "next", "speed" }) which become
+ *    AnimationClips on the sheet.
+ * Rotated frames (r="y", "rotated": true) are rejected, the sheet must be exported without rotation.
+ * Tokens are parsed in place; the only allocations are the frames, interned names and clips stored on the sheet.
+ */
+class SpriteSheetLoader
+{
+public:
+	static bool Load(const std::string& data_file_name, SpriteSheet& sprite_sheet);
+	static bool Parse(std::string_view data, SpriteSheet& sprite_sheet);
+
+	// writes a synthetic atlas with frame_count frames in every format and times loading each one
+	static void Benchmark(int frame_count = 50000);
+
+private:
+	static bool ParseText(std::string_view data, SpriteSheet& sprite_sheet);
+	static bool ParseXML(std::string_view data, SpriteSheet& sprite_sheet);
+	static bool ParseJSON(std::string_view data, SpriteSheet& sprite_sheet);
+};
+
+#endif /* defined (__SPRITE_SHEET_LOADER__) */
@@ -48,11 +48,11 @@ void StartScene::Start()
 	const SDL_Color blue = { 0, 0, 255, 255 };
 	m_pStartLabel = new Label("START SCENE", "Consolas", 80, blue, glm::vec2(400.0f, 40.0f));
 	m_pStartLabel->SetParent(this);
-	AddChild(m_pStartLabel);
+	AddChild(m_pStartLabel, Config::UI_LAYER);
 
 	m_pInstructionsLabel = new Label("Press 1 to Play", "Consolas", 40, blue, glm::vec2(400.0f, 120.0f));
 	m_pInstructionsLabel->SetParent(this);
-	AddChild(m_pInstructionsLabel);
+	AddChild(m_pInstructionsLabel, Config::UI_LAYER);
 
 
 	m_pShip = new Ship();
@@ -78,7 +78,10 @@ void StartScene::Start()
 	{
 		m_pStartButton->SetAlpha(255);
 	});
-	AddChild(m_pStartButton);
+	AddChild(m_pStartButton, Config::UI_LAYER);
+
+	// menus only change on hover, composite them once and reuse the result
+	SetLayerStatic(Config::UI_LAYER);
 
 	ImGuiWindowFrame::Instance().SetDefaultGuiFunction();
 }
@@ -0,0 +1,17 @@
+#pragma once
+#ifndef __STEERING_BEHAVIOUR__
+#define __STEERING_BEHAVIOUR__
+
+// bit flags, an agent can combine any of them
+enum SteeringBehaviour
+{
+	SEEK = 1 << 0,
+	FLEE = 1 << 1,
+	ARRIVE = 1 << 2,
+	WANDER = 1 << 3,
+	SEPARATION = 1 << 4,
+	OBSTACLE_AVOIDANCE = 1 << 5,
+	NUM_OF_STEERING_BEHAVIOURS = 6
+};
+
+#endif /* defined (__STEERING_BEHAVIOUR__) */
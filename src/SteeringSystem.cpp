@@ -0,0 +1,735 @@
+#include "SteeringSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <SDL.h>
+#include "Agent.h"
+#include "DebugDraw.h"
+#include "OverlapKernels.h"
+#include "Util.h"
+
+#if defined(__AVX2__)
+#define STEERING_SYSTEM_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STEERING_SYSTEM_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	// keeps the grid (and its counting sort) small when a few agents stray far from the rest
+	constexpr int MAX_GRID_SIZE = 1024;
+	constexpr float EPSILON = 1e-6f;
+
+	double ElapsedMilliseconds(const Uint64 start)
+	{
+		return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+	}
+
+	// a number in [-1, 1] from an agent index and a frame, the same on every platform
+	float Noise(std::uint32_t value)
+	{
+		value ^= value >> 16;
+		value *= 0x7feb352du;
+		value ^= value >> 15;
+		value *= 0x846ca68bu;
+		value ^= value >> 16;
+		return static_cast<float>(value & 0xFFFFu) / 32767.5f - 1.0f;
+	}
+
+#if defined(STEERING_SYSTEM_AVX2)
+	typedef __m256 Lane;
+	constexpr int LANE_WIDTH = 8;
+	Lane Load(const float* values) { return _mm256_loadu_ps(values); }
+	Lane Splat(const float value) { return _mm256_set1_ps(value); }
+	Lane Add(const Lane a, const Lane b) { return _mm256_add_ps(a, b); }
+	Lane Sub(const Lane a, const Lane b) { return _mm256_sub_ps(a, b); }
+	Lane Mul(const Lane a, const Lane b) { return _mm256_mul_ps(a, b); }
+	Lane Div(const Lane a, const Lane b) { return _mm256_div_ps(a, b); }
+	Lane Max(const Lane a, const Lane b) { return _mm256_max_ps(a, b); }
+	float Sum(const Lane lane)
+	{
+		alignas(32) float values[8];
+		_mm256_store_ps(values, lane);
+		return ((values[0] + values[1]) + (values[2] + values[3])) + ((values[4] + values[5]) + (values[6] + values[7]));
+	}
+#elif defined(STEERING_SYSTEM_SSE2)
+	typedef __m128 Lane;
+	constexpr int LANE_WIDTH = 4;
+	Lane Load(const float* values) { return _mm_loadu_ps(values); }
+	Lane Splat(const float value) { return _mm_set1_ps(value); }
+	Lane Add(const Lane a, const Lane b) { return _mm_add_ps(a, b); }
+	Lane Sub(const Lane a, const Lane b) { return _mm_sub_ps(a, b); }
+	Lane Mul(const Lane a, const Lane b) { return _mm_mul_ps(a, b); }
+	Lane Div(const Lane a, const Lane b) { return _mm_div_ps(a, b); }
+	Lane Max(const Lane a, const Lane b) { return _mm_max_ps(a, b); }
+	float Sum(const Lane lane)
+	{
+		alignas(16) float values[4];
+		_mm_store_ps(values, lane);
+		return (values[0] + values[1]) + (values[2] + values[3]);
+	}
+#endif
+
+	/**
+	 * \brief Push away from every neighbour closer than the radius, (r^2 - d^2) / (r^2 d^2) per unit of offset:
+	 * strong up close, nothing at the radius, and no square root. The agent itself is at offset 0 and adds nothing.
+	 * Scalar - the tail of the SIMD loop and the whole loop on other architectures.
+	 */
+	void ScalarSeparation(const float x, const float y, const float squared_radius, const float* xs, const float* ys,
+		const int begin, const int end, float& push_x, float& push_y)
+	{
+		const auto inverse_squared_radius = 1.0f / squared_radius;
+		for (auto j = begin; j < end; ++j)
+		{
+			const auto dx = x - xs[j];
+			const auto dy = y - ys[j];
+			const auto squared_distance = dx * dx + dy * dy;
+			const auto weight = std::max(squared_radius - squared_distance, 0.0f) * inverse_squared_radius / std::max(squared_distance, EPSILON);
+			push_x += dx * weight;
+			push_y += dy * weight;
+		}
+	}
+
+	void Separation(const float x, const float y, const float squared_radius, const float* xs, const float* ys,
+		const int begin, const int end, float& push_x, float& push_y)
+	{
+		auto j = begin;
+#if defined(STEERING_SYSTEM_AVX2) || defined(STEERING_SYSTEM_SSE2)
+		if (end - begin >= LANE_WIDTH)
+		{
+			const auto centre_x = Splat(x);
+			const auto centre_y = Splat(y);
+			const auto radius = Splat(squared_radius);
+			const auto inverse_radius = Splat(1.0f / squared_radius);
+			const auto zero = Splat(0.0f);
+			const auto epsilon = Splat(EPSILON);
+			auto sum_x = zero;
+			auto sum_y = zero;
+			for (; j + LANE_WIDTH <= end; j += LANE_WIDTH)
+			{
+				const auto dx = Sub(centre_x, Load(xs + j));
+				const auto dy = Sub(centre_y, Load(ys + j));
+				const auto squared_distance = Add(Mul(dx, dx), Mul(dy, dy));
+				const auto weight = Div(Mul(Max(Sub(radius, squared_distance), zero), inverse_radius), Max(squared_distance, epsilon));
+				sum_x = Add(sum_x, Mul(dx, weight));
+				sum_y = Add(sum_y, Mul(dy, weight));
+			}
+			push_x += Sum(sum_x);
+			push_y += Sum(sum_y);
+		}
+#endif
+		ScalarSeparation(x, y, squared_radius, xs, ys, j, end, push_x, push_y);
+	}
+}
+
+SteeringSystem::SteeringSystem(const float separation_radius) :
+	m_gridMinX(0.0f), m_gridMinY(0.0f), m_cellSize(separation_radius), m_gridCols(0), m_gridRows(0),
+	m_separationRadius(separation_radius), m_arriveRadius(100.0f), m_wanderDistance(60.0f), m_wanderRadius(30.0f),
+	m_wanderJitter(6.0f), m_lookAhead(80.0f), m_frame(0)
+{
+}
+
+SteeringSystem::~SteeringSystem()
+= default;
+
+int SteeringSystem::AddAgent(const glm::vec2 position, const glm::vec2 velocity, const float max_speed, const float max_force, const std::uint32_t behaviours)
+{
+	m_positionX.push_back(position.x);
+	m_positionY.push_back(position.y);
+	m_velocityX.push_back(velocity.x);
+	m_velocityY.push_back(velocity.y);
+	m_targetX.push_back(position.x);
+	m_targetY.push_back(position.y);
+	m_forceX.push_back(0.0f);
+	m_forceY.push_back(0.0f);
+	m_maxSpeed.push_back(max_speed);
+	m_maxForce.push_back(max_force);
+	m_wanderAngle.push_back(std::atan2(velocity.y, velocity.x));
+	m_behaviours.push_back(behaviours);
+	m_agents.push_back(nullptr);
+	return GetAgentCount() - 1;
+}
+
+int SteeringSystem::AddAgent(Agent* agent, const float max_speed, const float max_force, const std::uint32_t behaviours)
+{
+	const auto index = AddAgent(agent->GetTransform()->position, agent->GetRigidBody()->velocity, max_speed, max_force, behaviours);
+	m_agents[index] = agent;
+	return index;
+}
+
+void SteeringSystem::RemoveAgent(const int index)
+{
+	if (index < 0 || index >= GetAgentCount())
+	{
+		return;
+	}
+
+	// a released object stops steering instead of keeping its last acceleration
+	if (m_agents[index] != nullptr)
+	{
+		m_agents[index]->GetRigidBody()->acceleration = glm::vec2(0.0f, 0.0f);
+	}
+
+	// swap and pop, every array the same way
+	const auto last = GetAgentCount() - 1;
+	auto remove = [index, last](auto& values)
+	{
+		values[index] = values[last];
+		values.pop_back();
+	};
+	remove(m_positionX);
+	remove(m_positionY);
+	remove(m_velocityX);
+	remove(m_velocityY);
+	remove(m_targetX);
+	remove(m_targetY);
+	remove(m_forceX);
+	remove(m_forceY);
+	remove(m_maxSpeed);
+	remove(m_maxForce);
+	remove(m_wanderAngle);
+	remove(m_behaviours);
+	remove(m_agents);
+}
+
+void SteeringSystem::RemoveAgent(const Agent* agent)
+{
+	const auto found = std::find(m_agents.begin(), m_agents.end(), agent);
+	if (found != m_agents.end())
+	{
+		RemoveAgent(static_cast<int>(found - m_agents.begin()));
+	}
+}
+
+void SteeringSystem::Clear()
+{
+	while (GetAgentCount() > 0)
+	{
+		RemoveAgent(GetAgentCount() - 1);
+	}
+}
+
+void SteeringSystem::AddObstacle(const glm::vec2 centre, const float radius)
+{
+	m_obstacleX.push_back(centre.x);
+	m_obstacleY.push_back(centre.y);
+	m_obstacleRadius.push_back(radius);
+}
+
+void SteeringSystem::ClearObstacles()
+{
+	m_obstacleX.clear();
+	m_obstacleY.clear();
+	m_obstacleRadius.clear();
+}
+
+/**
+ * \brief Each behaviour is a desired velocity minus the current one. They are all computed for every agent
+ * and multiplied by the agent's flag (0 or 1) and the shared weight, which keeps the loop free of branches.
+ */
+void SteeringSystem::ComputeForces(const float delta_time)
+{
+	const auto count = GetAgentCount();
+	++m_frame;
+
+	// bound agents are moved by the PhysicsWorld, read where it left them
+	for (auto i = 0; i < count; ++i)
+	{
+		if (m_agents[i] != nullptr)
+		{
+			const auto position = m_agents[i]->GetTransform()->position;
+			const auto velocity = m_agents[i]->GetRigidBody()->velocity;
+			m_positionX[i] = position.x;
+			m_positionY[i] = position.y;
+			m_velocityX[i] = velocity.x;
+			m_velocityY[i] = velocity.y;
+		}
+	}
+
+	const float* __restrict position_x = m_positionX.data();
+	const float* __restrict position_y = m_positionY.data();
+	const float* __restrict velocity_x = m_velocityX.data();
+	const float* __restrict velocity_y = m_velocityY.data();
+	const float* __restrict target_x = m_targetX.data();
+	const float* __restrict target_y = m_targetY.data();
+	const float* __restrict max_speed = m_maxSpeed.data();
+	const std::uint32_t* __restrict behaviours = m_behaviours.data();
+	float* __restrict force_x = m_forceX.data();
+	float* __restrict force_y = m_forceY.data();
+	float* __restrict wander_angle = m_wanderAngle.data();
+
+	const auto inverse_arrive_radius = 1.0f / std::max(m_arriveRadius, EPSILON);
+	const auto wander_distance = m_wanderDistance;
+	const auto wander_radius = m_wanderRadius;
+	const auto jitter = m_wanderJitter * delta_time;
+	const auto frame_seed = m_frame * 2891336453u;
+	const auto weights = m_weights;
+
+	for (auto i = 0; i < count; ++i)
+	{
+		const auto to_target_x = target_x[i] - position_x[i];
+		const auto to_target_y = target_y[i] - position_y[i];
+		const auto inverse_distance = 1.0f / std::sqrt(std::max(to_target_x * to_target_x + to_target_y * to_target_y, EPSILON));
+		const auto distance = (to_target_x * to_target_x + to_target_y * to_target_y) * inverse_distance;
+		const auto speed = max_speed[i];
+
+		const auto seek_x = to_target_x * inverse_distance * speed - velocity_x[i];
+		const auto seek_y = to_target_y * inverse_distance * speed - velocity_y[i];
+		const auto flee_x = -to_target_x * inverse_distance * speed - velocity_x[i];
+		const auto flee_y = -to_target_y * inverse_distance * speed - velocity_y[i];
+
+		// full speed outside the arrive radius, slowing linearly to a stop on the target
+		const auto arrive_speed = speed * std::min(distance * inverse_arrive_radius, 1.0f);
+		const auto arrive_x = to_target_x * inverse_distance * arrive_speed - velocity_x[i];
+		const auto arrive_y = to_target_y * inverse_distance * arrive_speed - velocity_y[i];
+
+		// a point that drifts around a circle held in front of the agent
+		wander_angle[i] += Noise(static_cast<std::uint32_t>(i) * 747796405u + frame_seed) * jitter;
+		const auto inverse_speed = 1.0f / std::sqrt(std::max(velocity_x[i] * velocity_x[i] + velocity_y[i] * velocity_y[i], EPSILON));
+		const auto wander_point_x = velocity_x[i] * inverse_speed * wander_distance + std::cos(wander_angle[i]) * wander_radius;
+		const auto wander_point_y = velocity_y[i] * inverse_speed * wander_distance + std::sin(wander_angle[i]) * wander_radius;
+		const auto inverse_wander = 1.0f / std::sqrt(std::max(wander_point_x * wander_point_x + wander_point_y * wander_point_y, EPSILON));
+		const auto wander_x = wander_point_x * inverse_wander * speed - velocity_x[i];
+		const auto wander_y = wander_point_y * inverse_wander * speed - velocity_y[i];
+
+		const auto flags = behaviours[i];
+		const auto seek = static_cast<float>(flags & SEEK) * weights.seek;
+		const auto flee = static_cast<float>((flags & FLEE) >> 1) * weights.flee;
+		const auto arrive = static_cast<float>((flags & ARRIVE) >> 2) * weights.arrive;
+		const auto wander = static_cast<float>((flags & WANDER) >> 3) * weights.wander;
+
+		force_x[i] = seek * seek_x + flee * flee_x + arrive * arrive_x + wander * wander_x;
+		force_y[i] = seek * seek_y + flee * flee_y + arrive * arrive_y + wander * wander_y;
+	}
+
+	const auto separate = m_weights.separation != 0.0f && count > 1;
+	const auto avoid = m_weights.avoidance != 0.0f && count > 0 && !m_obstacleX.empty();
+	if (separate || avoid)
+	{
+		BuildGrid();
+	}
+	if (separate)
+	{
+		ComputeSeparation();
+	}
+	if (avoid)
+	{
+		ComputeAvoidance();
+	}
+
+	// no agent turns harder than its force limit
+	const float* __restrict max_force = m_maxForce.data();
+	for (auto i = 0; i < count; ++i)
+	{
+		const auto squared_force = force_x[i] * force_x[i] + force_y[i] * force_y[i];
+		const auto scale = std::min(max_force[i] / std::sqrt(std::max(squared_force, EPSILON)), 1.0f);
+		force_x[i] *= scale;
+		force_y[i] *= scale;
+	}
+
+	for (auto i = 0; i < count; ++i)
+	{
+		if (m_agents[i] != nullptr)
+		{
+			// an acceleration rather than a force - the PhysicsWorld clears forces after one fixed step, while the
+			// acceleration holds for every step until the next frame replaces it, whatever the frame rate
+			m_agents[i]->GetRigidBody()->acceleration = glm::vec2(force_x[i], force_y[i]);
+
+			// face where it is going
+			if (velocity_x[i] * velocity_x[i] + velocity_y[i] * velocity_y[i] > 1.0f)
+			{
+				m_agents[i]->SetCurrentHeading(std::atan2(velocity_y[i], velocity_x[i]) * Util::Rad2Deg);
+			}
+		}
+	}
+}
+
+void SteeringSystem::Integrate(const float delta_time)
+{
+	const auto count = GetAgentCount();
+	float* __restrict position_x = m_positionX.data();
+	float* __restrict position_y = m_positionY.data();
+	float* __restrict velocity_x = m_velocityX.data();
+	float* __restrict velocity_y = m_velocityY.data();
+	const float* __restrict force_x = m_forceX.data();
+	const float* __restrict force_y = m_forceY.data();
+	const float* __restrict max_speed = m_maxSpeed.data();
+
+	for (auto i = 0; i < count; ++i)
+	{
+		if (m_agents[i] != nullptr)
+		{
+			continue;
+		}
+
+		auto vx = velocity_x[i] + force_x[i] * delta_time;
+		auto vy = velocity_y[i] + force_y[i] * delta_time;
+		const auto scale = std::min(max_speed[i] / std::sqrt(std::max(vx * vx + vy * vy, EPSILON)), 1.0f);
+		vx *= scale;
+		vy *= scale;
+		velocity_x[i] = vx;
+		velocity_y[i] = vy;
+		position_x[i] += vx * delta_time;
+		position_y[i] += vy * delta_time;
+	}
+}
+
+void SteeringSystem::Update(const float delta_time)
+{
+	ComputeForces(delta_time);
+	Integrate(delta_time);
+}
+
+void SteeringSystem::DrawDebug(const glm::vec4 colour) const
+{
+	for (auto i = 0; i < GetAgentCount(); ++i)
+	{
+		const glm::vec2 position(m_positionX[i], m_positionY[i]);
+		DebugDraw::Instance().AddLine(position, position + glm::vec2(m_velocityX[i], m_velocityY[i]) * 0.1f, colour);
+	}
+	for (size_t i = 0; i < m_obstacleX.size(); ++i)
+	{
+		DebugDraw::Instance().AddCircle(glm::vec2(m_obstacleX[i], m_obstacleY[i]), m_obstacleRadius[i], glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+	}
+}
+
+int SteeringSystem::GetAgentCount() const
+{
+	return static_cast<int>(m_positionX.size());
+}
+
+glm::vec2 SteeringSystem::GetPosition(const int index) const
+{
+	return { m_positionX[index], m_positionY[index] };
+}
+
+glm::vec2 SteeringSystem::GetVelocity(const int index) const
+{
+	return { m_velocityX[index], m_velocityY[index] };
+}
+
+glm::vec2 SteeringSystem::GetForce(const int index) const
+{
+	return { m_forceX[index], m_forceY[index] };
+}
+
+std::uint32_t SteeringSystem::GetBehaviours(const int index) const
+{
+	return m_behaviours[index];
+}
+
+const SteeringSystem::Weights& SteeringSystem::GetWeights() const
+{
+	return m_weights;
+}
+
+float SteeringSystem::GetSeparationRadius() const
+{
+	return m_separationRadius;
+}
+
+void SteeringSystem::SetTarget(const int index, const glm::vec2 target)
+{
+	m_targetX[index] = target.x;
+	m_targetY[index] = target.y;
+}
+
+void SteeringSystem::SetTarget(const glm::vec2 target)
+{
+	std::fill(m_targetX.begin(), m_targetX.end(), target.x);
+	std::fill(m_targetY.begin(), m_targetY.end(), target.y);
+}
+
+void SteeringSystem::SetBehaviours(const int index, const std::uint32_t behaviours)
+{
+	m_behaviours[index] = behaviours;
+}
+
+void SteeringSystem::SetWeights(const Weights& weights)
+{
+	m_weights = weights;
+}
+
+void SteeringSystem::SetSeparationRadius(const float radius)
+{
+	m_separationRadius = std::max(radius, 1.0f);
+}
+
+void SteeringSystem::SetArriveRadius(const float radius)
+{
+	m_arriveRadius = radius;
+}
+
+void SteeringSystem::SetWander(const float distance, const float radius, const float jitter)
+{
+	m_wanderDistance = distance;
+	m_wanderRadius = radius;
+	m_wanderJitter = jitter;
+}
+
+void SteeringSystem::SetLookAhead(const float distance)
+{
+	m_lookAhead = distance;
+}
+
+/**
+ * \brief Counting sort of the agents by cell - one pass to count, a prefix sum, and one pass (backwards, so each
+ * cell keeps index order) to place them. m_cellStart[c] is then the first sorted slot of cell c.
+ */
+void SteeringSystem::BuildGrid()
+{
+	const auto count = GetAgentCount();
+	const auto [min_x, max_x] = std::minmax_element(m_positionX.begin(), m_positionX.end());
+	const auto [min_y, max_y] = std::minmax_element(m_positionY.begin(), m_positionY.end());
+	const auto extent = std::max(*max_x - *min_x, *max_y - *min_y);
+
+	m_cellSize = std::max(m_separationRadius, extent / static_cast<float>(MAX_GRID_SIZE - 1));
+	m_gridMinX = *min_x;
+	m_gridMinY = *min_y;
+	m_gridCols = static_cast<int>((*max_x - *min_x) / m_cellSize) + 1;
+	m_gridRows = static_cast<int>((*max_y - *min_y) / m_cellSize) + 1;
+
+	const auto cell_count = m_gridCols * m_gridRows;
+	m_cellStart.assign(static_cast<size_t>(cell_count) + 1, 0);
+	m_agentCell.resize(count);
+	m_sortedAgents.resize(count);
+	m_sortedX.resize(count);
+	m_sortedY.resize(count);
+
+	const auto inverse_cell_size = 1.0f / m_cellSize;
+	for (auto i = 0; i < count; ++i)
+	{
+		const auto col = std::min(static_cast<int>((m_positionX[i] - m_gridMinX) * inverse_cell_size), m_gridCols - 1);
+		const auto row = std::min(static_cast<int>((m_positionY[i] - m_gridMinY) * inverse_cell_size), m_gridRows - 1);
+		m_agentCell[i] = row * m_gridCols + col;
+		++m_cellStart[m_agentCell[i]];
+	}
+
+	// cell c ends where c + 1 starts
+	auto end = 0;
+	for (auto cell = 0; cell <= cell_count; ++cell)
+	{
+		end += m_cellStart[cell];
+		m_cellStart[cell] = end;
+	}
+
+	for (auto i = count - 1; i >= 0; --i)
+	{
+		const auto slot = --m_cellStart[m_agentCell[i]];
+		m_sortedAgents[slot] = i;
+		m_sortedX[slot] = m_positionX[i];
+		m_sortedY[slot] = m_positionY[i];
+	}
+}
+
+/**
+ * \brief Agents are visited in cell order so neighbouring agents read the same runs of the sorted arrays.
+ * Cells are at least the separation radius wide, so the 3x3 block around an agent's cell holds every
+ * neighbour, and the three cells of each row of the block are one contiguous run.
+ */
+void SteeringSystem::ComputeSeparation()
+{
+	const auto count = GetAgentCount();
+	const auto squared_radius = m_separationRadius * m_separationRadius;
+	const auto strength = m_separationRadius * m_weights.separation;
+	const auto xs = m_sortedX.data();
+	const auto ys = m_sortedY.data();
+
+	for (auto slot = 0; slot < count; ++slot)
+	{
+		const auto i = m_sortedAgents[slot];
+		if ((m_behaviours[i] & SEPARATION) == 0)
+		{
+			continue;
+		}
+
+		const auto cell = m_agentCell[i];
+		const auto col = cell % m_gridCols;
+		const auto row = cell / m_gridCols;
+		const auto first_col = std::max(col - 1, 0);
+		const auto last_col = std::min(col + 1, m_gridCols - 1);
+
+		auto push_x = 0.0f;
+		auto push_y = 0.0f;
+		for (auto r = std::max(row - 1, 0); r <= std::min(row + 1, m_gridRows - 1); ++r)
+		{
+			Separation(xs[slot], ys[slot], squared_radius, xs, ys,
+				m_cellStart[r * m_gridCols + first_col], m_cellStart[r * m_gridCols + last_col + 1], push_x, push_y);
+		}
+
+		// the push is a desired velocity away from the crowd, scaled so one neighbour at half the radius asks for 1.5x top speed
+		m_forceX[i] += push_x * strength * m_maxSpeed[i];
+		m_forceY[i] += push_y * strength * m_maxSpeed[i];
+	}
+}
+
+/**
+ * \brief The agent's path for the look ahead distance (shorter when it is slow) is a segment; an obstacle whose
+ * circle, grown by half the separation radius, touches it pushes the agent sideways from its closest point,
+ * twice as hard next to the agent as at the end of the look ahead.
+ * Obstacles are the outer loop and only visit the grid cells within look ahead of their circle.
+ */
+void SteeringSystem::ComputeAvoidance()
+{
+	const auto count = GetAgentCount();
+	m_headingX.resize(count);
+	m_headingY.resize(count);
+	m_lookAheadDistance.resize(count);
+	m_avoidStrength.resize(count);
+
+	const float* __restrict position_x = m_positionX.data();
+	const float* __restrict position_y = m_positionY.data();
+	const float* __restrict velocity_x = m_velocityX.data();
+	const float* __restrict velocity_y = m_velocityY.data();
+	const float* __restrict max_speed = m_maxSpeed.data();
+	const std::uint32_t* __restrict behaviours = m_behaviours.data();
+	float* __restrict heading_x = m_headingX.data();
+	float* __restrict heading_y = m_headingY.data();
+	float* __restrict look_ahead = m_lookAheadDistance.data();
+	float* __restrict avoid = m_avoidStrength.data();
+	float* __restrict force_x = m_forceX.data();
+	float* __restrict force_y = m_forceY.data();
+
+	const auto full_look_ahead = m_lookAhead;
+	const auto weight = m_weights.avoidance;
+	for (auto i = 0; i < count; ++i)
+	{
+		const auto squared_speed = velocity_x[i] * velocity_x[i] + velocity_y[i] * velocity_y[i];
+		const auto inverse_speed = 1.0f / std::sqrt(std::max(squared_speed, EPSILON));
+		heading_x[i] = velocity_x[i] * inverse_speed;
+		heading_y[i] = velocity_y[i] * inverse_speed;
+		look_ahead[i] = std::max(full_look_ahead * std::min(squared_speed * inverse_speed / max_speed[i], 1.0f), EPSILON);
+		avoid[i] = static_cast<float>((behaviours[i] & OBSTACLE_AVOIDANCE) >> 5) * weight * max_speed[i];
+	}
+
+	const auto agent_radius = m_separationRadius * 0.5f;
+	const auto inverse_cell_size = 1.0f / m_cellSize;
+	const auto sorted_agents = m_sortedAgents.data();
+	for (size_t k = 0; k < m_obstacleX.size(); ++k)
+	{
+		const auto obstacle_x = m_obstacleX[k];
+		const auto obstacle_y = m_obstacleY[k];
+		const auto reach = m_obstacleRadius[k] + agent_radius;
+		const auto squared_reach = reach * reach;
+
+		// no agent further than reach plus the full look ahead can touch the obstacle this frame
+		const auto range = reach + full_look_ahead;
+		const auto first_col = std::max(static_cast<int>(std::floor((obstacle_x - range - m_gridMinX) * inverse_cell_size)), 0);
+		const auto last_col = std::min(static_cast<int>(std::floor((obstacle_x + range - m_gridMinX) * inverse_cell_size)), m_gridCols - 1);
+		const auto first_row = std::max(static_cast<int>(std::floor((obstacle_y - range - m_gridMinY) * inverse_cell_size)), 0);
+		const auto last_row = std::min(static_cast<int>(std::floor((obstacle_y + range - m_gridMinY) * inverse_cell_size)), m_gridRows - 1);
+		if (first_col > last_col || first_row > last_row)
+		{
+			continue;
+		}
+
+		for (auto row = first_row; row <= last_row; ++row)
+		{
+			const auto end = m_cellStart[row * m_gridCols + last_col + 1];
+			for (auto slot = m_cellStart[row * m_gridCols + first_col]; slot < end; ++slot)
+			{
+				const auto i = sorted_agents[slot];
+				const auto to_obstacle_x = obstacle_x - position_x[i];
+				const auto to_obstacle_y = obstacle_y - position_y[i];
+				const auto along = std::min(std::max(to_obstacle_x * heading_x[i] + to_obstacle_y * heading_y[i], 0.0f), look_ahead[i]);
+
+				// from the obstacle centre to the closest point of the path
+				const auto away_x = heading_x[i] * along - to_obstacle_x;
+				const auto away_y = heading_y[i] * along - to_obstacle_y;
+				const auto squared_distance = away_x * away_x + away_y * away_y;
+				const auto hit = static_cast<float>(squared_distance < squared_reach);
+				const auto push = hit * avoid[i] * (2.0f - along / look_ahead[i]) / std::sqrt(std::max(squared_distance, EPSILON));
+				force_x[i] += away_x * push;
+				force_y[i] += away_y * push;
+			}
+		}
+	}
+}
+
+void SteeringSystem::Benchmark(const int agent_count)
+{
+	std::mt19937 generator(42);
+	std::cout << "------------ Steering Benchmark (" << OverlapKernels::GetInstructionSet() << ") ----------" << std::endl;
+
+	// the same density at every size - about one agent per 20x20 pixels
+	auto fill = [&generator](SteeringSystem& system, const int count, const bool mixed)
+	{
+		const auto world = std::sqrt(static_cast<float>(count)) * 20.0f;
+		std::uniform_real_distribution<float> coordinate(0.0f, world);
+		std::uniform_real_distribution<float> velocity(-100.0f, 100.0f);
+		for (auto i = 0; i < count; ++i)
+		{
+			std::uint32_t behaviours = SEPARATION;
+			if (mixed)
+			{
+				behaviours |= i % 4 == 0 ? WANDER : i % 4 == 1 ? ARRIVE | OBSTACLE_AVOIDANCE : SEEK | OBSTACLE_AVOIDANCE;
+			}
+			system.AddAgent(glm::vec2(coordinate(generator), coordinate(generator)), glm::vec2(velocity(generator), velocity(generator)),
+				150.0f, 400.0f, behaviours);
+		}
+		if (mixed)
+		{
+			for (auto k = 0; k < 16; ++k)
+			{
+				system.AddObstacle(glm::vec2(coordinate(generator), coordinate(generator)), 30.0f);
+			}
+			system.SetTarget(glm::vec2(world * 0.5f, world * 0.5f));
+		}
+		return world;
+	};
+
+	constexpr auto frame_count = 60;
+	constexpr auto delta_time = 1.0f / 60.0f;
+	for (const auto count : { 1000, agent_count, 10000, 20000 })
+	{
+		SteeringSystem system;
+		fill(system, count, true);
+
+		auto total = 0.0;
+		auto worst = 0.0;
+		for (auto frame = 0; frame < frame_count; ++frame)
+		{
+			const auto start = SDL_GetPerformanceCounter();
+			system.Update(delta_time);
+			const auto time = ElapsedMilliseconds(start);
+			total += time;
+			worst = std::max(worst, time);
+		}
+		std::cout << count << " agents: " << total / frame_count << " ms per frame (worst " << worst << " ms)" << std::endl;
+	}
+
+	// separation alone against every pair, on the same agents
+	SteeringSystem system;
+	fill(system, agent_count, false);
+	Weights weights;
+	weights.separation = 1.0f;
+	system.SetWeights(weights);
+	for (auto i = 0; i < agent_count; ++i)
+	{
+		system.m_maxForce[i] = 1e9f;
+	}
+
+	auto start = SDL_GetPerformanceCounter();
+	system.ComputeForces(delta_time);
+	const auto grid_time = ElapsedMilliseconds(start);
+
+	start = SDL_GetPerformanceCounter();
+	const auto squared_radius = system.m_separationRadius * system.m_separationRadius;
+	auto worst_error = 0.0f;
+	for (auto i = 0; i < agent_count; ++i)
+	{
+		auto push_x = 0.0f;
+		auto push_y = 0.0f;
+		ScalarSeparation(system.m_positionX[i], system.m_positionY[i], squared_radius, system.m_positionX.data(), system.m_positionY.data(),
+			0, agent_count, push_x, push_y);
+		const auto scale = system.m_separationRadius * system.m_maxSpeed[i];
+		worst_error = std::max(worst_error, std::abs(push_x * scale - system.m_forceX[i]) + std::abs(push_y * scale - system.m_forceY[i]));
+	}
+	const auto brute_force_time = ElapsedMilliseconds(start);
+
+	std::cout << "separation, " << agent_count << " agents: grid " << grid_time << " ms, every pair " << brute_force_time
+		<< " ms, largest difference " << worst_error << std::endl;
+}
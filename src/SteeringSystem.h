@@ -0,0 +1,143 @@
+#pragma once
+#ifndef __STEERING_SYSTEM__
+#define __STEERING_SYSTEM__
+
+// Core Libraries
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "SteeringBehaviour.h"
+
+class Agent;
+
+/**
+ * \brief Steering forces for a whole crowd in a few passes over structure of arrays.
+ * Each agent has its own behaviour flags, target, top speed and force limit; the weights of the
+ * behaviours are shared. Every pass is a straight loop over contiguous floats with the flags turned
+ * into 0/1 factors, so the compiler can vectorize them; separation reads its neighbours from a uniform
+ * grid rebuilt by a counting sort each frame, where a row of three cells is one contiguous run that the
+ * inner loop walks with SSE2 / AVX2 lanes (the same build switch as the OverlapKernels). Obstacle avoidance
+ * uses the same grid to visit only the agents near each obstacle.
+ * An agent bound to an Agent object reads its position and velocity from it and sets its RigidBody's
+ * acceleration (replacing it) for the PhysicsWorld to integrate; unbound agents are moved by Integrate.
+ * Bound objects must be removed before they are deleted.
+ */
+class SteeringSystem
+{
+public:
+	struct Weights
+	{
+		float seek = 1.0f;
+		float flee = 1.0f;
+		float arrive = 1.0f;
+		float wander = 0.5f;
+		float separation = 1.5f;
+		float avoidance = 2.0f;
+	};
+
+	explicit SteeringSystem(float separation_radius = 24.0f);
+	~SteeringSystem();
+
+	// returns the agent's index - removing an agent moves the last one into its index
+	int AddAgent(glm::vec2 position, glm::vec2 velocity, float max_speed, float max_force, std::uint32_t behaviours);
+	int AddAgent(Agent* agent, float max_speed, float max_force, std::uint32_t behaviours);
+	void RemoveAgent(int index);
+	void RemoveAgent(const Agent* agent);
+	void Clear();
+
+	// circles the agents steer around
+	void AddObstacle(glm::vec2 centre, float radius);
+	void ClearObstacles();
+
+	// gathers bound agents, computes every agent's steering force and hands it to the bound objects
+	void ComputeForces(float delta_time);
+	// moves the unbound agents by their forces
+	void Integrate(float delta_time);
+	void Update(float delta_time);
+
+	// points and velocities through DebugDraw
+	void DrawDebug(glm::vec4 colour = glm::vec4(0.0f, 1.0f, 1.0f, 1.0f)) const;
+
+	// getters
+	[[nodiscard]] int GetAgentCount() const;
+	[[nodiscard]] glm::vec2 GetPosition(int index) const;
+	[[nodiscard]] glm::vec2 GetVelocity(int index) const;
+	[[nodiscard]] glm::vec2 GetForce(int index) const;
+	[[nodiscard]] std::uint32_t GetBehaviours(int index) const;
+	[[nodiscard]] const Weights& GetWeights() const;
+	[[nodiscard]] float GetSeparationRadius() const;
+
+	// setters
+	void SetTarget(int index, glm::vec2 target);
+	// every agent at once, the common case for a flock
+	void SetTarget(glm::vec2 target);
+	void SetBehaviours(int index, std::uint32_t behaviours);
+	void SetWeights(const Weights& weights);
+	// also the size of a grid cell, so neighbours are never further than the next cell
+	void SetSeparationRadius(float radius);
+	// distance at which ARRIVE starts slowing down
+	void SetArriveRadius(float radius);
+	void SetWander(float distance, float radius, float jitter);
+	// how far ahead (at top speed) obstacle avoidance looks
+	void SetLookAhead(float distance);
+
+	// full steering passes for crowds of 1k to 20k agents, and the grid against a brute force separation
+	static void Benchmark(int agent_count = 5000);
+
+private:
+	void BuildGrid();
+	void ComputeSeparation();
+	void ComputeAvoidance();
+
+	// agents (structure of arrays)
+	std::vector<float> m_positionX;
+	std::vector<float> m_positionY;
+	std::vector<float> m_velocityX;
+	std::vector<float> m_velocityY;
+	std::vector<float> m_targetX;
+	std::vector<float> m_targetY;
+	std::vector<float> m_forceX;
+	std::vector<float> m_forceY;
+	std::vector<float> m_maxSpeed;
+	std::vector<float> m_maxForce;
+	std::vector<float> m_wanderAngle;
+	std::vector<std::uint32_t> m_behaviours;
+	std::vector<Agent*> m_agents;
+
+	// obstacles (structure of arrays)
+	std::vector<float> m_obstacleX;
+	std::vector<float> m_obstacleY;
+	std::vector<float> m_obstacleRadius;
+
+	// avoidance scratch, per agent
+	std::vector<float> m_headingX;
+	std::vector<float> m_headingY;
+	std::vector<float> m_lookAheadDistance;
+	std::vector<float> m_avoidStrength;
+
+	// neighbour grid - agents sorted by cell, with their positions copied in that order
+	std::vector<int> m_cellStart;
+	std::vector<int> m_agentCell;
+	std::vector<int> m_sortedAgents;
+	std::vector<float> m_sortedX;
+	std::vector<float> m_sortedY;
+	float m_gridMinX;
+	float m_gridMinY;
+	float m_cellSize;
+	int m_gridCols;
+	int m_gridRows;
+
+	Weights m_weights;
+	float m_separationRadius;
+	float m_arriveRadius;
+	float m_wanderDistance;
+	float m_wanderRadius;
+	float m_wanderJitter;
+	float m_lookAhead;
+	std::uint32_t m_frame;
+};
+
+#endif /* defined (__STEERING_SYSTEM__) */
@@ -1,5 +1,6 @@
 #include "Target.h"
 #include "TextureManager.h"
+#include "PhysicsWorld.h"
 
 
 Target::Target()
@@ -14,10 +15,14 @@ Target::Target()
 	GetRigidBody()->isColliding = false;
 
 	SetType(GameObjectType::TARGET);
+
+	PhysicsWorld::Instance().AddBody(this);
 }
 
 Target::~Target()
-= default;
+{
+	PhysicsWorld::Instance().RemoveBody(this);
+}
 
 void Target::Draw()
 {
@@ -27,7 +32,6 @@ void Target::Draw()
 
 void Target::Update()
 {
-	Move();
 	CheckBounds();
 }
 
@@ -35,11 +39,6 @@ void Target::Clean()
 {
 }
 
-void Target::Move()
-{
-	GetTransform()->position = GetTransform()->position + GetRigidBody()->velocity * 5.0f;
-}
-
 void Target::CheckBounds()
 {
 }
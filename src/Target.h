@@ -15,7 +15,6 @@ public:
 	virtual void Clean() override;
 
 private:
-	void Move();
 	void CheckBounds();
 	void Reset();
 };
@@ -0,0 +1,250 @@
+#include "TextureCache.h"
+#include <SDL_image.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "Config.h"
+#include "MappedFile.h"
+#include "Renderer.h"
+#include "RenderThread.h"
+
+namespace
+{
+	constexpr Uint32 CACHE_MAGIC = 0x43584554; // "TEXC"
+	constexpr Uint32 CACHE_VERSION = 1;
+
+	// 64-bit FNV-1a
+	Uint64 Hash(const unsigned char* data, const size_t size)
+	{
+		Uint64 hash = 14695981039346656037ull;
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= data[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+}
+
+TextureCache::TextureCache() :
+	m_enabled(true), m_cacheDirectory("../Assets/cache/"), m_hitCount(0), m_missCount(0), m_loadTicks(0)
+{
+}
+
+TextureCache::~TextureCache()
+= default;
+
+std::shared_ptr<SDL_Texture> TextureCache::Load(const std::string& file_name)
+{
+	const auto start = SDL_GetPerformanceCounter();
+	const auto renderer = Renderer::Instance().GetRenderer();
+
+	MappedFile source;
+	if (!source.Open(file_name))
+	{
+		return nullptr;
+	}
+
+	std::shared_ptr<SDL_Texture> texture;
+	const auto format = GetNativeFormat(renderer);
+
+	// SDL_image cannot detect TGA from its contents, so the type always comes from the extension
+	auto type = std::filesystem::path(file_name).extension().string();
+	if (!type.empty())
+	{
+		type.erase(0, 1);
+	}
+
+	if (m_enabled)
+	{
+		// hashing the encoded file is a single pass over a few KB, far cheaper than decoding it
+		const auto source_hash = Hash(source.GetData(), source.GetSize());
+		const auto cache_file_name = GetCacheFileName(file_name);
+
+		texture = LoadCached(renderer, cache_file_name, source_hash, format);
+		if (texture != nullptr)
+		{
+			++m_hitCount;
+		}
+		else
+		{
+			texture = Decode(renderer, source.GetData(), source.GetSize(), type, cache_file_name, source_hash, format);
+			++m_missCount;
+		}
+	}
+	else
+	{
+		texture = Decode(renderer, source.GetData(), source.GetSize(), type, "", 0, format);
+		++m_missCount;
+	}
+
+	m_loadTicks += SDL_GetPerformanceCounter() - start;
+	return texture;
+}
+
+bool TextureCache::IsEnabled() const
+{
+	return m_enabled;
+}
+
+const std::string& TextureCache::GetCacheDirectory() const
+{
+	return m_cacheDirectory;
+}
+
+int TextureCache::GetHitCount() const
+{
+	return m_hitCount;
+}
+
+int TextureCache::GetMissCount() const
+{
+	return m_missCount;
+}
+
+/**
+ * \brief Total time spent in Load since the last ResetStats
+ * \return time in milliseconds
+ */
+double TextureCache::GetLoadTime() const
+{
+	return static_cast<double>(m_loadTicks) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+void TextureCache::SetEnabled(const bool enabled)
+{
+	m_enabled = enabled;
+}
+
+void TextureCache::SetCacheDirectory(const std::string& directory)
+{
+	m_cacheDirectory = directory;
+}
+
+void TextureCache::ResetStats()
+{
+	m_hitCount = 0;
+	m_missCount = 0;
+	m_loadTicks = 0;
+}
+
+void TextureCache::PrintStats() const
+{
+	std::cout << "Texture loads: " << m_hitCount + m_missCount << " (warm: " << m_hitCount << ", cold: " << m_missCount
+		<< ") in " << std::fixed << std::setprecision(2) << GetLoadTime() << " ms" << std::defaultfloat << std::endl;
+}
+
+/**
+ * \brief Picks the first pixel format the renderer supports natively that has an alpha channel,
+ * so uploads don't go through a conversion inside SDL
+ */
+Uint32 TextureCache::GetNativeFormat(SDL_Renderer* renderer) const
+{
+	SDL_RendererInfo info;
+	if (SDL_GetRendererInfo(renderer, &info) == 0)
+	{
+		for (Uint32 i = 0; i < info.num_texture_formats; ++i)
+		{
+			const auto format = info.texture_formats[i];
+			if (!SDL_ISPIXELFORMAT_FOURCC(format) && SDL_ISPIXELFORMAT_ALPHA(format))
+			{
+				return format;
+			}
+		}
+	}
+
+	return SDL_PIXELFORMAT_ARGB8888;
+}
+
+std::string TextureCache::GetCacheFileName(const std::string& file_name) const
+{
+	std::ostringstream cache_file_name;
+	cache_file_name << m_cacheDirectory << std::hex << std::setw(16) << std::setfill('0')
+		<< Hash(reinterpret_cast<const unsigned char*>(file_name.data()), file_name.size()) << ".texcache";
+	return cache_file_name.str();
+}
+
+std::shared_ptr<SDL_Texture> TextureCache::LoadCached(SDL_Renderer* renderer, const std::string& cache_file_name,
+	const Uint64 source_hash, const Uint32 format) const
+{
+	MappedFile cache_file;
+	if (!cache_file.Open(cache_file_name) || cache_file.GetSize() < sizeof(Header))
+	{
+		return nullptr;
+	}
+
+	Header header{};
+	std::memcpy(&header, cache_file.GetData(), sizeof(Header));
+
+	// stale, from another renderer, or truncated
+	if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.source_hash != source_hash ||
+		header.format != format || header.width <= 0 || header.height <= 0 || header.pitch <= 0 ||
+		cache_file.GetSize() < sizeof(Header) + static_cast<size_t>(header.pitch) * static_cast<size_t>(header.height))
+	{
+		return nullptr;
+	}
+
+	return CreateTexture(renderer, format, header.width, header.height, cache_file.GetData() + sizeof(Header), header.pitch);
+}
+
+std::shared_ptr<SDL_Texture> TextureCache::Decode(SDL_Renderer* renderer, const void* source, const size_t source_size,
+	const std::string& type, const std::string& cache_file_name, const Uint64 source_hash, const Uint32 format) const
+{
+	const auto decoded_surface(Config::MakeResource(IMG_LoadTyped_RW(SDL_RWFromConstMem(source, static_cast<int>(source_size)), 1, type.c_str())));
+	if (decoded_surface == nullptr)
+	{
+		return nullptr;
+	}
+
+	// colour keyed pixels become transparent when converting to a format with alpha
+	const auto surface(Config::MakeResource(SDL_ConvertSurfaceFormat(decoded_surface.get(), format, 0)));
+	if (surface == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto texture = CreateTexture(renderer, format, surface->w, surface->h, surface->pixels, surface->pitch);
+	if (texture == nullptr || cache_file_name.empty())
+	{
+		return texture;
+	}
+
+	std::error_code error;
+	std::filesystem::create_directories(m_cacheDirectory, error);
+
+	std::ofstream cache_file(cache_file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!cache_file)
+	{
+		std::cout << "error writing texture cache: " << cache_file_name << std::endl;
+		return texture;
+	}
+
+	const Header header{ CACHE_MAGIC, CACHE_VERSION, source_hash, format, surface->w, surface->h, surface->pitch };
+	cache_file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+	cache_file.write(static_cast<const char*>(surface->pixels), static_cast<std::streamsize>(surface->pitch) * surface->h);
+
+	return texture;
+}
+
+std::shared_ptr<SDL_Texture> TextureCache::CreateTexture(SDL_Renderer* renderer, const Uint32 format, const int width, const int height,
+	const void* pixels, const int pitch)
+{
+	std::lock_guard<std::mutex> lock(RenderThread::Instance().GetDeviceMutex());
+
+	auto texture(Config::MakeResource(SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_STATIC, width, height)));
+	if (texture == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (SDL_UpdateTexture(texture.get(), nullptr, pixels, pitch) != 0)
+	{
+		return nullptr;
+	}
+
+	SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+	return texture;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#ifndef __TEXTURE_CACHE__
+#define __TEXTURE_CACHE__
+
+// Core Libraries
+#include <memory>
+#include <string>
+
+// SDL Libraries
+#include <SDL.h>
+
+/* Singleton
+ * Keeps decoded copies of image files on disk, already converted to the renderer's native pixel format.
+ * The first load of an image decodes it with SDL_image and writes the cache file; later loads map the
+ * cache file and upload the pixels with SDL_UpdateTexture, skipping decompression and format conversion.
+ * Cache files are keyed by source path and invalidated by a hash of the source file contents.
+ */
+class TextureCache
+{
+public:
+	static TextureCache& Instance()
+	{
+		static TextureCache instance;
+		return instance;
+	}
+
+	// returns nullptr if the image can't be loaded
+	std::shared_ptr<SDL_Texture> Load(const std::string& file_name);
+
+	// getters
+	[[nodiscard]] bool IsEnabled() const;
+	[[nodiscard]] const std::string& GetCacheDirectory() const;
+	[[nodiscard]] int GetHitCount() const;
+	[[nodiscard]] int GetMissCount() const;
+	[[nodiscard]] double GetLoadTime() const;
+
+	// setters
+	void SetEnabled(bool enabled);
+	void SetCacheDirectory(const std::string& directory);
+
+	// load statistics - misses are cold loads (decode + write), hits are warm loads
+	void ResetStats();
+	void PrintStats() const;
+
+private:
+	TextureCache();
+	~TextureCache();
+
+	// written to the file as it is in memory - every field is naturally aligned and the size is a multiple
+	// of 8, so there are no padding bytes and the layout is the same on every compiler
+	struct Header
+	{
+		Uint32 magic;
+		Uint32 version;
+		Uint64 source_hash;
+		Uint32 format;
+		Sint32 width;
+		Sint32 height;
+		Sint32 pitch;
+	};
+	static_assert(sizeof(Header) == 32, "TextureCache::Header must not contain padding");
+
+	[[nodiscard]] Uint32 GetNativeFormat(SDL_Renderer* renderer) const;
+	[[nodiscard]] std::string GetCacheFileName(const std::string& file_name) const;
+	std::shared_ptr<SDL_Texture> LoadCached(SDL_Renderer* renderer, const std::string& cache_file_name, Uint64 source_hash, Uint32 format) const;
+	std::shared_ptr<SDL_Texture> Decode(SDL_Renderer* renderer, const void* source, size_t source_size, const std::string& type, const std::string& cache_file_name, Uint64 source_hash, Uint32 format) const;
+	static std::shared_ptr<SDL_Texture> CreateTexture(SDL_Renderer* renderer, Uint32 format, int width, int height, const void* pixels, int pitch);
+
+	bool m_enabled;
+	std::string m_cacheDirectory;
+
+	int m_hitCount;
+	int m_missCount;
+	Uint64 m_loadTicks;
+};
+
+#endif /* defined (__TEXTURE_CACHE__) */
@@ -2,14 +2,21 @@
 #include <SDL_image.h>
 #include "Game.h"
 #include <utility>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 #include "Frame.h"
 #include <iterator>
 #include "Renderer.h"
+#include "TextureCache.h"
+#include "SpriteSheetLoader.h"
+#include "RenderThread.h"
+#include <algorithm>
 
-TextureManager::TextureManager()
-= default;
+TextureManager::TextureManager() :
+	m_memoryBudget(256 * 1024 * 1024), m_memoryUsage(0), m_currentFrame(0), m_evictionCount(0), m_reloadCount(0)
+{
+}
 
 TextureManager::~TextureManager()
 = default;
@@ -24,24 +31,38 @@ bool TextureManager::SpriteSheetExists(const std::string & sprite_sheet_name)
 	return m_spriteSheetMap.find(sprite_sheet_name) != m_spriteSheetMap.end();
 }
 
-bool TextureManager::Load(const std::string & file_name, const std::string & id)
+/**
+ * \brief Takes a sheet out of the lookups without freeing it. Sprites hold raw pointers to the sheet and the sheet holds
+ * a raw pointer to its texture, so both stay alive until Clean, when the scene that used them is gone.
+ */
+void TextureManager::RetireSpriteSheet(const std::string & sprite_sheet_name)
 {
-	if (TextureExists(id))
+	m_retiredSpriteSheets.push_back(m_spriteSheetMap[sprite_sheet_name]);
+	if (const auto entry = m_textureMap.find(sprite_sheet_name); entry != m_textureMap.end() && entry->second.texture != nullptr)
 	{
-		return true;
+		m_retiredTextures.push_back(entry->second.texture);
 	}
 
-	const auto temp_surface(Config::MakeResource(IMG_Load(file_name.c_str())));
-	if (temp_surface == nullptr)
+	RemoveTexture(sprite_sheet_name);
+	m_spriteSheetMap.erase(sprite_sheet_name);
+	for (auto path = m_spriteSheetPaths.begin(); path != m_spriteSheetPaths.end();)
 	{
-		return false;
+		path = (path->second == sprite_sheet_name) ? m_spriteSheetPaths.erase(path) : std::next(path);
+	}
+}
+
+bool TextureManager::Load(const std::string & file_name, const std::string & id)
+{
+	if (TextureExists(id))
+	{
+		return true;
 	}
 
-	// everything went ok, add the texture to our list
-	if (const auto texture(Config::MakeResource(SDL_CreateTextureFromSurface(Renderer::Instance().GetRenderer(), temp_surface.get()))); 
-		texture != nullptr)
+	// decoded pixels come from the on-disk cache when it is up to date
+	if (const auto texture(TextureCache::Instance().Load(file_name)); texture != nullptr)
 	{
-		m_textureMap[id] = texture;
+		AddEntry(id, texture, file_name);
+		EnforceBudget();
 		return true;
 	}
 	return false;
@@ -52,68 +73,61 @@ bool TextureManager::LoadSpriteSheet(
 	const std::string & texture_file_name,
 	const std::string & sprite_sheet_name)
 {
-	std::fstream data_file; // create file stream object
-	const std::string delimiter = " ";
+	// a sheet is the data file and the texture together - the same data over another texture is a different sheet
+	const auto key = std::make_pair(std::filesystem::path(data_file_name).lexically_normal().string(),
+		std::filesystem::path(texture_file_name).lexically_normal().string());
 
-	// open the text data file
-	data_file.open(data_file_name, std::ios::in);
+	const auto loaded = m_spriteSheetPaths.find(key);
+	if (loaded != m_spriteSheetPaths.end() && loaded->second == sprite_sheet_name)
+	{
+		return true;
+	}
 
-	// create a new spritesheet object and allocate memory for it
-	auto sprite_sheet = new SpriteSheet(sprite_sheet_name);
+	// the name is being reused - sprites may still point at the old sheet and draw with its texture
+	if (SpriteSheetExists(sprite_sheet_name))
+	{
+		RetireSpriteSheet(sprite_sheet_name);
+	}
 
-	// if the file successfully opened
-	if (data_file)
+	// sheets are shared by data file and texture - a second load of the same pair only adds an alias
+	if (loaded != m_spriteSheetPaths.end())
 	{
-		std::string input_line;
-		// read one line at a time
-		while (std::getline(data_file, input_line))
-		{
-			Frame frame;
-			size_t line_position = 0;
-			std::vector<std::string> tokens;
+		m_spriteSheetMap[sprite_sheet_name] = m_spriteSheetMap[loaded->second];
 
-			for (auto i = 0; i < 5; ++i)
-			{
-				line_position = input_line.find(delimiter);
-				tokens.push_back(input_line.substr(0, line_position));
-				input_line.erase(0, line_position + 1);
-			}
+		// the alias shares the texture, its memory is already counted against the original id
+		auto& alias = m_textureMap[sprite_sheet_name];
+		alias = m_textureMap[loaded->second];
+		alias.file_name.clear();
+		alias.size = 0;
+		return true;
+	}
 
-			frame.name = tokens[0];
-			frame.x = std::stoi(tokens[1]);
-			frame.y = std::stoi(tokens[2]);
-			frame.w = std::stoi(tokens[3]);
-			frame.h = std::stoi(tokens[4]);
+	auto sprite_sheet = std::make_shared<SpriteSheet>(sprite_sheet_name);
 
-			// add the new frame to the spritesheet
-			sprite_sheet->AddFrame(frame);
-		}
-	}
-	else
+	// txt, xml and json data files are all parsed straight from the mapped file
+	if (!SpriteSheetLoader::Load(data_file_name, *sprite_sheet))
 	{
-		std::cout << "error opening file" << std::endl;
 		return false;
 	}
 
-	data_file.close();
-
 	// load the sprite texture and store it in the textureMap
 	Load(texture_file_name, sprite_sheet_name);
 
 	// get a pointer to the Texture and store it in the new spritesheet object
+	// the sheet keeps the raw pointer, so the texture must never be evicted
 	sprite_sheet->SetTexture(GetTexture(sprite_sheet_name));
+	SetPinned(sprite_sheet_name);
 
 	// store the new spritesheet in the spriteSheetMap
-	m_spriteSheetMap[sprite_sheet_name] = sprite_sheet;
-
-	// cleanup
-	sprite_sheet = nullptr;
+	m_spriteSheetMap[sprite_sheet_name] = std::move(sprite_sheet);
+	m_spriteSheetPaths[key] = sprite_sheet_name;
 
 	return true;
 }
 
 void TextureManager::Draw(const std::string & id, const int x, const int y, const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
 {
+	const auto texture = Use(id);
 	SDL_Rect src_rect{};
 	SDL_Rect dest_rect{};
 
@@ -123,7 +137,7 @@ void TextureManager::Draw(const std::string & id, const int x, const int y, cons
 	int texture_width;
 	int texture_height;
 
-	SDL_QueryTexture(m_textureMap[id].get(), nullptr, nullptr, &texture_width, &texture_height);
+	SDL_QueryTexture(texture, nullptr, nullptr, &texture_width, &texture_height);
 
 	src_rect.w = dest_rect.w = texture_width;
 	src_rect.h = dest_rect.h = texture_height;
@@ -139,8 +153,7 @@ void TextureManager::Draw(const std::string & id, const int x, const int y, cons
 		dest_rect.y = y;
 	}
 
-	SDL_SetTextureAlphaMod(m_textureMap[id].get(), static_cast<Uint8>(alpha));
-	SDL_RenderCopyEx(Renderer::Instance().GetRenderer(), m_textureMap[id].get(), &src_rect, &dest_rect, angle, nullptr, flip);
+	Renderer::Instance().Copy(texture, &src_rect, &dest_rect, angle, flip, static_cast<Uint8>(alpha));
 }
 
 void TextureManager::Draw(const std::string& id, const glm::vec2 position, const double angle, const int alpha, const bool centered,
@@ -151,11 +164,12 @@ void TextureManager::Draw(const std::string& id, const glm::vec2 position, const
 
 void TextureManager::Draw(const std::string& id, const int x, const int y, const GameObject* go, const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
 {
+	const auto texture = Use(id);
 	SDL_Rect src_rect{};
 	SDL_Rect dest_rect{};
 
 	int texture_width, texture_height;
-	SDL_QueryTexture(m_textureMap[id].get(), nullptr, nullptr, &texture_width, &texture_height);
+	SDL_QueryTexture(texture, nullptr, nullptr, &texture_width, &texture_height);
 	src_rect = { 0, 0, texture_width, texture_height };
 	dest_rect.w = go->GetWidth();
 	dest_rect.h = go->GetHeight();
@@ -171,8 +185,7 @@ void TextureManager::Draw(const std::string& id, const int x, const int y, const
 		dest_rect.y = y;
 	}
 
-	SDL_SetTextureAlphaMod(m_textureMap[id].get(), static_cast<Uint8>(alpha));
-	SDL_RenderCopyEx(Renderer::Instance().GetRenderer(), m_textureMap[id].get(), &src_rect, &dest_rect, angle, nullptr, flip);
+	Renderer::Instance().Copy(texture, &src_rect, &dest_rect, angle, flip, static_cast<Uint8>(alpha));
 }
 
 void TextureManager::DrawFrame(const std::string & id, const int x, const int y, const int frame_width,
@@ -181,6 +194,7 @@ void TextureManager::DrawFrame(const std::string & id, const int x, const int y,
                                const float speed_factor, const double angle,
                                const int alpha, const bool centered, const SDL_RendererFlip flip)
 {
+	const auto texture = Use(id);
 	AnimateFrames(frame_width, frame_height, frame_number, row_number, speed_factor, current_frame, current_row);
 
 	SDL_Rect src_rect{};
@@ -214,14 +228,14 @@ void TextureManager::DrawFrame(const std::string & id, const int x, const int y,
 		dest_rect.y = y;
 	}
 
-	SDL_SetTextureAlphaMod(m_textureMap[id].get(), static_cast<Uint8>(alpha));
-	SDL_RenderCopyEx(Renderer::Instance().GetRenderer(), m_textureMap[id].get(), &src_rect, &dest_rect, angle, nullptr, flip);
+	Renderer::Instance().Copy(texture, &src_rect, &dest_rect, angle, flip, static_cast<Uint8>(alpha));
 }
 
 void TextureManager::AnimateFrames(int frame_width, int frame_height, const int frame_number, const int row_number, const float speed_factor, int& current_frame, int& current_row) const
 {
 	const auto total_frames = static_cast<float>(frame_number * row_number);
-	const int animation_rate = static_cast<int>(round(total_frames / 2.0f / speed_factor));
+	// a fast speed_factor can round the rate down to 0 - never advance more than once per frame
+	const int animation_rate = std::max(1, static_cast<int>(round(total_frames / 2.0f / speed_factor)));
 
 	if (frame_number > 1)
 	{
@@ -247,8 +261,9 @@ void TextureManager::PlayAnimation(
 	const int x, const int y, const float speed_factor,
 	const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
 {
+	const auto texture = Use(sprite_sheet_name);
 	const auto total_frames = static_cast<float>(animation.frames.size());
-	const int animation_rate = static_cast<int>(round(total_frames / 2.0f / speed_factor));
+	const int animation_rate = std::max(1, static_cast<int>(round(total_frames / 2.0f / speed_factor)));
 
 	if (total_frames > 1)
 	{
@@ -293,8 +308,7 @@ void TextureManager::PlayAnimation(
 		dest_rect.y = y;
 	}
 
-	SDL_SetTextureAlphaMod(m_textureMap[sprite_sheet_name].get(), static_cast<Uint8>(alpha));
-	SDL_RenderCopyEx(Renderer::Instance().GetRenderer(), m_textureMap[sprite_sheet_name].get(), &src_rect, &dest_rect, angle, nullptr, flip);
+	Renderer::Instance().Copy(texture, &src_rect, &dest_rect, angle, flip, static_cast<Uint8>(alpha));
 }
 
 void TextureManager::PlayAnimation(const std::string& sprite_sheet_name, Animation& animation, const glm::vec2 position,
@@ -303,8 +317,28 @@ void TextureManager::PlayAnimation(const std::string& sprite_sheet_name, Animati
 	PlayAnimation(sprite_sheet_name, animation, static_cast<int>(position.x), static_cast<int>(position.y), speed_factor, angle, alpha, centered, flip);
 }
 
+/**
+ * \brief Draws the current frame of an animator. The animator is advanced elsewhere
+ * (Scene::UpdateAnimators) so drawing has no side effects.
+ */
+void TextureManager::DrawAnimation(const std::string& sprite_sheet_name, const Animator& animator, const glm::vec2 position,
+	const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
+{
+	const auto& src_rect = animator.GetSourceRect();
+	SDL_Rect dest_rect{ static_cast<int>(position.x), static_cast<int>(position.y), src_rect.w, src_rect.h };
+
+	if (centered) {
+		dest_rect.x -= static_cast<int>(dest_rect.w * 0.5);
+		dest_rect.y -= static_cast<int>(dest_rect.h * 0.5);
+	}
+
+	const auto texture = Use(sprite_sheet_name);
+	Renderer::Instance().Copy(texture, &src_rect, &dest_rect, angle, flip, static_cast<Uint8>(alpha));
+}
+
 void TextureManager::DrawText(const std::string & id, const int x, const int y, const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
 {
+	const auto texture = Use(id);
 	SDL_Rect src_rect{};
 	SDL_Rect dest_rect{};
 
@@ -314,7 +348,7 @@ void TextureManager::DrawText(const std::string & id, const int x, const int y,
 	int texture_width;
 	int texture_height;
 
-	SDL_QueryTexture(m_textureMap[id].get(), nullptr, nullptr, &texture_width, &texture_height);
+	SDL_QueryTexture(texture, nullptr, nullptr, &texture_width, &texture_height);
 
 	src_rect.w = dest_rect.w = texture_width;
 	src_rect.h = dest_rect.h = texture_height;
@@ -330,8 +364,7 @@ void TextureManager::DrawText(const std::string & id, const int x, const int y,
 		dest_rect.y = y;
 	}
 
-	SDL_SetTextureAlphaMod(m_textureMap[id].get(), static_cast<Uint8>(alpha));
-	SDL_RenderCopyEx(Renderer::Instance().GetRenderer(), m_textureMap[id].get(), &src_rect, &dest_rect, angle, nullptr, flip);
+	Renderer::Instance().Copy(texture, &src_rect, &dest_rect, angle, flip, static_cast<Uint8>(alpha));
 }
 
 void TextureManager::DrawText(const std::string& id, const glm::vec2 position, const double angle, const int alpha, const bool centered,
@@ -342,25 +375,45 @@ void TextureManager::DrawText(const std::string& id, const glm::vec2 position, c
 
 glm::vec2 TextureManager::GetTextureSize(const std::string & id)
 {
+	const auto texture = Use(id);
 	int width;
 	int height;
-	SDL_QueryTexture(m_textureMap[id].get(), nullptr, nullptr, &width, &height);
+	SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
 
 	return { static_cast<float>(width), static_cast<float>(height) };
 }
 
 void TextureManager::SetAlpha(const std::string & id, const Uint8 new_alpha)
 {
-	std::shared_ptr<SDL_Texture> texture = m_textureMap[id];
-	SDL_SetTextureAlphaMod(texture.get(), new_alpha);
-	texture = nullptr;
+	const auto texture = Use(id);
+
+	// queued frames were recorded with the old value and the render thread may be drawing with the texture
+	RenderThread::Instance().WaitIdle();
+	{
+		std::lock_guard<std::mutex> lock(RenderThread::Instance().GetDeviceMutex());
+		SDL_SetTextureAlphaMod(texture, new_alpha);
+	}
+
+	if (const auto entry = m_textureMap.find(id); entry != m_textureMap.end())
+	{
+		entry->second.colour_mod.a = new_alpha;
+	}
 }
 
 void TextureManager::SetColour(const std::string & id, const Uint8 red, const Uint8 green, const Uint8 blue)
 {
-	std::shared_ptr<SDL_Texture> texture = m_textureMap[id];
-	SDL_SetTextureColorMod(texture.get(), red, green, blue);
-	texture = nullptr;
+	const auto texture = Use(id);
+
+	RenderThread::Instance().WaitIdle();
+	{
+		std::lock_guard<std::mutex> lock(RenderThread::Instance().GetDeviceMutex());
+		SDL_SetTextureColorMod(texture, red, green, blue);
+	}
+
+	if (const auto entry = m_textureMap.find(id); entry != m_textureMap.end())
+	{
+		entry->second.colour_mod = { red, green, blue, entry->second.colour_mod.a };
+	}
 }
 
 bool TextureManager::AddTexture(const std::string & id, std::shared_ptr<SDL_Texture> texture)
@@ -370,19 +423,29 @@ bool TextureManager::AddTexture(const std::string & id, std::shared_ptr<SDL_Text
 		return true;
 	}
 
-	m_textureMap[id] = std::move(texture);
+	// textures made elsewhere can't be reloaded, they count against the budget but are never evicted
+	AddEntry(id, std::move(texture), "");
+	EnforceBudget();
 
 	return true;
 }
 
 SDL_Texture* TextureManager::GetTexture(const std::string & id)
 {
-	return m_textureMap[id].get();
+	return Use(id);
 }
 
 void TextureManager::RemoveTexture(const std::string & id)
 {
-	m_textureMap.erase(id);
+	if (const auto entry = m_textureMap.find(id); entry != m_textureMap.end())
+	{
+		RenderThread::Instance().WaitIdle();
+		if (entry->second.texture != nullptr)
+		{
+			m_memoryUsage -= entry->second.size;
+		}
+		m_textureMap.erase(entry);
+	}
 }
 
 int TextureManager::GetTextureMapSize() const
@@ -392,10 +455,15 @@ int TextureManager::GetTextureMapSize() const
 
 void TextureManager::Clean()
 {
+	RenderThread::Instance().WaitIdle();
 	m_textureMap.clear();
+	m_memoryUsage = 0;
 	std::cout << "TextureMap Cleared,  TextureMap Size: " << m_textureMap.size() << std::endl;
 
 	m_spriteSheetMap.clear();
+	m_spriteSheetPaths.clear();
+	m_retiredSpriteSheets.clear();
+	m_retiredTextures.clear();
 	std::cout << "Existing SpriteSheets Cleared" << std::endl;
 }
 
@@ -413,6 +481,153 @@ void TextureManager::DisplayTextureMap()
 
 SpriteSheet* TextureManager::GetSpriteSheet(const std::string & name)
 {
-	return m_spriteSheetMap[name];
+	const auto sprite_sheet = m_spriteSheetMap.find(name);
+	return (sprite_sheet != m_spriteSheetMap.end()) ? sprite_sheet->second.get() : nullptr;
+}
+
+SDL_Texture* TextureManager::Use(const std::string& id)
+{
+	const auto found = m_textureMap.find(id);
+	if (found == m_textureMap.end())
+	{
+		return nullptr;
+	}
+
+	auto& entry = found->second;
+	entry.last_used_frame = m_currentFrame;
+
+	// evicted - bring it back from the file it was loaded from
+	if (entry.texture == nullptr && !entry.file_name.empty())
+	{
+		entry.texture = TextureCache::Instance().Load(entry.file_name);
+		if (entry.texture != nullptr)
+		{
+			{
+				std::lock_guard<std::mutex> lock(RenderThread::Instance().GetDeviceMutex());
+				SDL_SetTextureColorMod(entry.texture.get(), entry.colour_mod.r, entry.colour_mod.g, entry.colour_mod.b);
+				SDL_SetTextureAlphaMod(entry.texture.get(), entry.colour_mod.a);
+			}
+			entry.size = ComputeTextureSize(entry.texture.get());
+			m_memoryUsage += entry.size;
+			++m_reloadCount;
+		}
+		else
+		{
+			std::cout << "error reloading texture: " << entry.file_name << std::endl;
+		}
+	}
+
+	return entry.texture.get();
+}
+
+void TextureManager::AddEntry(const std::string& id, std::shared_ptr<SDL_Texture> texture, const std::string& file_name)
+{
+	auto& entry = m_textureMap[id];
+	entry.size = ComputeTextureSize(texture.get());
+	entry.texture = std::move(texture);
+	entry.file_name = file_name;
+	entry.last_used_frame = m_currentFrame;
+	m_memoryUsage += entry.size;
+}
+
+/**
+ * \brief Evicts unreferenced file backed textures, least recently used first, until the memory usage fits the budget.
+ * Textures used during the current frame are kept so pointers handed out this frame stay valid.
+ */
+void TextureManager::EnforceBudget()
+{
+	while (m_memoryUsage > m_memoryBudget)
+	{
+		TextureEntry* least_recently_used = nullptr;
+		for (auto& [id, entry] : m_textureMap)
+		{
+			// anyone else holding the shared_ptr (an alias, AddTexture callers) is still using it
+			const auto evictable = entry.texture != nullptr && !entry.file_name.empty() && !entry.pinned &&
+				entry.texture.use_count() == 1 && entry.last_used_frame < m_currentFrame;
+
+			if (evictable && (least_recently_used == nullptr || entry.last_used_frame < least_recently_used->last_used_frame))
+			{
+				least_recently_used = &entry;
+			}
+		}
+
+		if (least_recently_used == nullptr)
+		{
+			return;
+		}
+
+		// frames still queued on the render thread may reference the texture
+		RenderThread::Instance().WaitIdle();
+		least_recently_used->texture = nullptr;
+		m_memoryUsage -= least_recently_used->size;
+		least_recently_used->size = 0;
+		++m_evictionCount;
+	}
+}
+
+size_t TextureManager::ComputeTextureSize(SDL_Texture* texture)
+{
+	Uint32 format;
+	int width, height;
+	if (texture == nullptr || SDL_QueryTexture(texture, &format, nullptr, &width, &height) != 0)
+	{
+		return 0;
+	}
+
+	// planar YUV formats average 1.5 bytes per pixel
+	const auto pixels = static_cast<size_t>(width) * static_cast<size_t>(height);
+	return SDL_ISPIXELFORMAT_FOURCC(format) ? pixels * 3 / 2 : pixels * SDL_BYTESPERPIXEL(format);
+}
+
+void TextureManager::EndFrame()
+{
+	++m_currentFrame;
+	EnforceBudget();
+}
+
+void TextureManager::SetPinned(const std::string& id, const bool pinned)
+{
+	if (const auto entry = m_textureMap.find(id); entry != m_textureMap.end())
+	{
+		entry->second.pinned = pinned;
+	}
+}
+
+void TextureManager::SetMemoryBudget(const size_t bytes)
+{
+	m_memoryBudget = bytes;
+}
+
+size_t TextureManager::GetMemoryBudget() const
+{
+	return m_memoryBudget;
+}
+
+size_t TextureManager::GetMemoryUsage() const
+{
+	return m_memoryUsage;
 }
 
+int TextureManager::GetEvictionCount() const
+{
+	return m_evictionCount;
+}
+
+int TextureManager::GetReloadCount() const
+{
+	return m_reloadCount;
+}
+
+std::vector<TextureManager::TextureInfo> TextureManager::GetTextureInfo() const
+{
+	std::vector<TextureInfo> texture_info;
+	texture_info.reserve(m_textureMap.size());
+	for (const auto& [id, entry] : m_textureMap)
+	{
+		texture_info.push_back({ id, entry.size, entry.last_used_frame, entry.pinned, !entry.file_name.empty() });
+	}
+
+	std::sort(texture_info.begin(), texture_info.end(),
+		[](const TextureInfo& a, const TextureInfo& b) { return a.size > b.size; });
+	return texture_info;
+}
@@ -4,8 +4,11 @@
 
 // Core Libraries
 #include <iostream>
+#include <map>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "glm/vec2.hpp"
 
@@ -15,6 +18,7 @@
 #include "Config.h"
 #include "SpriteSheet.h"
 #include "Animation.h"
+#include "Animator.h"
 #include "GameObject.h"
 
 /* Singleton */
@@ -44,6 +48,7 @@ public:
 	void AnimateFrames(int frame_width, int frame_height, int frame_number, int row_number, float speed_factor, int& current_frame, int& current_row) const;
 	void PlayAnimation(const std::string& sprite_sheet_name, Animation& animation, int x, int y, float speed_factor, double angle, int alpha, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
 	void PlayAnimation(const std::string& sprite_sheet_name, Animation& animation, glm::vec2 position, float speed_factor, double angle, int alpha, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
+	void DrawAnimation(const std::string& sprite_sheet_name, const Animator& animator, glm::vec2 position, double angle, int alpha, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
 	SpriteSheet* GetSpriteSheet(const std::string& name);
 
 	// texture utility functions
@@ -59,19 +64,70 @@ public:
 	void DisplayTextureMap();
 	void Clean();
 
+	// memory budget - textures loaded from files are evicted least recently used first once the
+	// budget is exceeded, and reloaded the next time they are used
+	struct TextureInfo
+	{
+		std::string id;
+		size_t size; // bytes, 0 while evicted
+		Uint64 last_used_frame;
+		bool pinned;
+		bool reloadable;
+	};
+
+	// call once per frame after presenting, evictions only happen here so pointers returned during a frame stay valid
+	void EndFrame();
+	// textures that are pinned are never evicted (e.g. textures whose raw pointer is kept by a SpriteSheet)
+	void SetPinned(const std::string& id, bool pinned = true);
+	void SetMemoryBudget(size_t bytes);
+	[[nodiscard]] size_t GetMemoryBudget() const;
+	[[nodiscard]] size_t GetMemoryUsage() const;
+	[[nodiscard]] int GetEvictionCount() const;
+	[[nodiscard]] int GetReloadCount() const;
+	// one entry per texture, largest first
+	[[nodiscard]] std::vector<TextureInfo> GetTextureInfo() const;
+
 
 private:
 
 	TextureManager();
 	~TextureManager();
 
+	struct TextureEntry
+	{
+		std::shared_ptr<SDL_Texture> texture; // nullptr while evicted
+		std::string file_name; // empty if the texture can't be reloaded (text, render targets)
+		size_t size = 0;
+		Uint64 last_used_frame = 0;
+		SDL_Color colour_mod{ 255, 255, 255, 255 }; // colour and alpha mod, restored on reload
+		bool pinned = false;
+	};
+
 	// private utility functions
 	bool TextureExists(const std::string& id);
 	bool SpriteSheetExists(const std::string& sprite_sheet_name);
+	void RetireSpriteSheet(const std::string& sprite_sheet_name);
+	// returns the texture for id, reloading it if it was evicted, and marks it as used this frame
+	SDL_Texture* Use(const std::string& id);
+	void AddEntry(const std::string& id, std::shared_ptr<SDL_Texture> texture, const std::string& file_name);
+	void EnforceBudget();
+	static size_t ComputeTextureSize(SDL_Texture* texture);
 
 	// storage structures
-	std::unordered_map<std::string, std::shared_ptr<SDL_Texture>> m_textureMap;
-	std::unordered_map<std::string, SpriteSheet*> m_spriteSheetMap;
+	std::unordered_map<std::string, TextureEntry> m_textureMap;
+	std::unordered_map<std::string, std::shared_ptr<SpriteSheet>> m_spriteSheetMap;
+	// (data file path, texture file path) -> name of the sprite sheet loaded from them, so each pair is only parsed once
+	std::map<std::pair<std::string, std::string>, std::string> m_spriteSheetPaths;
+	// sheets replaced under their name, and their textures - kept until Clean since sprites may still use them
+	std::vector<std::shared_ptr<SpriteSheet>> m_retiredSpriteSheets;
+	std::vector<std::shared_ptr<SDL_Texture>> m_retiredTextures;
+
+	// memory accounting
+	size_t m_memoryBudget;
+	size_t m_memoryUsage;
+	Uint64 m_currentFrame;
+	int m_evictionCount;
+	int m_reloadCount;
 };
 
 #endif /* defined(__TEXTURE_MANAGER__) */
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include "TileGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include "MappedFile.h"
+
+TileGrid::TileGrid() : TileGrid(Config::COL_NUM, Config::ROW_NUM)
+{
+}
+
+TileGrid::TileGrid(const int cols, const int rows, const int cost) : m_cols(0), m_rows(0), m_version(0)
+{
+	Resize(cols, rows, cost);
+}
+
+TileGrid::~TileGrid()
+= default;
+
+void TileGrid::Resize(const int cols, const int rows, const int cost)
+{
+	m_cols = std::max(cols, 0);
+	m_rows = std::max(rows, 0);
+	m_costs.assign(static_cast<size_t>(m_cols) * m_rows, static_cast<std::uint8_t>(std::clamp(cost, 0, 255)));
+	++m_version;
+}
+
+bool TileGrid::LoadCSV(const std::string& file_name, const std::string& blocked_codes)
+{
+	MappedFile file;
+	if (!file.Open(file_name))
+	{
+		std::cout << "error opening file: " << file_name << std::endl;
+		return false;
+	}
+
+	const auto data = reinterpret_cast<const char*>(file.GetData());
+	const auto size = file.GetSize();
+
+	std::vector<std::uint8_t> costs;
+	costs.reserve(size / 2);
+	auto cols = 0;
+	auto rows = 0;
+	auto row_length = 0;
+	auto cell_start = true;
+
+	for (size_t i = 0; i <= size; ++i)
+	{
+		const auto c = i < size ? data[i] : '\n';
+		if (c == '\r' || c == '\n')
+		{
+			if (row_length > 0)
+			{
+				if (cols == 0)
+				{
+					cols = row_length;
+				}
+				else if (row_length != cols)
+				{
+					std::cout << "error parsing tile map: " << file_name << " row " << rows << " has " << row_length << " cells, expected " << cols << std::endl;
+					return false;
+				}
+				++rows;
+			}
+			row_length = 0;
+			cell_start = true;
+		}
+		else if (c == ',')
+		{
+			cell_start = true;
+		}
+		else if (cell_start && c != ' ')
+		{
+			// the first character of a cell is its code
+			const auto blocked = blocked_codes.find(c) != std::string::npos;
+			costs.push_back(blocked ? BLOCKED : static_cast<std::uint8_t>(Config::TILE_COST));
+			++row_length;
+			cell_start = false;
+		}
+	}
+
+	if (rows == 0)
+	{
+		std::cout << "error parsing tile map: " << file_name << " is empty" << std::endl;
+		return false;
+	}
+
+	m_cols = cols;
+	m_rows = rows;
+	m_costs.swap(costs);
+	++m_version;
+	return true;
+}
+
+void TileGrid::FillRandom(const float blocked_fraction, const unsigned int seed)
+{
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+	for (auto& cost : m_costs)
+	{
+		cost = distribution(generator) < blocked_fraction ? BLOCKED : static_cast<std::uint8_t>(Config::TILE_COST);
+	}
+	++m_version;
+}
+
+void TileGrid::FillMaze(const unsigned int seed)
+{
+	std::fill(m_costs.begin(), m_costs.end(), BLOCKED);
+	++m_version;
+	if (m_cols < 3 || m_rows < 3)
+	{
+		return;
+	}
+
+	// depth first carving with an explicit stack, mazes on large grids are too deep to recurse
+	std::mt19937 generator(seed);
+	constexpr int step_x[4] = { 2, 0, -2, 0 };
+	constexpr int step_y[4] = { 0, 2, 0, -2 };
+
+	std::vector<glm::ivec2> stack;
+	stack.emplace_back(1, 1);
+	m_costs[GetIndex(1, 1)] = static_cast<std::uint8_t>(Config::TILE_COST);
+
+	while (!stack.empty())
+	{
+		const auto cell = stack.back();
+
+		int directions[4];
+		auto direction_count = 0;
+		for (auto direction = 0; direction < 4; ++direction)
+		{
+			const auto x = cell.x + step_x[direction];
+			const auto y = cell.y + step_y[direction];
+			if (x > 0 && y > 0 && x < m_cols - 1 && y < m_rows - 1 && m_costs[GetIndex(x, y)] == BLOCKED)
+			{
+				directions[direction_count++] = direction;
+			}
+		}
+
+		if (direction_count == 0)
+		{
+			stack.pop_back();
+			continue;
+		}
+
+		const auto direction = directions[std::uniform_int_distribution<int>(0, direction_count - 1)(generator)];
+		const glm::ivec2 next(cell.x + step_x[direction], cell.y + step_y[direction]);
+		m_costs[GetIndex(cell.x + step_x[direction] / 2, cell.y + step_y[direction] / 2)] = static_cast<std::uint8_t>(Config::TILE_COST);
+		m_costs[GetIndex(next.x, next.y)] = static_cast<std::uint8_t>(Config::TILE_COST);
+		stack.push_back(next);
+	}
+}
+
+int TileGrid::GetCols() const
+{
+	return m_cols;
+}
+
+int TileGrid::GetRows() const
+{
+	return m_rows;
+}
+
+int TileGrid::GetTileCount() const
+{
+	return static_cast<int>(m_costs.size());
+}
+
+std::uint32_t TileGrid::GetVersion() const
+{
+	return m_version;
+}
+
+const std::uint8_t* TileGrid::GetCosts() const
+{
+	return m_costs.data();
+}
+
+void TileGrid::SetCost(const int col, const int row, const int cost)
+{
+	if (!IsInside(col, row))
+	{
+		return;
+	}
+
+	m_costs[GetIndex(col, row)] = static_cast<std::uint8_t>(std::clamp(cost, 0, 255));
+	++m_version;
+}
+
+glm::ivec2 TileGrid::WorldToTile(const glm::vec2 position)
+{
+	return { static_cast<int>(std::floor(position.x / Config::TILE_SIZE)), static_cast<int>(std::floor(position.y / Config::TILE_SIZE)) };
+}
+
+glm::vec2 TileGrid::TileToWorld(const glm::ivec2 tile)
+{
+	return { (static_cast<float>(tile.x) + 0.5f) * Config::TILE_SIZE, (static_cast<float>(tile.y) + 0.5f) * Config::TILE_SIZE };
+}
@@ -0,0 +1,62 @@
+#pragma once
+#ifndef __TILE_GRID__
+#define __TILE_GRID__
+
+// Core Libraries
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "Config.h"
+
+/**
+ * \brief Flat array of tile costs, row major. A cost of 0 marks a blocked tile.
+ * Defaults to the Config grid (COL_NUM x ROW_NUM tiles of TILE_SIZE pixels, every tile TILE_COST).
+ * The version is bumped on every change so anything built from the grid can tell it is stale.
+ */
+class TileGrid
+{
+public:
+	static constexpr std::uint8_t BLOCKED = 0;
+
+	TileGrid();
+	TileGrid(int cols, int rows, int cost = Config::TILE_COST);
+	~TileGrid();
+
+	void Resize(int cols, int rows, int cost = Config::TILE_COST);
+	// one character code per cell, rows ending in CR and/or LF - codes in blocked_codes are walls, anything else costs TILE_COST
+	bool LoadCSV(const std::string& file_name, const std::string& blocked_codes = "WOM");
+	// blocks a random fraction of the tiles, the same seed gives the same grid
+	void FillRandom(float blocked_fraction, unsigned int seed);
+	// carves a perfect maze of one tile wide corridors (cells on odd coordinates), the same seed gives the same maze
+	void FillMaze(unsigned int seed);
+
+	// getters
+	[[nodiscard]] int GetCols() const;
+	[[nodiscard]] int GetRows() const;
+	[[nodiscard]] int GetTileCount() const;
+	[[nodiscard]] std::uint32_t GetVersion() const;
+	[[nodiscard]] int GetIndex(int col, int row) const { return row * m_cols + col; }
+	[[nodiscard]] bool IsInside(int col, int row) const { return col >= 0 && row >= 0 && col < m_cols && row < m_rows; }
+	// out of range tiles are blocked
+	[[nodiscard]] bool IsWalkable(int col, int row) const { return IsInside(col, row) && m_costs[GetIndex(col, row)] != BLOCKED; }
+	[[nodiscard]] int GetCost(int col, int row) const { return m_costs[GetIndex(col, row)]; }
+	[[nodiscard]] const std::uint8_t* GetCosts() const;
+
+	// setters
+	void SetCost(int col, int row, int cost);
+
+	// conversions between pixels and tiles (tile centres)
+	[[nodiscard]] static glm::ivec2 WorldToTile(glm::vec2 position);
+	[[nodiscard]] static glm::vec2 TileToWorld(glm::ivec2 tile);
+
+private:
+	int m_cols;
+	int m_rows;
+	std::vector<std::uint8_t> m_costs;
+	std::uint32_t m_version;
+};
+
+#endif /* defined (__TILE_GRID__) */
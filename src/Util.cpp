@@ -292,9 +292,11 @@ void Util::DrawLine(const glm::vec2 start, const glm::vec2 end, const glm::vec4
 {
 	const auto [r, g, b, a] = ToSDLColour(colour);
 
-	SDL_SetRenderDrawColor(renderer, r, g, b, a);
-	SDL_RenderDrawLineF(renderer, start.x, start.y, end.x, end.y);
-	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+	const SDL_FPoint points[2] = { { start.x, start.y }, { end.x, end.y } };
+
+	Renderer::Instance().SetDrawColour(r, g, b, a, renderer);
+	Renderer::Instance().DrawLines(points, 2, renderer);
+	Renderer::Instance().SetDrawColour(255, 255, 255, 255, renderer);
 }
 
 void Util::DrawRect(const glm::vec2 position, const int width, const int height, const glm::vec4 colour, SDL_Renderer* renderer)
@@ -307,9 +309,9 @@ void Util::DrawRect(const glm::vec2 position, const int width, const int height,
 	rectangle.w = static_cast<float>(width);
 	rectangle.h = static_cast<float>(height);
 
-	SDL_SetRenderDrawColor(renderer, r, g, b, a);
-	SDL_RenderDrawRectF(renderer, &rectangle);
-	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+	Renderer::Instance().SetDrawColour(r, g, b, a, renderer);
+	Renderer::Instance().DrawRect(rectangle, renderer);
+	Renderer::Instance().SetDrawColour(255, 255, 255, 255, renderer);
 }
 
 void Util::DrawFilledRect(const glm::vec2 position, const int width, const int height, const glm::vec4 fill_colour, SDL_Renderer* renderer)
@@ -322,16 +324,30 @@ void Util::DrawFilledRect(const glm::vec2 position, const int width, const int h
 	rectangle.w = static_cast<float>(width);
 	rectangle.h = static_cast<float>(height);
 
-	SDL_SetRenderDrawColor(renderer, r, g, b, a);
-	SDL_RenderFillRectF(renderer, &rectangle);
-	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+	Renderer::Instance().SetDrawColour(r, g, b, a, renderer);
+	Renderer::Instance().FillRect(rectangle, renderer);
+	Renderer::Instance().SetDrawColour(255, 255, 255, 255, renderer);
 }
 
 void Util::DrawCircle(const glm::vec2 centre, const float radius, const glm::vec4 colour, const ShapeType type, SDL_Renderer* renderer)
 {
 	const auto [r, g, b, a] = ToSDLColour(colour);
 
-	SDL_SetRenderDrawColor(renderer, r, g, b, a);
+	// reused between calls so plotting a circle does not allocate
+	static std::vector<SDL_FPoint> points;
+	points.clear();
+	ComputeCirclePoints(points, centre, radius, type);
+
+	Renderer::Instance().SetDrawColour(r, g, b, a, renderer);
+	Renderer::Instance().DrawPoints(points.data(), static_cast<int>(points.size()), renderer);
+	Renderer::Instance().SetDrawColour(255, 255, 255, 255, renderer);
+}
+
+/**
+* Appends the pixels of a midpoint circle (or one of its halves) to points
+*/
+void Util::ComputeCirclePoints(std::vector<SDL_FPoint>& points, const glm::vec2 centre, const float radius, const ShapeType type)
+{
 	const float diameter = floor(radius * 2.0f);
 
 	float x = (radius - 1);
@@ -346,42 +362,42 @@ void Util::DrawCircle(const glm::vec2 centre, const float radius, const glm::vec
 		{
 		case ShapeType::SEMI_CIRCLE_TOP:
 			//  Each of the following renders an octant of the circle
-			SDL_RenderDrawPointF(renderer, centre.x + x, centre.y - y);
-			SDL_RenderDrawPointF(renderer, centre.x - x, centre.y - y);
-			SDL_RenderDrawPointF(renderer, centre.x + y, centre.y - x);
-			SDL_RenderDrawPointF(renderer, centre.x - y, centre.y - x);
+			points.push_back({ centre.x + x, centre.y - y });
+			points.push_back({ centre.x - x, centre.y - y });
+			points.push_back({ centre.x + y, centre.y - x });
+			points.push_back({ centre.x - y, centre.y - x });
 			break;
 		case ShapeType::SEMI_CIRCLE_BOTTOM:
 			//  Each of the following renders an octant of the circle
-			SDL_RenderDrawPointF(renderer, centre.x + x, centre.y + y); // bottom right
-			SDL_RenderDrawPointF(renderer, centre.x - x, centre.y + y); // bottom left
-			SDL_RenderDrawPointF(renderer, centre.x + y, centre.y + x); // bottom right
-			SDL_RenderDrawPointF(renderer, centre.x - y, centre.y + x); // bottom left
+			points.push_back({ centre.x + x, centre.y + y }); // bottom right
+			points.push_back({ centre.x - x, centre.y + y }); // bottom left
+			points.push_back({ centre.x + y, centre.y + x }); // bottom right
+			points.push_back({ centre.x - y, centre.y + x }); // bottom left
 			break;
 		case ShapeType::SEMI_CIRCLE_LEFT:
 			//  Each of the following renders an octant of the circle
-			SDL_RenderDrawPointF(renderer, centre.x - x, centre.y - y);
-			SDL_RenderDrawPointF(renderer, centre.x - x, centre.y + y);
-			SDL_RenderDrawPointF(renderer, centre.x - y, centre.y - x);
-			SDL_RenderDrawPointF(renderer, centre.x - y, centre.y + x);
+			points.push_back({ centre.x - x, centre.y - y });
+			points.push_back({ centre.x - x, centre.y + y });
+			points.push_back({ centre.x - y, centre.y - x });
+			points.push_back({ centre.x - y, centre.y + x });
 			break;
 		case ShapeType::SEMI_CIRCLE_RIGHT:
 			//  Each of the following renders an octant of the circle
-			SDL_RenderDrawPointF(renderer, centre.x + x, centre.y - y);
-			SDL_RenderDrawPointF(renderer, centre.x + x, centre.y + y);
-			SDL_RenderDrawPointF(renderer, centre.x + y, centre.y - x);
-			SDL_RenderDrawPointF(renderer, centre.x + y, centre.y + x);
+			points.push_back({ centre.x + x, centre.y - y });
+			points.push_back({ centre.x + x, centre.y + y });
+			points.push_back({ centre.x + y, centre.y - x });
+			points.push_back({ centre.x + y, centre.y + x });
 			break;
 		case ShapeType::SYMMETRICAL:
 			//  Each of the following renders an octant of the circle
-			SDL_RenderDrawPointF(renderer, centre.x + x, centre.y - y);
-			SDL_RenderDrawPointF(renderer, centre.x + x, centre.y + y);
-			SDL_RenderDrawPointF(renderer, centre.x - x, centre.y - y);
-			SDL_RenderDrawPointF(renderer, centre.x - x, centre.y + y);
-			SDL_RenderDrawPointF(renderer, centre.x + y, centre.y - x);
-			SDL_RenderDrawPointF(renderer, centre.x + y, centre.y + x);
-			SDL_RenderDrawPointF(renderer, centre.x - y, centre.y - x);
-			SDL_RenderDrawPointF(renderer, centre.x - y, centre.y + x);
+			points.push_back({ centre.x + x, centre.y - y });
+			points.push_back({ centre.x + x, centre.y + y });
+			points.push_back({ centre.x - x, centre.y - y });
+			points.push_back({ centre.x - x, centre.y + y });
+			points.push_back({ centre.x + y, centre.y - x });
+			points.push_back({ centre.x + y, centre.y + x });
+			points.push_back({ centre.x - y, centre.y - x });
+			points.push_back({ centre.x - y, centre.y + x });
 			break;
 		}
 
@@ -400,8 +416,6 @@ void Util::DrawCircle(const glm::vec2 centre, const float radius, const glm::vec
 			error += (tx - diameter);
 		}
 	}
-
-	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
 }
 
 void Util::DrawCapsule(const glm::vec2 position, const int width, const int height, const glm::vec4 colour, SDL_Renderer* renderer)
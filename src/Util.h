@@ -6,6 +6,7 @@
 #include "GLM/vec4.hpp"
 #include "ShapeType.h"
 #include <SDL.h>
+#include <vector>
 
 #include "GameObject.h"
 #include "Renderer.h"
@@ -57,6 +58,7 @@ public:
 	static void DrawFilledRect(glm::vec2 position, int width, int height, glm::vec4 fill_colour = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f), SDL_Renderer* renderer = Renderer::Instance().GetRenderer());
 	static void DrawCircle(glm::vec2 centre, float radius, glm::vec4 colour = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f), ShapeType type = ShapeType::SYMMETRICAL, SDL_Renderer* renderer = Renderer::Instance().GetRenderer());
 	static void DrawCapsule(glm::vec2 position, int width, int height, glm::vec4 colour = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f), SDL_Renderer* renderer = Renderer::Instance().GetRenderer());
+	static void ComputeCirclePoints(std::vector<SDL_FPoint>& points, glm::vec2 centre, float radius, ShapeType type = ShapeType::SYMMETRICAL);
 
 	static float GetClosestEdge(glm::vec2 vec_a, GameObject* object);
 
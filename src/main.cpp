@@ -3,6 +3,9 @@
 * Date: April 2, 2023
 */
 
+// Engine headers come before Windows.h, whose min and max macros would break them
+#include "CollisionManager.h"
+
 // Core Libraries
 #include <crtdbg.h>
 #include <iostream>
@@ -266,6 +269,21 @@ namespace Fund
 		return (bool)isColliding;
 
 	}
+	// Check if a blaster hits a sprite anywhere along the move it makes this frame.
+	// Blasters travel 1000 px/s, so testing only where they are would let them skip over a ship between frames
+	bool IsBlasterHitting(const Blaster& blaster, const Sprite& target)
+	{
+		SDL_Rect blasterBounds = blaster.sprite.GetRect();
+		SDL_Rect targetBounds = target.GetRect();
+
+		AABB blasterBox(glm::vec2(blasterBounds.x, blasterBounds.y), glm::vec2(blasterBounds.x + blasterBounds.w, blasterBounds.y + blasterBounds.h));
+		AABB targetBox(glm::vec2(targetBounds.x, targetBounds.y), glm::vec2(targetBounds.x + targetBounds.w, targetBounds.y + targetBounds.h));
+		glm::vec2 displacement(blaster.velocity.x * deltaTime, blaster.velocity.y * deltaTime);
+
+		float timeOfImpact;
+		glm::vec2 normal;
+		return CollisionManager::SweptAABB(blasterBox, displacement, targetBox, timeOfImpact, normal);
+	}
 }
 
 //create new instances of struct Fund to load textures
@@ -672,8 +690,7 @@ void CollisionDetection()
 {
 	for (std::vector<Fund::Blaster>::iterator it = enemyBlasterContainer.begin(); it != enemyBlasterContainer.end();)
 	{
-		Fund::Sprite& enemyBlaster = it->sprite;
-		if (Fund::AreSpritesOverlapping(player.sprite, enemyBlaster))
+		if (Fund::IsBlasterHitting(*it, player.sprite))
 		{
 			std::cout << "Player was Hit" << std::endl;
 			TakeHealth(1);
@@ -694,7 +711,7 @@ void CollisionDetection()
 		for (std::vector<Fund::Ship>::iterator enemyIterator = enemyContainer.begin(); enemyIterator != enemyContainer.end();)
 		{
 			//Test for collision between player blaster and enemy
-			if (Fund::AreSpritesOverlapping(blasterIterator->sprite, enemyIterator->sprite))
+			if (Fund::IsBlasterHitting(*blasterIterator, enemyIterator->sprite))
 			{
 				//destroy player projectile
 				blasterIterator = playerBlasterContainer.erase(blasterIterator);
@@ -1,10 +1,12 @@
 #include "Ship.h"
+#include <cmath>
 #include "glm/gtx/string_cast.hpp"
 #include "PlayScene.h"
 #include "TextureManager.h"
 #include "Util.h"
+#include "PhysicsWorld.h"
 
-Ship::Ship() : m_maxSpeed(10.0f)
+Ship::Ship() : m_maxSpeed(600.0f)
 {
 	TextureManager::Instance().Load("../Assets/textures/ship3.png", "ship");
 
@@ -16,6 +18,7 @@ Ship::Ship() : m_maxSpeed(10.0f)
 	GetRigidBody()->velocity = glm::vec2(0.0f, 0.0f);
 	GetRigidBody()->acceleration = glm::vec2(0.0f, 0.0f);
 	GetRigidBody()->isColliding = false;
+	GetRigidBody()->damping = std::pow(0.9f, 60.0f); // 0.9 per frame at 60 fps
 	SetType(GameObjectType::AGENT);
 
 	SetCurrentHeading(0.0f);// current facing angle
@@ -24,11 +27,15 @@ Ship::Ship() : m_maxSpeed(10.0f)
 
 	SetLOSDistance(400.0f); // 5 ppf x 80 feet
 	SetLOSColour(glm::vec4(1, 0, 0, 1));
+
+	PhysicsWorld::Instance().AddBody(this);
 }
 
 
 Ship::~Ship()
-= default;
+{
+	PhysicsWorld::Instance().RemoveBody(this);
+}
 
 void Ship::Draw()
 {
@@ -36,6 +43,7 @@ void Ship::Draw()
 	TextureManager::Instance().Draw("ship", GetTransform()->position, GetCurrentHeading(), 255, true);
 
 	// draw LOS
+	// gameplay visible, so not through the debug-only DebugDraw buffer
 	Util::DrawLine(GetTransform()->position, GetTransform()->position + GetCurrentDirection() * GetLOSDistance(), GetLOSColour());
 }
 
@@ -78,12 +86,6 @@ void Ship::MoveBack()
 	GetRigidBody()->velocity = GetCurrentDirection() * -m_maxSpeed;
 }
 
-void Ship::Move()
-{
-	GetTransform()->position += GetRigidBody()->velocity;
-	GetRigidBody()->velocity *= 0.9f;
-}
-
 float Ship::GetMaxSpeed() const
 {
 	return m_maxSpeed;
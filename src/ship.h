@@ -23,8 +23,6 @@ public:
 	void MoveForward();
 	void MoveBack();
 
-	void Move();
-
 	// getters
 	[[nodiscard]] float GetMaxSpeed() const;
 